@@ -0,0 +1,135 @@
+// Compares concurrent lookups by actor ID in a hash map that is protected by a
+// shared mutex (the previous implementation of the actor registry) with
+// lookups in the lock-free concurrent_actor_map.
+//
+// For each number of reader threads, the benchmark measures the total number
+// of lookups per second while one writer thread keeps adding and removing
+// actors.
+
+#include "caf/actor_cast.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/concurrent_actor_map.hpp"
+#include "caf/event_based_actor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+/// Number of actors in the map.
+constexpr size_t num_actors = 1'000;
+
+/// Number of actors that the writer adds and removes repeatedly.
+constexpr size_t num_volatile_actors = 16;
+
+/// Duration of each measurement.
+constexpr auto run_time = 500ms;
+
+class locked_map {
+public:
+  strong_actor_ptr get(actor_id key) const {
+    std::shared_lock guard{mtx_};
+    if (auto i = entries_.find(key); i != entries_.end())
+      return i->second;
+    return nullptr;
+  }
+
+  bool insert(actor_id key, strong_actor_ptr val) {
+    std::unique_lock guard{mtx_};
+    return entries_.emplace(key, std::move(val)).second;
+  }
+
+  strong_actor_ptr erase(actor_id key) {
+    strong_actor_ptr result;
+    std::unique_lock guard{mtx_};
+    if (auto i = entries_.find(key); i != entries_.end()) {
+      result.swap(i->second);
+      entries_.erase(i);
+    }
+    return result;
+  }
+
+private:
+  mutable std::shared_mutex mtx_;
+  std::unordered_map<actor_id, strong_actor_ptr> entries_;
+};
+
+template <class Map>
+double run(const std::vector<strong_actor_ptr>& actors, size_t num_readers) {
+  Map map;
+  for (size_t i = num_volatile_actors; i < actors.size(); ++i)
+    map.insert(actors[i]->id(), actors[i]);
+  std::atomic<bool> done = false;
+  std::atomic<size_t> total = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_readers; ++i) {
+    threads.emplace_back([&, i] {
+      size_t lookups = 0;
+      size_t hits = 0;
+      auto pos = i * 97;
+      while (!done.load(std::memory_order_relaxed)) {
+        for (size_t n = 0; n < 64; ++n) {
+          pos = (pos + 7) % actors.size();
+          if (map.get(actors[pos]->id()) != nullptr)
+            ++hits;
+        }
+        lookups += 64;
+      }
+      total += lookups;
+      // Prevent the compiler from optimizing away the lookups.
+      if (hits > lookups)
+        puts("unreachable");
+    });
+  }
+  threads.emplace_back([&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      for (size_t i = 0; i < num_volatile_actors; ++i)
+        map.insert(actors[i]->id(), actors[i]);
+      for (size_t i = 0; i < num_volatile_actors; ++i)
+        map.erase(actors[i]->id());
+      std::this_thread::sleep_for(100us);
+    }
+  });
+  std::this_thread::sleep_for(run_time);
+  done = true;
+  for (auto& thread : threads)
+    thread.join();
+  using secs = std::chrono::duration<double>;
+  return static_cast<double>(total.load()) / secs{run_time}.count();
+}
+
+behavior dummy() {
+  return {[](int) {}};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t max_readers = std::thread::hardware_concurrency();
+  if (argc > 1)
+    max_readers = std::stoul(argv[1]);
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  std::vector<strong_actor_ptr> actors;
+  for (size_t i = 0; i < num_actors; ++i)
+    actors.emplace_back(actor_cast<strong_actor_ptr>(sys.spawn(dummy)));
+  printf("%10s | %22s | %22s\n", "readers", "shared_mutex [Mops/s]",
+         "lock-free [Mops/s]");
+  for (size_t n = 1; n <= std::max(max_readers, size_t{1}); n *= 2) {
+    auto x = run<locked_map>(actors, n);
+    auto y = run<detail::concurrent_actor_map>(actors, n);
+    printf("%10zu | %22.2f | %22.2f\n", n, x / 1e6, y / 1e6);
+  }
+}
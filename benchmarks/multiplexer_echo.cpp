@@ -0,0 +1,172 @@
+// Measures echo traffic over TCP connections on the loopback interface for
+// each backend of the multiplexer.
+//
+// The multiplexer runs in a background thread and echoes all incoming data.
+// The main thread sends a small message on each connection, then waits for all
+// replies. The benchmark prints the number of round trips per second.
+
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/socket_event_layer.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/stream_socket.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+#include "caf/net/this_host.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/span.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+/// Size of a single message.
+constexpr size_t msg_size = 64;
+
+/// Duration of each measurement.
+constexpr auto run_time = 1s;
+
+/// Sends all received bytes back to the sender.
+class echo : public net::socket_event_layer {
+public:
+  explicit echo(net::stream_socket fd) : fd_(fd) {
+    // nop
+  }
+
+  error start(net::socket_manager* mgr) override {
+    mgr_ = mgr;
+    mgr_->register_reading();
+    return none;
+  }
+
+  net::socket handle() const override {
+    return fd_;
+  }
+
+  void handle_read_event() override {
+    std::array<std::byte, 4096> tmp;
+    auto res = read(fd_, tmp);
+    if (res > 0) {
+      buf_.insert(buf_.end(), tmp.begin(), tmp.begin() + res);
+      handle_write_event();
+    } else if (res == 0 || !net::last_socket_error_is_temporary()) {
+      mgr_->deregister();
+    }
+  }
+
+  void handle_write_event() override {
+    if (buf_.empty()) {
+      mgr_->deregister_writing();
+      return;
+    }
+    auto res = write(fd_, buf_);
+    if (res > 0) {
+      buf_.erase(buf_.begin(), buf_.begin() + res);
+      if (buf_.empty())
+        mgr_->deregister_writing();
+      else
+        mgr_->register_writing();
+    } else if (res < 0 && net::last_socket_error_is_temporary()) {
+      mgr_->register_writing();
+    } else {
+      mgr_->deregister();
+    }
+  }
+
+  void abort(const error&) override {
+    // nop
+  }
+
+private:
+  net::stream_socket fd_;
+  net::socket_manager* mgr_ = nullptr;
+  byte_buffer buf_;
+};
+
+[[noreturn]] void fail(const char* what) {
+  fprintf(stderr, "%s\n", what);
+  exit(EXIT_FAILURE);
+}
+
+double run(std::string_view backend, size_t num_connections) {
+  auto mpx = net::multiplexer::make(nullptr, backend);
+  if (auto err = mpx->init())
+    fail("failed to initialize the multiplexer");
+  auto mpx_thread = mpx->launch();
+  auto acceptor = net::make_tcp_accept_socket(0, "127.0.0.1");
+  if (!acceptor)
+    fail("failed to open the accept socket");
+  auto port = net::local_port(*acceptor);
+  if (!port)
+    fail("failed to read the local port");
+  std::vector<net::tcp_stream_socket> clients;
+  for (size_t i = 0; i < num_connections; ++i) {
+    auto client = net::make_connected_tcp_stream_socket("127.0.0.1", *port);
+    auto server = net::accept(*acceptor);
+    if (!client || !server)
+      fail("failed to connect to the accept socket");
+    std::ignore = net::nodelay(*client, true);
+    std::ignore = net::nodelay(*server, true);
+    std::ignore = net::nonblocking(*server, true);
+    auto mgr = net::socket_manager::make(mpx.get(),
+                                         std::make_unique<echo>(*server));
+    mpx->start(std::move(mgr));
+    clients.push_back(*client);
+  }
+  net::close(*acceptor);
+  std::array<std::byte, msg_size> msg;
+  msg.fill(std::byte{'x'});
+  std::array<std::byte, msg_size> reply;
+  size_t round_trips = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  auto t1 = t0;
+  while (t1 - t0 < run_time) {
+    for (auto fd : clients)
+      if (write(fd, msg) != static_cast<ptrdiff_t>(msg_size))
+        fail("failed to write to the socket");
+    for (auto fd : clients) {
+      size_t received = 0;
+      while (received < msg_size) {
+        auto res = read(fd, make_span(reply).subspan(received));
+        if (res <= 0)
+          fail("failed to read from the socket");
+        received += static_cast<size_t>(res);
+      }
+    }
+    round_trips += clients.size();
+    t1 = std::chrono::steady_clock::now();
+  }
+  mpx->shutdown();
+  mpx_thread.join();
+  for (auto fd : clients)
+    net::close(fd);
+  using secs = std::chrono::duration<double>;
+  return static_cast<double>(round_trips) / secs{t1 - t0}.count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t max_connections = 1'024;
+  if (argc > 1)
+    max_connections = std::stoul(argv[1]);
+  net::this_host::startup();
+  printf("%12s | %16s | %16s\n", "connections", "poll [k/s]",
+         "epoll [k/s]");
+  for (size_t n = 1; n <= max_connections; n *= 4) {
+    auto x = run("poll", n);
+    auto y = run("epoll", n);
+    printf("%12zu | %16.2f | %16.2f\n", n, x / 1e3, y / 1e3);
+  }
+  net::this_host::cleanup();
+}
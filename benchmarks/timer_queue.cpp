@@ -0,0 +1,110 @@
+// Compares the timer queues of the clock thread for a growing number of
+// pending timeouts.
+//
+// For each number of pending timeouts, the benchmark measures the average time
+// for scheduling a new timeout and for advancing the clock by one millisecond.
+// Pending timeouts spread evenly over one minute and 90% of all timeouts get
+// canceled before they expire, similar to request timeouts that receive a
+// response in time.
+
+#include "caf/action.hpp"
+#include "caf/detail/sorted_timer_queue.hpp"
+#include "caf/detail/timer_wheel.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+using time_point = clock_type::time_point;
+
+struct entry : detail::timer_wheel_node<entry> {
+  entry(time_point t, action f) : t(t), f(std::move(f)) {
+    // nop
+  }
+
+  time_point t;
+  action f;
+};
+
+/// Number of new timeouts per measurement.
+constexpr size_t num_inserts = 1'000;
+
+/// Number of ticks per measurement.
+constexpr size_t num_ticks = 1'000;
+
+/// All timeouts expire within this time window.
+constexpr auto max_delay = 60s;
+
+struct result {
+  double insert_ns;
+  double tick_ns;
+};
+
+template <class Queue>
+result run(Queue& queue, size_t num_pending) {
+  std::minstd_rand rng{static_cast<unsigned>(num_pending)};
+  std::uniform_int_distribution<int64_t> delay{1, max_delay / 1ms};
+  std::uniform_int_distribution<int> percent{0, 99};
+  auto t0 = time_point{} + 1h;
+  std::vector<action> canceled;
+  auto make_entry = [&](time_point t) {
+    auto f = make_action([] {});
+    if (percent(rng) < 90)
+      canceled.push_back(f);
+    return std::make_unique<entry>(t, std::move(f));
+  };
+  // Pre-fill the queue in order of timeouts to keep setup costs low.
+  auto step = std::chrono::nanoseconds{max_delay}
+              / static_cast<int64_t>(num_pending + 1);
+  for (size_t i = 1; i <= num_pending; ++i)
+    queue.insert(make_entry(t0 + step * static_cast<int64_t>(i)));
+  for (auto& f : canceled)
+    f.dispose();
+  canceled.clear();
+  // Schedule new timeouts at random points in time.
+  std::vector<std::unique_ptr<entry>> entries;
+  entries.reserve(num_inserts);
+  for (size_t i = 0; i < num_inserts; ++i)
+    entries.emplace_back(make_entry(t0 + 1ms * delay(rng)));
+  auto start = clock_type::now();
+  for (auto& ptr : entries)
+    queue.insert(std::move(ptr));
+  auto insert_time = clock_type::now() - start;
+  // Advance the clock one millisecond at a time.
+  auto fire = [](auto& ptr) { ptr->f.run(); };
+  start = clock_type::now();
+  for (size_t i = 1; i <= num_ticks; ++i)
+    queue.advance(t0 + 1ms * static_cast<int64_t>(i), fire);
+  auto tick_time = clock_type::now() - start;
+  using ns = std::chrono::duration<double, std::nano>;
+  return {ns{insert_time}.count() / num_inserts,
+          ns{tick_time}.count() / num_ticks};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  size_t max_pending = 1'000'000;
+  if (argc > 1)
+    max_pending = std::stoul(argv[1]);
+  printf("%10s | %18s | %18s | %18s | %18s\n", "pending", "sorted insert [ns]",
+         "sorted tick [ns]", "wheel insert [ns]", "wheel tick [ns]");
+  for (size_t n = 1'000; n <= max_pending; n *= 10) {
+    detail::sorted_timer_queue<entry> sorted;
+    auto x = run(sorted, n);
+    detail::timer_wheel<entry> wheel{time_point{} + 1h, 1ms};
+    auto y = run(wheel, n);
+    printf("%10zu | %18.1f | %18.1f | %18.1f | %18.1f\n", n, x.insert_ns,
+           x.tick_ns, y.insert_ns, y.tick_ns);
+  }
+}
@@ -0,0 +1,124 @@
+// Compares validating UTF-8 input one character at a time (the previous
+// implementation of rfc3629::valid) with the current implementation that skips
+// runs of ASCII characters one word at a time.
+//
+// For each corpus, the benchmark prints the throughput in GB/s.
+
+#include "caf/detail/rfc3629.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/span.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string_view>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+/// Duration of each measurement.
+constexpr auto run_time = 500ms;
+
+/// Size of each corpus.
+constexpr size_t corpus_size = 64 * 1024;
+
+constexpr bool is_continuation_byte(std::byte x) noexcept {
+  return (x & std::byte{0xC0}) == std::byte{0x80};
+}
+
+// Condensed version of the previous implementation. Checks the same
+// constraints in the same order, but only reports success or failure.
+bool valid_bytewise(const_byte_span bytes) noexcept {
+  auto first = bytes.begin();
+  auto last = bytes.end();
+  auto next_is_continuation = [&] {
+    return first != last && is_continuation_byte(*first++);
+  };
+  while (first != last) {
+    auto x = std::to_integer<int>(*first++);
+    if (x < 0x80)
+      continue;
+    if ((x & 0xE0) == 0xC0) {
+      if (x < 0xC2 || !next_is_continuation())
+        return false;
+      continue;
+    }
+    if ((x & 0xF0) == 0xE0) {
+      if (first == last)
+        return false;
+      auto y = std::to_integer<int>(*first);
+      if ((x == 0xE0 && y < 0xA0) || (x == 0xED && y >= 0xA0))
+        return false;
+      if (!next_is_continuation() || !next_is_continuation())
+        return false;
+      continue;
+    }
+    if ((x & 0xF8) == 0xF0 && x <= 0xF4) {
+      if (first == last)
+        return false;
+      auto y = std::to_integer<int>(*first);
+      if ((x == 0xF0 && y < 0x90) || (x == 0xF4 && y >= 0x90))
+        return false;
+      if (!next_is_continuation() || !next_is_continuation()
+          || !next_is_continuation())
+        return false;
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+/// Fills a buffer with copies of `text` until reaching `corpus_size`.
+byte_buffer make_corpus(std::string_view text) {
+  byte_buffer result;
+  auto bytes = as_bytes(make_span(text));
+  while (result.size() + bytes.size() <= corpus_size)
+    result.insert(result.end(), bytes.begin(), bytes.end());
+  return result;
+}
+
+template <class F>
+double run(const byte_buffer& corpus, F fn) {
+  size_t total = 0;
+  size_t failures = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + run_time;
+  auto now = start;
+  do {
+    for (int i = 0; i < 16; ++i) {
+      if (!fn(make_span(corpus)))
+        ++failures;
+      total += corpus.size();
+    }
+    now = std::chrono::steady_clock::now();
+  } while (now < deadline);
+  if (failures > 0)
+    puts("validation failed");
+  using secs = std::chrono::duration<double>;
+  return static_cast<double>(total) / secs{now - start}.count();
+}
+
+} // namespace
+
+int main() {
+  struct {
+    const char* name;
+    std::string_view text;
+  } inputs[] = {
+    {"ascii", R"({"id": 42, "name": "sensor-7", "values": [1.5, 2.25]})"},
+    {"mixed", "Grüße aus Köln, schöne Straße! Prix: 12,50 €. "},
+    {"cjk", "中文文本的验证速度测试。日本語のテキストも含まれています。"},
+  };
+  printf("%8s | %18s | %18s\n", "corpus", "bytewise [GB/s]", "valid [GB/s]");
+  for (auto& input : inputs) {
+    auto corpus = make_corpus(input.text);
+    auto x = run(corpus, valid_bytewise);
+    auto y = run(corpus, [](const_byte_span bytes) {
+      return detail::rfc3629::valid(bytes);
+    });
+    printf("%8s | %18.2f | %18.2f\n", input.name, x / 1e9, y / 1e9);
+  }
+}
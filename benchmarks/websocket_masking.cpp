@@ -0,0 +1,74 @@
+// Compares masking WebSocket payloads one byte at a time (the previous
+// implementation of rfc6455::mask_data) with the current implementation that
+// masks whole words.
+//
+// For each payload size, the benchmark prints the throughput in GB/s.
+
+#include "caf/detail/rfc6455.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/span.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+/// Duration of each measurement.
+constexpr auto run_time = 500ms;
+
+void mask_bytewise(uint32_t key, byte_span data, size_t offset) {
+  std::byte arr[4] = {
+    static_cast<std::byte>((key >> 24) & 0xFF),
+    static_cast<std::byte>((key >> 16) & 0xFF),
+    static_cast<std::byte>((key >> 8) & 0xFF),
+    static_cast<std::byte>(key & 0xFF),
+  };
+  auto i = offset % 4;
+  for (auto it = data.begin() + offset; it < data.end(); ++it) {
+    *it ^= arr[i];
+    i = (i + 1) % 4;
+  }
+}
+
+template <class F>
+double run(size_t size, F fn) {
+  byte_buffer buf;
+  buf.resize(size, std::byte{0x42});
+  auto key = uint32_t{0xDEADC0DE};
+  size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + run_time;
+  auto now = start;
+  do {
+    for (int i = 0; i < 16; ++i) {
+      fn(key, make_span(buf), size_t{0});
+      total += size;
+    }
+    now = std::chrono::steady_clock::now();
+  } while (now < deadline);
+  // Prevent the compiler from optimizing away the masking.
+  if (buf[0] == std::byte{0x01})
+    puts("unreachable");
+  using secs = std::chrono::duration<double>;
+  return static_cast<double>(total) / secs{now - start}.count();
+}
+
+} // namespace
+
+int main() {
+  printf("%12s | %18s | %18s\n", "size [bytes]", "bytewise [GB/s]",
+         "mask_data [GB/s]");
+  for (size_t size : {64u, 1'024u, 64 * 1'024u, 1'024 * 1'024u}) {
+    auto x = run(size, mask_bytewise);
+    auto y = run(size, [](uint32_t key, byte_span data, size_t offset) {
+      detail::rfc6455::mask_data(key, data, offset);
+    });
+    printf("%12zu | %18.2f | %18.2f\n", size, x / 1e9, y / 1e9);
+  }
+}
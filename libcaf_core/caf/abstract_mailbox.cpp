@@ -10,4 +10,13 @@ abstract_mailbox::~abstract_mailbox() {
   // nop
 }
 
+size_t abstract_mailbox::capacity() const noexcept {
+  return 0;
+}
+
+void abstract_mailbox::setup_metrics(telemetry::int_gauge*,
+                                     telemetry::dbl_gauge*) noexcept {
+  // nop
+}
+
 } // namespace caf
@@ -19,8 +19,9 @@ public:
   /// Adds a new element to the mailbox.
   /// @returns `inbox_result::success` if the element has been added to the
   ///          mailbox, `inbox_result::unblocked_reader` if the reader has been
-  ///          unblocked, or `inbox_result::queue_closed` if the mailbox has
-  ///          been closed.
+  ///          unblocked, `inbox_result::queue_closed` if the mailbox has
+  ///          been closed, or `inbox_result::queue_full` if a bounded mailbox
+  ///          has reached its capacity.
   /// @threadsafe
   virtual intrusive::inbox_result push_back(mailbox_element_ptr ptr) = 0;
 
@@ -60,6 +61,18 @@ public:
   /// @note Only the owning actor is allowed to call this function.
   virtual size_t size() = 0;
 
+  /// Returns the maximum number of pending messages or 0 if the mailbox is
+  /// unbounded.
+  virtual size_t capacity() const noexcept;
+
+  /// Passes the metrics of the owning actor to the mailbox. Bounded mailboxes
+  /// decrement `size` for each message they drop on their own and report the
+  /// number of pending messages relative to their capacity to `fill_level`.
+  /// The default implementation does nothing.
+  /// @note Only the owning actor is allowed to call this function.
+  virtual void setup_metrics(telemetry::int_gauge* size,
+                             telemetry::dbl_gauge* fill_level) noexcept;
+
   /// Increases the reference count by one.
   virtual void ref_mailbox() noexcept = 0;
 
@@ -32,6 +32,7 @@ public:
   int flags = 0;
   detail::unique_function<behavior(local_actor*)> init_fun;
   detail::mailbox_factory* mbox_factory = nullptr;
+  int numa_node = -1;
 
   // -- properties -------------------------------------------------------------
 
@@ -37,10 +37,8 @@ actor_registry::actor_registry(actor_system& sys) : system_(sys) {
 }
 
 strong_actor_ptr actor_registry::get_impl(actor_id key) const {
-  shared_guard guard(instances_mtx_);
-  auto i = entries_.find(key);
-  if (i != entries_.end())
-    return i->second;
+  if (auto ptr = entries_.get(key))
+    return ptr;
   log::core::debug("key invalid, assume actor no longer exists: key = {}", key);
   return nullptr;
 }
@@ -49,11 +47,8 @@ void actor_registry::put_impl(actor_id key, strong_actor_ptr val) {
   auto lg = log::core::trace("key = {}", key);
   if (!val)
     return;
-  { // lifetime scope of guard
-    exclusive_guard guard(instances_mtx_);
-    if (!entries_.emplace(key, val).second)
-      return;
-  }
+  if (!entries_.insert(key, val))
+    return;
   // attach functor without lock
   log::core::debug("added actor: key = {}", key);
   actor_registry* reg = this;
@@ -61,19 +56,12 @@ void actor_registry::put_impl(actor_id key, strong_actor_ptr val) {
 }
 
 void actor_registry::erase(actor_id key) {
-  // Stores a reference to the actor we're going to remove. This guarantees
-  // that we aren't releasing the last reference to an actor while erasing it.
-  // Releasing the final ref can trigger the actor to call its cleanup function
-  // that in turn calls this function and we can end up in a deadlock.
-  strong_actor_ptr ref;
-  { // Lifetime scope of guard.
-    exclusive_guard guard{instances_mtx_};
-    auto i = entries_.find(key);
-    if (i != entries_.end()) {
-      ref.swap(i->second);
-      entries_.erase(i);
-    }
-  }
+  // The map hands us its reference to the actor we're going to remove. This
+  // guarantees that we aren't releasing the last reference to an actor while
+  // the map holds its lock. Releasing the final ref can trigger the actor to
+  // call its cleanup function that in turn calls this function and we can end
+  // up in a deadlock.
+  auto ref = entries_.erase(key);
 }
 
 size_t actor_registry::inc_running() {
@@ -144,10 +132,7 @@ void actor_registry::start() {
 }
 
 void actor_registry::stop() {
-  {
-    exclusive_guard guard{instances_mtx_};
-    entries_.clear();
-  }
+  entries_.clear();
   {
     exclusive_guard guard{named_entries_mtx_};
     named_entries_.clear();
@@ -8,6 +8,7 @@
 #include "caf/actor.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/actor_control_block.hpp"
+#include "caf/detail/concurrent_actor_map.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/fwd.hpp"
 #include "caf/telemetry/int_gauge.hpp"
@@ -106,15 +107,14 @@ private:
   /// Associates given actor to `key`.
   void put_impl(const std::string& key, strong_actor_ptr value);
 
-  using entries = std::unordered_map<actor_id, strong_actor_ptr>;
-
   actor_registry(actor_system& sys);
 
   mutable std::mutex running_mtx_;
   mutable std::condition_variable running_cv_;
 
-  mutable std::shared_mutex instances_mtx_;
-  entries entries_;
+  /// Maps actor IDs to actors. Lookups by ID happen for each actor handle that
+  /// CAF deserializes and thus must not block.
+  detail::concurrent_actor_map entries_;
 
   name_map named_entries_;
   mutable std::shared_mutex named_entries_mtx_;
@@ -7,8 +7,11 @@
 #include "caf/actor.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/bounded_mailbox_factory.hpp"
 #include "caf/detail/meta_object.hpp"
+#include "caf/detail/size_class_allocator.hpp"
 #include "caf/event_based_actor.hpp"
+#include "caf/mailbox_policy.hpp"
 #include "caf/raise_error.hpp"
 #include "caf/scheduler.hpp"
 #include "caf/stateful_actor.hpp"
@@ -236,6 +239,9 @@ auto make_actor_metric_families(telemetry::metric_registry& reg) {
       "Time a message waits in the mailbox before processing.", "seconds"),
     reg.gauge_family("caf.actor", "mailbox-size", {"name"},
                      "Number of messages in the mailbox."),
+    reg.gauge_family<double>(
+      "caf.actor", "mailbox-fill", {"name"},
+      "Number of messages in a bounded mailbox relative to its capacity."),
     {
       reg.counter_family("caf.actor.stream", "processed-elements",
                          {"name", "type"},
@@ -281,6 +287,30 @@ actor_system::actor_system(actor_system_config& cfg)
     metrics_actors_excludes_ = std::move(*lst);
   if (!metrics_actors_includes_.empty())
     actor_metric_families_ = make_actor_metric_families(metrics_);
+  // Note: the allocator is a process-wide resource. With multiple actor
+  //       systems, the last one wins.
+  if (get_or(cfg, "caf.memory.pooled-allocation",
+             defaults::memory::pooled_allocation)) {
+    detail::size_class_allocator::enable(true);
+    detail::size_class_allocator::attach(metrics_);
+  } else {
+    detail::size_class_allocator::enable(false);
+  }
+  // Bound the mailboxes of scheduled actors if configured.
+  if (auto capacity = get_or(cfg, "caf.mailbox.capacity",
+                             defaults::mailbox::capacity);
+      capacity > 0) {
+    auto policy = mailbox_policy::reject;
+    auto config_policy = get_or(cfg, "caf.mailbox.policy",
+                                defaults::mailbox::policy);
+    if (!from_string(config_policy, policy))
+      fprintf(stderr,
+              "[WARNING] '%s' is an unrecognized mailbox policy, falling "
+              "back to 'reject'\n",
+              config_policy.c_str());
+    mailbox_factory_ = std::make_unique<detail::bounded_mailbox_factory>(
+      capacity, policy);
+  }
   // Spin up modules.
   for (auto& f : cfg.module_factories) {
     auto mod_ptr = f(*this);
@@ -368,6 +398,7 @@ actor_system::~actor_system() {
     private_threads_.stop();
     registry_.stop();
   }
+  detail::size_class_allocator::detach(metrics_);
   // reset logger and wait until dtor was called
   CAF_SET_LOGGER_SYS(nullptr);
   logger_->stop();
@@ -503,7 +534,9 @@ void actor_system::release_private_thread(detail::private_thread* ptr) {
 }
 
 detail::mailbox_factory* actor_system::mailbox_factory() {
-  return cfg_.mailbox_factory();
+  if (auto* result = cfg_.mailbox_factory())
+    return result;
+  return mailbox_factory_.get();
 }
 
 /// Set a handle to the central printing actor.
@@ -225,6 +225,10 @@ public:
     /// Counts how many messages are currently waiting in the mailbox.
     telemetry::int_gauge_family* mailbox_size = nullptr;
 
+    /// Tracks the number of messages in a bounded mailbox relative to its
+    /// capacity.
+    telemetry::dbl_gauge_family* mailbox_fill = nullptr;
+
     struct {
       // -- inbound ------------------------------------------------------------
 
@@ -527,6 +531,8 @@ public:
       cfg.flags |= abstract_actor::is_detached_flag;
     if constexpr (has_hide_flag(Os))
       cfg.flags |= abstract_actor::is_hidden_flag;
+    if constexpr (has_numa_node_flag(Os))
+      cfg.numa_node = numa_node_of(Os);
     if (cfg.host == nullptr)
       cfg.host = dummy_execution_unit();
     CAF_SET_LOGGER_SYS(this);
@@ -619,6 +625,8 @@ public:
       cfg.flags |= abstract_actor::is_detached_flag;
     if constexpr (has_hide_flag(Os))
       cfg.flags |= abstract_actor::is_hidden_flag;
+    if constexpr (has_numa_node_flag(Os))
+      cfg.numa_node = numa_node_of(Os);
     cfg.mbox_factory = mailbox_factory();
     auto res = make_actor<Impl>(next_actor_id(), node(), this, cfg,
                                 std::forward<Ts>(xs)...);
@@ -735,6 +743,10 @@ private:
   /// Manages threads for detached actors.
   detail::private_thread_pool private_threads_;
 
+  /// Creates mailboxes for scheduled actors unless the config provides its
+  /// own factory. Remains `nullptr` for unbounded mailboxes.
+  std::unique_ptr<detail::mailbox_factory> mailbox_factory_;
+
   /// Ties the lifetime of the meta objects table to the actor system.
   detail::global_meta_objects_guard_type meta_objects_guard_;
 
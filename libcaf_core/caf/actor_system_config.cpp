@@ -62,6 +62,17 @@ actor_system_config::actor_system_config()
     .add<size_t>("max-throughput",
                  "nr. of messages actors can consume per run");
   opt_group(custom_options_, "caf.work-stealing")
+    .add<string>("queue", "'lock-free' (default) or 'locking'")
+    .add<string>("external-enqueue",
+                 "'round-robin' (default) or 'least-loaded'")
+    .add<string>("idle-strategy", "'parking' (default) or 'polling'")
+    .add<size_t>("steal-batch-size",
+                 "max. nr. of jobs a worker may take from another at once")
+    .add<bool>("numa-aware", "pin workers to CPUs and group them by NUMA node")
+    .add<string>("numa-topology-path",
+                 "sysfs directory with the NUMA nodes of the machine")
+    .add<bool>("worker-timers",
+               "run timeouts on the worker that scheduled them")
     .add<size_t>("aggressive-poll-attempts", "nr. of aggressive steal attempts")
     .add<size_t>("aggressive-steal-interval",
                  "frequency of aggressive steal attempts")
@@ -74,6 +85,20 @@ actor_system_config::actor_system_config()
                  "frequency of relaxed steal attempts")
     .add<timespan>("relaxed-sleep-duration",
                    "sleep duration between relaxed steal attempts");
+  opt_group{custom_options_, "caf.work-sharing"}.add<size_t>(
+    "segment-size", "nr. of jobs per segment of the central job queue");
+  opt_group{custom_options_, "caf.memory"}
+    .add<bool>("pooled-allocation",
+               "allocate messages from per-thread pools (default: true)");
+  opt_group{custom_options_, "caf.clock"}
+    .add<string>("timer-queue", "either 'sorted' (default) or 'wheel'")
+    .add<timespan>("wheel-resolution",
+                   "length of a single tick of the timing wheel");
+  opt_group{custom_options_, "caf.mailbox"}
+    .add<size_t>("capacity",
+                 "maximum number of messages per actor (default: unbounded)")
+    .add<string>("policy",
+                 "either 'reject', 'drop_oldest', 'drop_newest' or 'block'");
   opt_group{custom_options_, "caf.logger.file"}
     .add<string>("path", "filesystem path for the log file")
     .add<string>("format", "format for individual log file entries")
@@ -104,6 +129,11 @@ settings actor_system_config::dump_content() const {
               defaults::scheduler::max_throughput);
   // -- work-stealing parameters
   auto& work_stealing_group = caf_group["work-stealing"].as_dictionary();
+  put_missing(work_stealing_group, "queue", defaults::work_stealing::queue);
+  put_missing(work_stealing_group, "external-enqueue",
+              defaults::work_stealing::external_enqueue);
+  put_missing(work_stealing_group, "idle-strategy",
+              defaults::work_stealing::idle_strategy);
   put_missing(work_stealing_group, "aggressive-poll-attempts",
               defaults::work_stealing::aggressive_poll_attempts);
   put_missing(work_stealing_group, "aggressive-steal-interval",
@@ -118,6 +148,31 @@ settings actor_system_config::dump_content() const {
               defaults::work_stealing::relaxed_steal_interval);
   put_missing(work_stealing_group, "relaxed-sleep-duration",
               defaults::work_stealing::relaxed_sleep_duration);
+  put_missing(work_stealing_group, "steal-batch-size",
+              defaults::work_stealing::steal_batch_size);
+  put_missing(work_stealing_group, "numa-aware",
+              defaults::work_stealing::numa_aware);
+  put_missing(work_stealing_group, "numa-topology-path",
+              defaults::work_stealing::numa_topology_path);
+  put_missing(work_stealing_group, "worker-timers",
+              defaults::work_stealing::worker_timers);
+  // -- work-sharing parameters
+  auto& work_sharing_group = caf_group["work-sharing"].as_dictionary();
+  put_missing(work_sharing_group, "segment-size",
+              defaults::work_sharing::segment_size);
+  // -- memory parameters
+  auto& memory_group = caf_group["memory"].as_dictionary();
+  put_missing(memory_group, "pooled-allocation",
+              defaults::memory::pooled_allocation);
+  // -- clock parameters
+  auto& clock_group = caf_group["clock"].as_dictionary();
+  put_missing(clock_group, "timer-queue", defaults::clock::timer_queue);
+  put_missing(clock_group, "wheel-resolution",
+              defaults::clock::wheel_resolution);
+  // -- mailbox parameters
+  auto& mailbox_group = caf_group["mailbox"].as_dictionary();
+  put_missing(mailbox_group, "capacity", defaults::mailbox::capacity);
+  put_missing(mailbox_group, "policy", defaults::mailbox::policy);
   // -- logger parameters
   auto& logger_group = caf_group["logger"].as_dictionary();
   auto& file_group = logger_group["file"].as_dictionary();
@@ -71,6 +71,26 @@ public:
       }
     }
 
+    template <class ErrorPolicy, class OnNext>
+    read_result pull(ErrorPolicy policy, size_t demand, OnNext& on_next) {
+      if (buf_) {
+        batch_observer<OnNext> dst{this, &on_next};
+        auto [again, n] = buf_->pull(policy, demand, dst);
+        if (!again) {
+          buf_ = nullptr;
+        }
+        if (n > 0) {
+          return read_result::ok;
+        } else if (again) {
+          return read_result::try_again_later;
+        } else {
+          return abort_reason_ ? read_result::abort : read_result::stop;
+        }
+      } else {
+        return abort_reason_ ? read_result::abort : read_result::stop;
+      }
+    }
+
     const error& abort_reason() const noexcept {
       return abort_reason_;
     }
@@ -112,6 +132,25 @@ public:
     }
 
   private:
+    /// Forwards items from the buffer to a function object.
+    template <class OnNext>
+    struct batch_observer {
+      impl* self;
+      OnNext* fn;
+
+      void on_next(const T& item) {
+        (*fn)(item);
+      }
+
+      void on_complete() {
+        // nop
+      }
+
+      void on_error(const caf::error& what) {
+        self->abort_reason_ = what;
+      }
+    };
+
     spsc_buffer_ptr<T> buf_;
     execution_context_ptr ctx_;
     action do_wakeup_;
@@ -153,6 +192,17 @@ public:
       return read_result::abort;
   }
 
+  /// Pulls up to `demand` items from the buffer at once and calls `on_next`
+  /// for each item. Returns `read_result::ok` if `on_next` was called at least
+  /// once.
+  template <class Policy, class OnNext>
+  read_result pull(Policy policy, size_t demand, OnNext& on_next) {
+    if (impl_)
+      return impl_->pull(policy, demand, on_next);
+    else
+      return read_result::abort;
+  }
+
   void cancel() {
     if (impl_) {
       impl_->cancel();
@@ -37,7 +37,9 @@ void produce(async::producer_resource<int> push) {
 
 class runner_t {
 public:
-  runner_t(async::spsc_buffer_ptr<int> buf, async::execution_context_ptr ctx) {
+  runner_t(async::spsc_buffer_ptr<int> buf, async::execution_context_ptr ctx,
+           size_t batch_size = 0)
+    : batch_size_(batch_size) {
     do_wakeup_ = make_action([this] { resume(); });
     in_ = make_consumer_adapter(buf, ctx, do_wakeup_);
   }
@@ -48,11 +50,15 @@ public:
 
   void resume() {
     int tmp = 0;
+    auto on_next = [this](int x) { values_.push_back(x); };
     for (;;) {
-      auto res = in_.pull(async::delay_errors, tmp);
+      auto res = batch_size_ > 0
+                   ? in_.pull(async::delay_errors, batch_size_, on_next)
+                   : in_.pull(async::delay_errors, tmp);
       switch (res) {
         case async::read_result::ok:
-          values_.push_back(tmp);
+          if (batch_size_ == 0)
+            values_.push_back(tmp);
           break;
         case async::read_result::stop:
           do_wakeup_.dispose();
@@ -77,6 +83,7 @@ public:
   }
 
 private:
+  size_t batch_size_;
   async::consumer_adapter<int> in_;
   action do_wakeup_;
   std::vector<int> values_;
@@ -103,6 +110,23 @@ SCENARIO("consumer adapters allow integrating consumers into event loops") {
         producer.join();
       }
     }
+    WHEN("consuming the generated value in batches") {
+      THEN("the consumer receives all values in order") {
+        auto [pull, push] = async::make_spsc_buffer_resource<int>();
+        std::thread producer{produce, push};
+        auto loop = flow::make_scoped_coordinator();
+        runner_t runner{pull.try_open(), loop, 32};
+        loop->watch(runner.as_disposable());
+        runner.start();
+        loop->run();
+        auto& got = runner.values();
+        auto want = std::vector<int>(5000);
+        std::iota(want.begin(), want.end(), 0);
+        check_eq(got.size(), 5000u);
+        check_eq(got, want);
+        producer.join();
+      }
+    }
   }
 }
 
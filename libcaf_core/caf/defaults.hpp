@@ -100,6 +100,23 @@ constexpr auto max_throughput = std::numeric_limits<size_t>::max();
 
 namespace caf::defaults::work_stealing {
 
+/// Selects the job queue of each worker. The `lock-free` queue (default)
+/// combines a Chase-Lev deque for local jobs with a lock-free inbox for jobs
+/// from other threads. The `locking` queue uses a mutex-protected list.
+constexpr auto queue = std::string_view{"lock-free"};
+
+/// Selects how the scheduler distributes jobs from threads that do not belong
+/// to the scheduler. Jobs from worker threads always stay on that worker.
+/// Accepted values are `round-robin` (default) and `least-loaded`.
+constexpr auto external_enqueue = std::string_view{"round-robin"};
+
+/// Selects what workers do after running out of jobs. With `parking`
+/// (default), workers poll aggressively for a short time and then sleep until
+/// another thread enqueues a new job. With `polling`, workers fall back to the
+/// moderate and relaxed poll strategies and never sleep for longer than the
+/// relaxed sleep duration.
+constexpr auto idle_strategy = std::string_view{"parking"};
+
 constexpr auto aggressive_poll_attempts = size_t{100};
 constexpr auto aggressive_steal_interval = size_t{10};
 constexpr auto moderate_poll_attempts = size_t{500};
@@ -108,8 +125,66 @@ constexpr auto moderate_sleep_duration = timespan{50'000};
 constexpr auto relaxed_steal_interval = size_t{1};
 constexpr auto relaxed_sleep_duration = timespan{10'000'000};
 
+/// Limits how many jobs a worker may take from its victim in one steal. Workers
+/// take at most half of the jobs of the victim. Setting this to 1 restores
+/// stealing a single job at a time.
+constexpr auto steal_batch_size = size_t{32};
+
+/// Configures whether the scheduler reads the NUMA topology of the machine at
+/// startup, pins each worker to a CPU and groups workers by NUMA node.
+constexpr auto numa_aware = false;
+
+/// Configures where the scheduler reads the NUMA topology from if
+/// `numa_aware` is `true`.
+constexpr auto numa_topology_path
+  = std::string_view{"/sys/devices/system/node"};
+
+/// Configures whether each worker runs the timeouts that its jobs schedule on a
+/// local timer wheel instead of passing them to the clock thread.
+constexpr auto worker_timers = false;
+
 } // namespace caf::defaults::work_stealing
 
+namespace caf::defaults::work_sharing {
+
+/// Configures how many jobs fit into each segment of the central job queue.
+/// The queue allocates a new segment whenever the current one runs full.
+constexpr auto segment_size = size_t{1024};
+
+} // namespace caf::defaults::work_sharing
+
+namespace caf::defaults::memory {
+
+/// Configures whether CAF allocates messages and mailbox elements from
+/// per-thread pools instead of calling `malloc` and `free` for each object.
+constexpr auto pooled_allocation = true;
+
+} // namespace caf::defaults::memory
+
+namespace caf::defaults::clock {
+
+/// Configures how the clock thread stores pending timeouts. Either `sorted`
+/// (a sorted vector) or `wheel` (a hierarchical timing wheel).
+constexpr auto timer_queue = std::string_view{"sorted"};
+
+/// Configures the length of a single tick of the timing wheel. The clock may
+/// run timeouts up to one tick late.
+constexpr auto wheel_resolution = timespan{1'000'000};
+
+} // namespace caf::defaults::clock
+
+namespace caf::defaults::mailbox {
+
+/// Configures the maximum number of messages in the mailbox of a scheduled
+/// actor. The default value of 0 disables the limit.
+constexpr auto capacity = size_t{0};
+
+/// Configures how bounded mailboxes handle new messages after reaching their
+/// capacity. See `caf::mailbox_policy` for the available options.
+constexpr auto policy = std::string_view{"reject"};
+
+} // namespace caf::defaults::mailbox
+
 namespace caf::defaults::logger::file {
 
 constexpr auto format = std::string_view{"%r %c %p %a %t %M %F:%L %m%n"};
@@ -174,4 +249,36 @@ constexpr auto https_default_port = uint16_t{443};
 /// The default buffer size for reading and writing octet streams.
 constexpr auto octet_stream_buffer_size = uint32_t{1024};
 
+/// The default maximum size for incoming UDP datagrams. The transport drops
+/// larger datagrams.
+constexpr auto udp_max_datagram_size = size_t{65'507};
+
+/// The default number of datagrams that a UDP transport receives or sends with
+/// a single system call (if supported by the platform).
+constexpr auto udp_batch_size = size_t{16};
+
+/// The default maximum number of sessions that an SSL server keeps in its
+/// session cache.
+constexpr auto ssl_session_cache_size = size_t{20'480};
+
+/// The default lifetime of cached SSL sessions and of session tickets.
+constexpr auto ssl_session_lifetime = timespan{300'000'000'000};
+
+/// The default maximum number of sessions that an SSL client keeps for
+/// resuming connections, i.e., the number of servers it remembers.
+constexpr auto ssl_client_session_cache_size = size_t{1'024};
+
+/// Configures how the multiplexer waits for I/O events. Either `poll` (all
+/// platforms) or `epoll` (Linux only).
+constexpr auto multiplexer = std::string_view{"poll"};
+
+/// Configures how many multiplexers (and thus threads) the networking module
+/// runs. The first multiplexer runs all acceptors and clients. Accepted
+/// connections are distributed across all multiplexers.
+constexpr auto multiplexer_threads = size_t{1};
+
+/// Configures how acceptors distribute new connections across multiplexers.
+/// Either `round-robin` or `least-connections`.
+constexpr auto connection_distribution = std::string_view{"round-robin"};
+
 } // namespace caf::defaults::net
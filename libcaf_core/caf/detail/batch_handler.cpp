@@ -0,0 +1,13 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/batch_handler.hpp"
+
+namespace caf::detail {
+
+batch_handler::~batch_handler() {
+  // nop
+}
+
+} // namespace caf::detail
@@ -0,0 +1,77 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/scope_guard.hpp"
+#include "caf/fwd.hpp"
+#include "caf/mailbox_element.hpp"
+#include "caf/span.hpp"
+#include "caf/type_id_list.hpp"
+
+#include <type_traits>
+#include <vector>
+
+namespace caf::detail {
+
+/// Collects consecutive messages of a single type in order to process them
+/// with a single function call.
+class CAF_CORE_EXPORT batch_handler {
+public:
+  virtual ~batch_handler();
+
+  /// Checks whether `x` belongs into the batch.
+  virtual bool accepts(const mailbox_element& x) const noexcept = 0;
+
+  /// Adds the content of `x` to the batch.
+  /// @pre `accepts(x)`
+  virtual void add(mailbox_element& x) = 0;
+
+  /// Returns the number of collected messages.
+  virtual size_t size() const noexcept = 0;
+
+  /// Passes all collected messages to the user-defined function and clears
+  /// the batch afterwards.
+  virtual void run() = 0;
+};
+
+/// Collects asynchronous messages that consist of a single `T`.
+template <class T, class F>
+class batch_handler_impl final : public batch_handler {
+public:
+  static_assert(std::is_invocable_v<F, span<T>>,
+                "batch handlers must accept a span<T>");
+
+  explicit batch_handler_impl(F fn) : fn_(std::move(fn)) {
+    // nop
+  }
+
+  bool accepts(const mailbox_element& x) const noexcept override {
+    return x.mid.is_async() && x.payload.match_elements<T>();
+  }
+
+  void add(mailbox_element& x) override {
+    if (x.payload.unique())
+      items_.emplace_back(std::move(x.payload.get_mutable_as<T>(0)));
+    else
+      items_.emplace_back(x.payload.get_as<T>(0));
+  }
+
+  size_t size() const noexcept override {
+    return items_.size();
+  }
+
+  void run() override {
+    // Clear the buffer even if `fn_` throws but keep its capacity.
+    auto guard = scope_guard{[this]() noexcept { items_.clear(); }};
+    fn_(span<T>{items_.data(), items_.size()});
+  }
+
+private:
+  F fn_;
+  std::vector<T> items_;
+};
+
+} // namespace caf::detail
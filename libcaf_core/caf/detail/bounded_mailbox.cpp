@@ -0,0 +1,246 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/bounded_mailbox.hpp"
+
+#include "caf/abstract_actor.hpp"
+#include "caf/actor_cast.hpp"
+#include "caf/detail/sync_request_bouncer.hpp"
+#include "caf/error.hpp"
+#include "caf/message_id.hpp"
+#include "caf/sec.hpp"
+#include "caf/system_messages.hpp"
+#include "caf/telemetry/dbl_gauge.hpp"
+#include "caf/telemetry/int_gauge.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+/// Checks whether the sender of `x` may block its thread while waiting for the
+/// receiver.
+bool has_blocking_sender(const mailbox_element& x) {
+  // Note: actor_cast does not check for null when converting a strong actor
+  //       pointer to an abstract_actor pointer.
+  if (!x.sender)
+    return false;
+  auto* sender = actor_cast<abstract_actor*>(x.sender);
+  return sender->getf(abstract_actor::is_blocking_flag);
+}
+
+/// Checks whether `x` is a response or a system message. The mailbox never
+/// rejects or drops these messages, because the receiver may otherwise wait
+/// forever for a response or miss an exit or down message.
+bool bypasses_capacity(const mailbox_element& x) {
+  if (x.mid.is_response() || x.mid.is_urgent_message())
+    return true;
+  auto& content = x.content();
+  return content.match_elements<exit_msg>()
+         || content.match_elements<down_msg>()
+         || content.match_elements<node_down_msg>();
+}
+
+} // namespace
+
+bounded_mailbox::bounded_mailbox(size_t capacity,
+                                 mailbox_policy policy) noexcept
+  : capacity_(capacity > 0 ? capacity : 1), policy_(policy), ref_count_(1) {
+  // nop
+}
+
+intrusive::inbox_result bounded_mailbox::push_back(mailbox_element_ptr ptr) {
+  // Note: declared before the guard to destroy the element after releasing
+  //       the lock, since this may release the last reference to an actor.
+  mailbox_element_ptr dropped;
+  std::unique_lock guard{mtx_};
+  if (closed_)
+    return intrusive::inbox_result::queue_closed;
+  if (cached() >= capacity_ && !bypasses_capacity(*ptr)) {
+    switch (policy_) {
+      case mailbox_policy::drop_oldest:
+        // Urgent messages, responses and system messages bypass the capacity
+        // and thus are never dropped.
+        if (dropped = drop_oldest(); dropped != nullptr) {
+          if (size_gauge_)
+            size_gauge_->dec();
+          break;
+        }
+        // Reject the new message if the mailbox has no message to drop.
+        guard.unlock();
+        sync_request_bouncer{make_error(sec::mailbox_full)}(*ptr);
+        return intrusive::inbox_result::queue_full;
+      case mailbox_policy::drop_newest:
+        // Discard the new message without reporting an error to the sender.
+        if (size_gauge_)
+          size_gauge_->dec();
+        guard.unlock();
+        sync_request_bouncer{make_error(sec::mailbox_full)}(*ptr);
+        return intrusive::inbox_result::success;
+      case mailbox_policy::block:
+        if (has_blocking_sender(*ptr)) {
+          not_full_.wait(guard,
+                         [this] { return closed_ || cached() < capacity_; });
+          if (closed_)
+            return intrusive::inbox_result::queue_closed;
+          break;
+        }
+        [[fallthrough]];
+      default: // mailbox_policy::reject
+        guard.unlock();
+        sync_request_bouncer{make_error(sec::mailbox_full)}(*ptr);
+        return intrusive::inbox_result::queue_full;
+    }
+  }
+  if (ptr->mid.is_urgent_message())
+    urgent_queue_.push_back(ptr.release());
+  else
+    normal_queue_.push_back(ptr.release());
+  report_fill_level();
+  auto result = intrusive::inbox_result::success;
+  if (blocked_) {
+    blocked_ = false;
+    result = intrusive::inbox_result::unblocked_reader;
+  }
+  if (dropped) {
+    guard.unlock();
+    sync_request_bouncer{make_error(sec::mailbox_full)}(*dropped);
+  }
+  return result;
+}
+
+mailbox_element_ptr bounded_mailbox::drop_oldest() {
+  auto pos = normal_queue_.before_begin();
+  for (auto i = normal_queue_.begin(); i != normal_queue_.end(); pos = i++)
+    if (!bypasses_capacity(*i))
+      return normal_queue_.take_after(pos);
+  return nullptr;
+}
+
+void bounded_mailbox::push_front(mailbox_element_ptr ptr) {
+  std::lock_guard guard{mtx_};
+  if (ptr->mid.is_urgent_message())
+    urgent_queue_.push_front(ptr.release());
+  else
+    normal_queue_.push_front(ptr.release());
+  report_fill_level();
+}
+
+mailbox_element* bounded_mailbox::peek(message_id id) {
+  std::lock_guard guard{mtx_};
+  if (closed_ || blocked_)
+    return nullptr;
+  if (id.is_async()) {
+    if (!urgent_queue_.empty())
+      return urgent_queue_.front();
+    if (!normal_queue_.empty())
+      return normal_queue_.front();
+    return nullptr;
+  }
+  auto pred = [id](mailbox_element& x) { return x.mid == id; };
+  if (auto result = urgent_queue_.find_if(pred))
+    return result;
+  return normal_queue_.find_if(pred);
+}
+
+mailbox_element_ptr bounded_mailbox::pop_front() {
+  mailbox_element_ptr result;
+  {
+    std::lock_guard guard{mtx_};
+    result = urgent_queue_.pop_front();
+    if (!result)
+      result = normal_queue_.pop_front();
+    if (!result)
+      return nullptr;
+    report_fill_level();
+  }
+  if (policy_ == mailbox_policy::block)
+    not_full_.notify_one();
+  return result;
+}
+
+bool bounded_mailbox::closed() const noexcept {
+  std::lock_guard guard{mtx_};
+  return closed_;
+}
+
+bool bounded_mailbox::blocked() const noexcept {
+  std::lock_guard guard{mtx_};
+  return blocked_;
+}
+
+bool bounded_mailbox::try_block() {
+  std::lock_guard guard{mtx_};
+  if (closed_ || blocked_ || cached() > 0)
+    return false;
+  blocked_ = true;
+  return true;
+}
+
+bool bounded_mailbox::try_unblock() {
+  std::lock_guard guard{mtx_};
+  if (!blocked_)
+    return false;
+  blocked_ = false;
+  return true;
+}
+
+size_t bounded_mailbox::close(const error& reason) {
+  intrusive::linked_list<mailbox_element> urgent;
+  intrusive::linked_list<mailbox_element> normal;
+  {
+    std::lock_guard guard{mtx_};
+    closed_ = true;
+    blocked_ = false;
+    urgent = std::move(urgent_queue_);
+    normal = std::move(normal_queue_);
+    report_fill_level();
+  }
+  not_full_.notify_all();
+  size_t result = 0;
+  detail::sync_request_bouncer bounce{reason};
+  auto bounce_and_count = [&bounce, &result](mailbox_element* ptr) {
+    bounce(*ptr);
+    delete ptr;
+    ++result;
+  };
+  urgent.drain(bounce_and_count);
+  normal.drain(bounce_and_count);
+  return result;
+}
+
+size_t bounded_mailbox::size() {
+  std::lock_guard guard{mtx_};
+  return cached();
+}
+
+size_t bounded_mailbox::capacity() const noexcept {
+  return capacity_;
+}
+
+void bounded_mailbox::setup_metrics(telemetry::int_gauge* size,
+                                    telemetry::dbl_gauge* fill_level) noexcept {
+  std::lock_guard guard{mtx_};
+  size_gauge_ = size;
+  fill_level_gauge_ = fill_level;
+  report_fill_level();
+}
+
+void bounded_mailbox::report_fill_level() {
+  if (fill_level_gauge_) {
+    auto fill_level = static_cast<double>(cached())
+                      / static_cast<double>(capacity_);
+    fill_level_gauge_->value(fill_level);
+  }
+}
+
+void bounded_mailbox::ref_mailbox() noexcept {
+  ++ref_count_;
+}
+
+void bounded_mailbox::deref_mailbox() noexcept {
+  if (--ref_count_ == 0)
+    delete this;
+}
+
+} // namespace caf::detail
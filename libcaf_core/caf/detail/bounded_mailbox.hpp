@@ -0,0 +1,116 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/abstract_mailbox.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/intrusive/linked_list.hpp"
+#include "caf/mailbox_policy.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace caf::detail {
+
+/// A mailbox that stores at most `capacity` messages. Once full, the mailbox
+/// applies its policy to new messages. Urgent messages, responses and system
+/// messages such as `exit_msg` bypass the capacity. Unlike the `default_mailbox`, this
+/// implementation protects its queues with a mutex, because dropping the
+/// oldest message and blocking senders both require writers to inspect the
+/// state of the reader.
+class CAF_CORE_EXPORT bounded_mailbox : public abstract_mailbox {
+public:
+  bounded_mailbox(size_t capacity, mailbox_policy policy) noexcept;
+
+  bounded_mailbox(const bounded_mailbox&) = delete;
+
+  bounded_mailbox& operator=(const bounded_mailbox&) = delete;
+
+  mailbox_element* peek(message_id id) override;
+
+  intrusive::inbox_result push_back(mailbox_element_ptr ptr) override;
+
+  void push_front(mailbox_element_ptr ptr) override;
+
+  mailbox_element_ptr pop_front() override;
+
+  bool closed() const noexcept override;
+
+  bool blocked() const noexcept override;
+
+  bool try_block() override;
+
+  bool try_unblock() override;
+
+  size_t close(const error&) override;
+
+  size_t size() override;
+
+  size_t capacity() const noexcept override;
+
+  void setup_metrics(telemetry::int_gauge* size,
+                     telemetry::dbl_gauge* fill_level) noexcept override;
+
+  void ref_mailbox() noexcept override;
+
+  void deref_mailbox() noexcept override;
+
+  mailbox_policy policy() const noexcept {
+    return policy_;
+  }
+
+private:
+  /// Returns the total number of elements stored in the queues. Requires that
+  /// the caller holds `mtx_`.
+  size_t cached() const noexcept {
+    return urgent_queue_.size() + normal_queue_.size();
+  }
+
+  /// Removes the oldest message that counts against the capacity from the
+  /// normal queue. Requires that the caller holds `mtx_`.
+  /// @returns the removed message or `nullptr` if no such message exists.
+  mailbox_element_ptr drop_oldest();
+
+  /// Reports the current fill level to the gauge if present. Requires that the
+  /// caller holds `mtx_`.
+  void report_fill_level();
+
+  /// The maximum number of messages in the mailbox.
+  size_t capacity_;
+
+  /// Configures how to handle new messages after reaching the capacity.
+  mailbox_policy policy_;
+
+  /// Protects all members below.
+  mutable std::mutex mtx_;
+
+  /// Allows blocking senders to wait until the mailbox has room again.
+  std::condition_variable not_full_;
+
+  /// Stores urgent messages in FIFO order.
+  intrusive::linked_list<mailbox_element> urgent_queue_;
+
+  /// Stores normal messages in FIFO order.
+  intrusive::linked_list<mailbox_element> normal_queue_;
+
+  /// Signals that the owner waits for new messages.
+  bool blocked_ = false;
+
+  /// Signals that the mailbox no longer accepts new messages.
+  bool closed_ = false;
+
+  /// Counts pending messages of the owner.
+  telemetry::int_gauge* size_gauge_ = nullptr;
+
+  /// Reports the fill level of this mailbox.
+  telemetry::dbl_gauge* fill_level_gauge_ = nullptr;
+
+  /// The reference count of this mailbox.
+  std::atomic<size_t> ref_count_;
+};
+
+} // namespace caf::detail
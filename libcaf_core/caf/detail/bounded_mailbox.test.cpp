@@ -0,0 +1,240 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/bounded_mailbox.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/sec.hpp"
+#include "caf/system_messages.hpp"
+
+#include <thread>
+
+using namespace caf;
+
+namespace {
+
+using ires = intrusive::inbox_result;
+
+template <message_priority P = message_priority::normal>
+auto make_int_msg(int value) {
+  return make_mailbox_element(nullptr, make_message_id(P), make_message(value));
+}
+
+std::vector<int> drain(detail::bounded_mailbox& uut) {
+  std::vector<int> result;
+  for (auto ptr = uut.pop_front(); ptr != nullptr; ptr = uut.pop_front())
+    result.emplace_back(ptr->content().get_as<int>(0));
+  return result;
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+
+  // Creates a request from `self`.
+  mailbox_element_ptr make_request(int value) {
+    return make_mailbox_element(actor_cast<strong_actor_ptr>(self),
+                                self->new_request_id(message_priority::normal),
+                                make_message(value));
+  }
+
+  // Checks that `self` received an error response with `sec::mailbox_full`.
+  void expect_mailbox_full() {
+    auto& rt = test::runnable::current();
+    auto response = self->mailbox().pop_front();
+    rt.require_ne(response, nullptr);
+    rt.check(response->mid.is_response());
+    if (rt.check(response->content().match_elements<error>()))
+      rt.check_eq(response->content().get_as<error>(0),
+                  make_error(sec::mailbox_full));
+  }
+};
+
+TEST("a new mailbox is empty") {
+  detail::bounded_mailbox uut{2, mailbox_policy::reject};
+  check(!uut.closed());
+  check(!uut.blocked());
+  check_eq(uut.capacity(), 2u);
+  check_eq(uut.size(), 0u);
+  check_eq(uut.pop_front(), nullptr);
+  check(uut.try_block());
+  check(!uut.try_block());
+}
+
+TEST("the first item unblocks the mailbox") {
+  detail::bounded_mailbox uut{2, mailbox_policy::reject};
+  check(uut.try_block());
+  check_eq(uut.push_back(make_int_msg(1)), ires::unblocked_reader);
+  check_eq(uut.push_back(make_int_msg(2)), ires::success);
+}
+
+TEST("a closed mailbox no longer accepts new messages") {
+  detail::bounded_mailbox uut{2, mailbox_policy::reject};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.close(error{}), 1u);
+  check_eq(uut.push_back(make_int_msg(2)), ires::queue_closed);
+}
+
+TEST("urgent messages are processed first") {
+  detail::bounded_mailbox uut{3, mailbox_policy::reject};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg(2)), ires::success);
+  check_eq(uut.push_back(make_int_msg<message_priority::high>(3)),
+           ires::success);
+  check_eq(drain(uut), std::vector<int>{3, 1, 2});
+}
+
+TEST("the drop_newest policy discards new messages") {
+  detail::bounded_mailbox uut{2, mailbox_policy::drop_newest};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg(2)), ires::success);
+  check_eq(uut.push_back(make_int_msg(3)), ires::success);
+  check_eq(uut.size(), 2u);
+  check_eq(drain(uut), std::vector<int>{1, 2});
+}
+
+TEST("the drop_oldest policy discards pending messages") {
+  detail::bounded_mailbox uut{2, mailbox_policy::drop_oldest};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg(2)), ires::success);
+  check_eq(uut.push_back(make_int_msg(3)), ires::success);
+  check_eq(uut.size(), 2u);
+  check_eq(drain(uut), std::vector<int>{2, 3});
+}
+
+TEST("the block policy rejects messages from non-blocking senders") {
+  detail::bounded_mailbox uut{1, mailbox_policy::block};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  check_eq(uut.push_back(make_int_msg(2)), ires::queue_full);
+  check_eq(drain(uut), std::vector<int>{1});
+}
+
+auto make_response(int value) {
+  auto mid = make_message_id(static_cast<uint64_t>(value)).response_id();
+  return make_mailbox_element(nullptr, mid, make_message(value));
+}
+
+auto make_exit_msg() {
+  return make_mailbox_element(nullptr, make_message_id(),
+                              make_message(exit_msg{actor_addr{}, error{}}));
+}
+
+TEST("responses and system messages bypass the capacity") {
+  for (auto policy : {mailbox_policy::reject, mailbox_policy::drop_newest,
+                      mailbox_policy::drop_oldest, mailbox_policy::block}) {
+    detail::bounded_mailbox uut{1, policy};
+    check_eq(uut.push_back(make_int_msg(1)), ires::success);
+    check_eq(uut.push_back(make_response(2)), ires::success);
+    check_eq(uut.push_back(make_exit_msg()), ires::success);
+    check_eq(uut.push_back(make_int_msg<message_priority::high>(3)),
+             ires::success);
+    check_eq(uut.size(), 4u);
+  }
+}
+
+TEST("the drop_oldest policy never drops responses or system messages") {
+  detail::bounded_mailbox uut{2, mailbox_policy::drop_oldest};
+  check_eq(uut.push_back(make_response(1)), ires::success);
+  SECTION("the mailbox drops the oldest regular message") {
+    check_eq(uut.push_back(make_int_msg(2)), ires::success);
+    check_eq(uut.push_back(make_exit_msg()), ires::success);
+    check_eq(uut.push_back(make_int_msg(3)), ires::success);
+    check_eq(uut.size(), 3u);
+    auto first = uut.pop_front();
+    check_eq(first->content().get_as<int>(0), 1);
+    check(uut.pop_front()->content().match_elements<exit_msg>());
+    check_eq(drain(uut), std::vector<int>{3});
+  }
+  SECTION("the mailbox rejects new messages if it has nothing to drop") {
+    check_eq(uut.push_back(make_exit_msg()), ires::success);
+    check_eq(uut.push_back(make_int_msg(2)), ires::queue_full);
+    check_eq(uut.size(), 2u);
+  }
+}
+
+WITH_FIXTURE(fixture) {
+
+TEST("the reject policy answers requests with sec::mailbox_full") {
+  detail::bounded_mailbox uut{1, mailbox_policy::reject};
+  check_eq(uut.push_back(make_request(1)), ires::success);
+  check_eq(uut.push_back(make_request(2)), ires::queue_full);
+  check_eq(drain(uut), std::vector<int>{1});
+  expect_mailbox_full();
+}
+
+TEST("the drop_newest policy answers dropped requests with sec::mailbox_full") {
+  detail::bounded_mailbox uut{1, mailbox_policy::drop_newest};
+  check_eq(uut.push_back(make_request(1)), ires::success);
+  check_eq(uut.push_back(make_request(2)), ires::success);
+  check_eq(drain(uut), std::vector<int>{1});
+  expect_mailbox_full();
+}
+
+TEST("the drop_oldest policy answers dropped requests with sec::mailbox_full") {
+  detail::bounded_mailbox uut{1, mailbox_policy::drop_oldest};
+  check_eq(uut.push_back(make_request(1)), ires::success);
+  check_eq(uut.push_back(make_request(2)), ires::success);
+  check_eq(drain(uut), std::vector<int>{2});
+  expect_mailbox_full();
+}
+
+TEST("the block policy blocks senders until the mailbox has room") {
+  detail::bounded_mailbox uut{1, mailbox_policy::block};
+  check_eq(uut.push_back(make_request(1)), ires::success);
+  auto request = make_request(2);
+  auto result = ires::queue_closed;
+  std::thread sender{[&uut, &request, &result] {
+    result = uut.push_back(std::move(request));
+  }};
+  check_eq(uut.pop_front()->content().get_as<int>(0), 1);
+  sender.join();
+  check_eq(result, ires::success);
+  check_eq(drain(uut), std::vector<int>{2});
+}
+
+TEST("closing the mailbox releases blocked senders") {
+  detail::bounded_mailbox uut{1, mailbox_policy::block};
+  check_eq(uut.push_back(make_int_msg(1)), ires::success);
+  auto request = make_request(2);
+  auto result = ires::success;
+  std::thread sender{[&uut, &request, &result] {
+    result = uut.push_back(std::move(request));
+  }};
+  uut.close(error{});
+  sender.join();
+  check_eq(result, ires::queue_closed);
+}
+
+} // WITH_FIXTURE(fixture)
+
+TEST("actor systems bound mailboxes of scheduled actors on request") {
+  actor_system_config cfg;
+  put(cfg.content, "caf.mailbox.capacity", 5);
+  put(cfg.content, "caf.mailbox.policy", "drop_oldest");
+  actor_system sys{cfg};
+  auto [self, launch] = sys.spawn_inactive<event_based_actor>();
+  check_eq(self->mailbox().capacity(), 5u);
+  auto* mbox = dynamic_cast<detail::bounded_mailbox*>(&self->mailbox());
+  if (check_ne(mbox, nullptr))
+    check_eq(mbox->policy(), mailbox_policy::drop_oldest);
+  launch();
+}
+
+TEST("hidden actors keep an unbounded mailbox") {
+  actor_system_config cfg;
+  put(cfg.content, "caf.mailbox.capacity", 5);
+  actor_system sys{cfg};
+  auto [self, launch] = sys.spawn_inactive<event_based_actor, hidden>();
+  check_eq(self->mailbox().capacity(), 0u);
+  check_eq(dynamic_cast<detail::bounded_mailbox*>(&self->mailbox()), nullptr);
+  launch();
+}
+
+} // namespace
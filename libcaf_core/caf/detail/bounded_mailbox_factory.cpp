@@ -0,0 +1,27 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/bounded_mailbox_factory.hpp"
+
+#include "caf/detail/bounded_mailbox.hpp"
+#include "caf/scheduled_actor.hpp"
+
+namespace caf::detail {
+
+bounded_mailbox_factory::~bounded_mailbox_factory() {
+  // nop
+}
+
+abstract_mailbox* bounded_mailbox_factory::make(scheduled_actor* owner) {
+  // Hidden actors are part of CAF itself and must keep up with the system.
+  if (owner->getf(abstract_actor::is_hidden_flag))
+    return nullptr;
+  return new bounded_mailbox(capacity_, policy_);
+}
+
+abstract_mailbox* bounded_mailbox_factory::make(blocking_actor*) {
+  return nullptr;
+}
+
+} // namespace caf::detail
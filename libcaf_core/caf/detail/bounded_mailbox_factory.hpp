@@ -0,0 +1,44 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/detail/mailbox_factory.hpp"
+#include "caf/mailbox_policy.hpp"
+
+#include <cstddef>
+
+namespace caf::detail {
+
+/// Creates a `bounded_mailbox` for each scheduled actor that is not hidden.
+/// Hidden actors, i.e., actors of CAF itself, and blocking actors keep their
+/// default mailbox.
+class CAF_CORE_EXPORT bounded_mailbox_factory : public mailbox_factory {
+public:
+  bounded_mailbox_factory(size_t capacity, mailbox_policy policy) noexcept
+    : capacity_(capacity), policy_(policy) {
+    // nop
+  }
+
+  ~bounded_mailbox_factory() override;
+
+  abstract_mailbox* make(scheduled_actor* owner) override;
+
+  abstract_mailbox* make(blocking_actor* owner) override;
+
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  mailbox_policy policy() const noexcept {
+    return policy_;
+  }
+
+private:
+  size_t capacity_;
+  mailbox_policy policy_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,120 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace caf::detail {
+
+/// A lock-free, fixed-capacity FIFO queue of pointers for any number of
+/// producers and consumers, based on Dmitry Vyukov's bounded MPMC queue. Each
+/// slot carries a sequence number that tells producers and consumers whether
+/// the slot is ready for them, so neither side ever blocks the other.
+template <class T>
+class bounded_mpmc_queue {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+
+  /// @pre `capacity` is a power of two.
+  explicit bounded_mpmc_queue(size_t capacity)
+    : mask_(capacity - 1),
+      cells_(std::make_unique<cell[]>(capacity)),
+      push_pos_(0),
+      pop_pos_(0) {
+    CAF_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+    for (size_t i = 0; i < capacity; ++i)
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  bounded_mpmc_queue(const bounded_mpmc_queue&) = delete;
+
+  bounded_mpmc_queue& operator=(const bounded_mpmc_queue&) = delete;
+
+  /// Tries to append `value` to the queue.
+  /// @returns `false` if the queue is full, `true` otherwise.
+  bool try_push(pointer value) noexcept {
+    CAF_ASSERT(value != nullptr);
+    auto pos = push_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& slot = cells_[pos & mask_];
+      auto seq = slot.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Tries to remove the oldest element from the queue.
+  /// @returns the removed element or `nullptr` if the queue is empty.
+  pointer try_pop() noexcept {
+    auto pos = pop_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& slot = cells_[pos & mask_];
+      auto seq = slot.seq.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (pop_pos_.compare_exchange_weak(pos, pos + 1,
+                                           std::memory_order_relaxed)) {
+          auto* result = slot.value;
+          slot.seq.store(pos + mask_ + 1, std::memory_order_release);
+          return result;
+        }
+      } else if (diff < 0) {
+        return nullptr;
+      } else {
+        pos = pop_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Returns an approximation of the current number of elements.
+  size_t size() const noexcept {
+    auto pushed = push_pos_.load(std::memory_order_relaxed);
+    auto popped = pop_pos_.load(std::memory_order_relaxed);
+    return pushed > popped ? pushed - popped : 0u;
+  }
+
+  /// Returns whether the queue appeared empty at the time of the call.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// Returns the maximum number of elements in the queue.
+  size_t capacity() const noexcept {
+    return mask_ + 1;
+  }
+
+private:
+  struct cell {
+    std::atomic<size_t> seq;
+    pointer value = nullptr;
+  };
+
+  size_t mask_;
+
+  std::unique_ptr<cell[]> cells_;
+
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> push_pos_;
+
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<size_t> pop_pos_;
+};
+
+} // namespace caf::detail
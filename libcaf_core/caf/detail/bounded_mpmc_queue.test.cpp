@@ -0,0 +1,81 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/bounded_mpmc_queue.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::bounded_mpmc_queue;
+
+namespace {
+
+TEST("a new queue is empty") {
+  bounded_mpmc_queue<int> uut{4};
+  check(uut.empty());
+  check_eq(uut.capacity(), 4u);
+  check_eq(uut.try_pop(), nullptr);
+}
+
+TEST("the queue returns elements in FIFO order") {
+  int xs[] = {1, 2, 3};
+  bounded_mpmc_queue<int> uut{4};
+  for (auto& x : xs)
+    check(uut.try_push(&x));
+  check_eq(uut.size(), 3u);
+  check_eq(uut.try_pop(), &xs[0]);
+  check_eq(uut.try_pop(), &xs[1]);
+  check_eq(uut.try_pop(), &xs[2]);
+  check_eq(uut.try_pop(), nullptr);
+}
+
+TEST("try_push fails when the queue is full") {
+  int xs[] = {1, 2, 3};
+  bounded_mpmc_queue<int> uut{2};
+  check(uut.try_push(&xs[0]));
+  check(uut.try_push(&xs[1]));
+  check(!uut.try_push(&xs[2]));
+  check_eq(uut.try_pop(), &xs[0]);
+  check(uut.try_push(&xs[2]));
+  check_eq(uut.try_pop(), &xs[1]);
+  check_eq(uut.try_pop(), &xs[2]);
+}
+
+TEST("each element is taken exactly once under contention") {
+  constexpr size_t num_items = 10'000;
+  constexpr size_t num_threads = 2;
+  std::vector<int> xs(num_items);
+  std::vector<std::atomic<int>> taken(num_items);
+  bounded_mpmc_queue<int> uut{64};
+  std::atomic<size_t> total = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i] {
+      for (auto j = i; j < num_items; j += num_threads)
+        while (!uut.try_push(&xs[j]))
+          std::this_thread::yield();
+    });
+    threads.emplace_back([&] {
+      while (total.load() < num_items) {
+        if (auto* ptr = uut.try_pop()) {
+          taken[static_cast<size_t>(ptr - xs.data())].fetch_add(1);
+          total.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (auto& hdl : threads)
+    hdl.join();
+  check_eq(total.load(), num_items);
+  check(std::all_of(taken.begin(), taken.end(),
+                    [](const auto& x) { return x.load() == 1; }));
+}
+
+} // namespace
@@ -0,0 +1,178 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace caf::detail {
+
+/// A lock-free, double-ended queue for work-stealing as described by Chase and
+/// Lev in "Dynamic Circular Work-Stealing Deque" (SPAA'05), using the memory
+/// orderings from Lê et al., "Correct and Efficient Work-Stealing for Weak
+/// Memory Models" (PPoPP'13).
+///
+/// Only the owner of the deque may call `push` and `pop`, which operate on the
+/// bottom of the deque in LIFO order. Any thread may call `steal` to take the
+/// oldest element from the top of the deque. The deque never allocates on the
+/// fast path. When running out of space, the owner doubles the capacity and
+/// keeps previous buffers alive until destruction, since thieves may still
+/// read from them.
+template <class T>
+class chase_lev_deque {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+
+  /// The default capacity of a new deque. Must be a power of two.
+  static constexpr size_t default_capacity = 1024;
+
+  explicit chase_lev_deque(size_t initial_capacity = default_capacity)
+    : top_(0), bottom_(0) {
+    CAF_ASSERT(initial_capacity > 0
+               && (initial_capacity & (initial_capacity - 1)) == 0);
+    buffers_.emplace_back(std::make_unique<buffer>(initial_capacity));
+    buf_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  chase_lev_deque(const chase_lev_deque&) = delete;
+
+  chase_lev_deque& operator=(const chase_lev_deque&) = delete;
+
+  // -- for the owner ----------------------------------------------------------
+
+  /// Adds `value` to the bottom of the deque.
+  void push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_acquire);
+    auto* buf = buf_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<int64_t>(buf->capacity()) - 1) {
+      buffers_.emplace_back(buf->grow(t, b));
+      buf = buffers_.back().get();
+      buf_.store(buf, std::memory_order_release);
+    }
+    buf->put(b, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /// Removes the most recently pushed element from the bottom of the deque.
+  /// @returns the removed element or `nullptr` if the deque is empty.
+  pointer pop() {
+    auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    auto* buf = buf_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_relaxed);
+    if (t > b) {
+      // The deque was empty: restore the canonical state.
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto* result = buf->get(b);
+    if (t == b) {
+      // Last element: race against thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed))
+        result = nullptr;
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // -- for others -------------------------------------------------------------
+
+  /// Removes the oldest element from the top of the deque.
+  /// @returns the removed element or `nullptr` if the deque is empty or if
+  ///          another thread took the element first.
+  pointer steal() {
+    auto t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto b = bottom_.load(std::memory_order_acquire);
+    if (t >= b)
+      return nullptr;
+    auto* buf = buf_.load(std::memory_order_acquire);
+    auto* result = buf->get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return nullptr;
+    return result;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns an approximation of the current number of elements.
+  size_t size() const noexcept {
+    auto b = bottom_.load(std::memory_order_relaxed);
+    auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_t>(b - t) : 0u;
+  }
+
+  /// Returns whether the deque appeared empty at the time of the call.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// Returns the capacity of the current buffer.
+  size_t capacity() const noexcept {
+    return buf_.load(std::memory_order_relaxed)->capacity();
+  }
+
+private:
+  class buffer {
+  public:
+    explicit buffer(size_t capacity)
+      : mask_(capacity - 1),
+        items_(std::make_unique<std::atomic<pointer>[]>(capacity)) {
+      // nop
+    }
+
+    size_t capacity() const noexcept {
+      return mask_ + 1;
+    }
+
+    pointer get(int64_t index) const noexcept {
+      return items_[static_cast<size_t>(index) & mask_].load(
+        std::memory_order_relaxed);
+    }
+
+    void put(int64_t index, pointer value) noexcept {
+      items_[static_cast<size_t>(index) & mask_].store(
+        value, std::memory_order_relaxed);
+    }
+
+    std::unique_ptr<buffer> grow(int64_t top, int64_t bottom) const {
+      auto result = std::make_unique<buffer>(capacity() * 2);
+      for (auto i = top; i != bottom; ++i)
+        result->put(i, get(i));
+      return result;
+    }
+
+  private:
+    size_t mask_;
+    std::unique_ptr<std::atomic<pointer>[]> items_;
+  };
+
+  /// Index of the oldest element. Modified by thieves and by the owner when
+  /// taking the last element.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> top_;
+
+  /// Index one past the most recently pushed element. Modified by the owner.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<int64_t> bottom_;
+
+  /// Points to the current buffer.
+  std::atomic<buffer*> buf_;
+
+  /// Stores the current buffer and all of its predecessors.
+  std::vector<std::unique_ptr<buffer>> buffers_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,97 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/chase_lev_deque.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::chase_lev_deque;
+
+namespace {
+
+TEST("a default-constructed deque is empty") {
+  chase_lev_deque<int> uut;
+  check(uut.empty());
+  check_eq(uut.pop(), nullptr);
+  check_eq(uut.steal(), nullptr);
+}
+
+TEST("the owner pops elements in LIFO order") {
+  int xs[] = {1, 2, 3};
+  chase_lev_deque<int> uut;
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.size(), 3u);
+  check_eq(uut.pop(), &xs[2]);
+  check_eq(uut.pop(), &xs[1]);
+  check_eq(uut.pop(), &xs[0]);
+  check_eq(uut.pop(), nullptr);
+}
+
+TEST("thieves steal elements in FIFO order") {
+  int xs[] = {1, 2, 3};
+  chase_lev_deque<int> uut;
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.steal(), &xs[0]);
+  check_eq(uut.steal(), &xs[1]);
+  check_eq(uut.pop(), &xs[2]);
+  check_eq(uut.steal(), nullptr);
+}
+
+TEST("the deque grows when running out of space") {
+  std::vector<int> xs(100);
+  chase_lev_deque<int> uut{4};
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.size(), 100u);
+  check_ge(uut.capacity(), 100u);
+  for (size_t i = 0; i < 50; ++i)
+    check_eq(uut.steal(), &xs[i]);
+  for (size_t i = 100; i > 50; --i)
+    check_eq(uut.pop(), &xs[i - 1]);
+  check(uut.empty());
+}
+
+TEST("each element is taken exactly once under contention") {
+  constexpr size_t num_items = 10'000;
+  constexpr size_t num_thieves = 3;
+  std::vector<int> xs(num_items);
+  std::vector<std::atomic<int>> taken(num_items);
+  chase_lev_deque<int> uut{8};
+  std::atomic<size_t> total = 0;
+  auto mark = [&](int* ptr) {
+    taken[static_cast<size_t>(ptr - xs.data())].fetch_add(1);
+    total.fetch_add(1);
+  };
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i)
+    thieves.emplace_back([&] {
+      while (total.load() < num_items)
+        if (auto* ptr = uut.steal())
+          mark(ptr);
+    });
+  for (size_t i = 0; i < num_items; ++i) {
+    uut.push(&xs[i]);
+    if (i % 3 == 0)
+      if (auto* ptr = uut.pop())
+        mark(ptr);
+  }
+  while (auto* ptr = uut.pop())
+    mark(ptr);
+  for (auto& thief : thieves)
+    thief.join();
+  check_eq(total.load(), num_items);
+  check(std::all_of(taken.begin(), taken.end(),
+                    [](const auto& x) { return x.load() == 1; }));
+}
+
+} // namespace
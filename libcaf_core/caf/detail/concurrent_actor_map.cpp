@@ -0,0 +1,259 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/concurrent_actor_map.hpp"
+
+#include "caf/abstract_actor.hpp"
+
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace caf::detail {
+
+namespace {
+
+/// Marks a slot that never had an entry. Lookups stop at such a slot.
+constexpr actor_id empty_key = invalid_actor_id;
+
+/// Marks a slot with an erased entry. Lookups continue after such a slot. The
+/// map never reuses these slots until rehashing, because a reader may still
+/// see the old key of the slot.
+constexpr actor_id erased_key = std::numeric_limits<actor_id>::max();
+
+/// Returns the counter for lookups of the calling thread.
+size_t this_thread_stripe() noexcept {
+  static std::atomic<size_t> next_stripe = 0;
+  thread_local size_t stripe
+    = next_stripe.fetch_add(1, std::memory_order_relaxed)
+      % concurrent_actor_map::num_stripes;
+  return stripe;
+}
+
+} // namespace
+
+// -- member types -------------------------------------------------------------
+
+struct concurrent_actor_map::table {
+  explicit table(size_t capacity)
+    : mask(capacity - 1),
+      shift(64),
+      slots(std::make_unique<slot[]>(capacity)) {
+    for (auto n = capacity; n > 1; n >>= 1)
+      --shift;
+    for (size_t i = 0; i < capacity; ++i) {
+      slots[i].key.store(empty_key, std::memory_order_relaxed);
+      slots[i].value.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  size_t capacity() const noexcept {
+    return mask + 1;
+  }
+
+  /// Returns the first slot to probe for `key`. Actor IDs are mostly
+  /// sequential, so we scramble them via Fibonacci hashing.
+  size_t index_of(actor_id key) const noexcept {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> shift);
+  }
+
+  size_t mask;
+
+  int shift;
+
+  std::unique_ptr<slot[]> slots;
+};
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+concurrent_actor_map::concurrent_actor_map() {
+  table_ = new table(min_capacity);
+}
+
+concurrent_actor_map::~concurrent_actor_map() {
+  clear();
+  delete table_.load();
+}
+
+// -- properties ---------------------------------------------------------------
+
+size_t concurrent_actor_map::size() const noexcept {
+  std::unique_lock guard{mtx_};
+  return size_;
+}
+
+size_t concurrent_actor_map::capacity() const noexcept {
+  return table_.load()->capacity();
+}
+
+// -- lookups ------------------------------------------------------------------
+
+strong_actor_ptr concurrent_actor_map::get(actor_id key) const noexcept {
+  if (key == empty_key || key == erased_key)
+    return nullptr;
+  auto stripe = this_thread_stripe();
+  auto set = enter_read(stripe);
+  strong_actor_ptr result;
+  // Note: all loads are sequentially consistent to order them with the updates
+  //       to the reader counters. This is free on x86 and cheap on ARM.
+  auto* tbl = table_.load();
+  for (auto i = tbl->index_of(key);; i = (i + 1) & tbl->mask) {
+    auto& x = tbl->slots[i];
+    auto x_key = x.key.load();
+    if (x_key == key) {
+      // The value may be null if a writer has erased the entry in the
+      // meantime. In this case, the map may contain a new entry for the same
+      // key further down the probe sequence.
+      if (auto* ptr = x.value.load()) {
+        result.reset(ptr);
+        break;
+      }
+    } else if (x_key == empty_key) {
+      break;
+    }
+  }
+  leave_read(set, stripe);
+  return result;
+}
+
+// -- modifiers ----------------------------------------------------------------
+
+bool concurrent_actor_map::insert(actor_id key, strong_actor_ptr val) {
+  CAF_ASSERT(key != empty_key && key != erased_key);
+  CAF_ASSERT(val != nullptr);
+  std::unique_ptr<table> retired;
+  {
+    std::unique_lock guard{mtx_};
+    auto* tbl = table_.load();
+    // Check whether the map already contains the key.
+    for (auto i = tbl->index_of(key);; i = (i + 1) & tbl->mask) {
+      auto x_key = tbl->slots[i].key.load(std::memory_order_relaxed);
+      if (x_key == key && tbl->slots[i].value.load() != nullptr)
+        return false;
+      if (x_key == empty_key)
+        break;
+    }
+    // Keep the load factor (including erased slots) at or below 50%. This
+    // guarantees that each probe sequence ends at an empty slot.
+    if ((used_ + 1) * 2 > tbl->capacity()) {
+      auto new_capacity = min_capacity;
+      while (new_capacity < (size_ + 1) * 4)
+        new_capacity <<= 1;
+      retired.reset(rehash(new_capacity));
+      tbl = table_.load();
+    }
+    auto i = tbl->index_of(key);
+    while (tbl->slots[i].key.load(std::memory_order_relaxed) != empty_key)
+      i = (i + 1) & tbl->mask;
+    // Publish the value before the key. Readers that see the key also see the
+    // value.
+    tbl->slots[i].value.store(val.release());
+    tbl->slots[i].key.store(key);
+    ++size_;
+    ++used_;
+  }
+  // Readers may still access the old table.
+  if (retired)
+    synchronize();
+  return true;
+}
+
+strong_actor_ptr concurrent_actor_map::erase(actor_id key) {
+  if (key == empty_key || key == erased_key)
+    return nullptr;
+  actor_control_block* ptr = nullptr;
+  {
+    std::unique_lock guard{mtx_};
+    auto* tbl = table_.load();
+    for (auto i = tbl->index_of(key);; i = (i + 1) & tbl->mask) {
+      auto& x = tbl->slots[i];
+      auto x_key = x.key.load(std::memory_order_relaxed);
+      if (x_key == key) {
+        if (ptr = x.value.exchange(nullptr); ptr != nullptr) {
+          x.key.store(erased_key);
+          --size_;
+          break;
+        }
+      } else if (x_key == empty_key) {
+        return nullptr;
+      }
+    }
+  }
+  // Readers may have loaded the pointer but not yet increased the reference
+  // count. Hence, we must not release our reference before they are done.
+  synchronize();
+  return strong_actor_ptr{ptr, false};
+}
+
+void concurrent_actor_map::clear() {
+  std::vector<strong_actor_ptr> erased;
+  std::unique_ptr<table> retired;
+  {
+    std::unique_lock guard{mtx_};
+    if (size_ == 0 && used_ == 0)
+      return;
+    auto* tbl = table_.load();
+    erased.reserve(size_);
+    for (size_t i = 0; i < tbl->capacity(); ++i)
+      if (auto* ptr = tbl->slots[i].value.load(std::memory_order_relaxed))
+        erased.emplace_back(ptr, false);
+    retired.reset(tbl);
+    table_ = new table(min_capacity);
+    size_ = 0;
+    used_ = 0;
+  }
+  synchronize();
+}
+
+// -- utility functions --------------------------------------------------------
+
+size_t concurrent_actor_map::enter_read(size_t stripe) const noexcept {
+  // If a writer switches the set right after we have read the epoch, it may
+  // miss our increment. This is safe: in this case, our lookup happens after
+  // the writer has removed the entry.
+  auto set = epoch_.load() & 1;
+  readers_[set][stripe].value.fetch_add(1);
+  return set;
+}
+
+void concurrent_actor_map::leave_read(size_t set,
+                                      size_t stripe) const noexcept {
+  readers_[set][stripe].value.fetch_sub(1, std::memory_order_release);
+}
+
+void concurrent_actor_map::synchronize() const noexcept {
+  // Switching the set twice makes sure that we wait for lookups in both sets.
+  // Lookups that begin after the switch increment the counters of the other
+  // set and thus cannot keep us waiting forever.
+  std::unique_lock guard{sync_mtx_};
+  for (int round = 0; round < 2; ++round) {
+    auto set = epoch_.fetch_add(1) & 1;
+    for (auto& counter : readers_[set])
+      while (counter.value.load() != 0)
+        std::this_thread::yield();
+  }
+}
+
+concurrent_actor_map::table* concurrent_actor_map::rehash(size_t capacity) {
+  auto* old_tbl = table_.load();
+  auto new_tbl = std::make_unique<table>(capacity);
+  for (size_t i = 0; i < old_tbl->capacity(); ++i) {
+    auto& x = old_tbl->slots[i];
+    auto* ptr = x.value.load(std::memory_order_relaxed);
+    if (ptr == nullptr)
+      continue;
+    auto key = x.key.load(std::memory_order_relaxed);
+    auto j = new_tbl->index_of(key);
+    while (new_tbl->slots[j].key.load(std::memory_order_relaxed) != empty_key)
+      j = (j + 1) & new_tbl->mask;
+    new_tbl->slots[j].value.store(ptr, std::memory_order_relaxed);
+    new_tbl->slots[j].key.store(key, std::memory_order_relaxed);
+  }
+  used_ = size_;
+  table_ = new_tbl.release();
+  return old_tbl;
+}
+
+} // namespace caf::detail
@@ -0,0 +1,140 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/actor_control_block.hpp"
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace caf::detail {
+
+/// Maps actor IDs to actors. Lookups never block and never write to memory
+/// that other readers write to, except for a reader counter that each thread
+/// usually has for itself. Hence, lookups scale with the number of reading
+/// threads. Writers synchronize via a mutex.
+///
+/// The map stores its entries in an open-addressing hash table with linear
+/// probing. Before releasing an erased actor or a replaced table, writers wait
+/// for a grace period: all lookups that were in progress at the time of the
+/// removal must finish first. Readers announce lookups in one of two sets of
+/// counters and writers switch between the two sets, similar to sleepable
+/// RCU. Hence, writers never wait for lookups that begin after the removal.
+class CAF_CORE_EXPORT concurrent_actor_map {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Number of reader counters per set. Threads pick their counter in
+  /// round-robin order when performing their first lookup.
+  static constexpr size_t num_stripes = 32;
+
+  /// Minimum number of slots in the hash table.
+  static constexpr size_t min_capacity = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  concurrent_actor_map();
+
+  concurrent_actor_map(const concurrent_actor_map&) = delete;
+
+  concurrent_actor_map& operator=(const concurrent_actor_map&) = delete;
+
+  ~concurrent_actor_map();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of entries in the map.
+  size_t size() const noexcept;
+
+  /// Returns the number of slots in the hash table.
+  size_t capacity() const noexcept;
+
+  // -- lookups ----------------------------------------------------------------
+
+  /// Returns the actor associated to `key` or `nullptr`.
+  /// @threadsafe
+  strong_actor_ptr get(actor_id key) const noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Associates `key` with `val` unless the map already contains `key`.
+  /// @returns `true` if the map stores `val`, `false` otherwise.
+  /// @threadsafe
+  bool insert(actor_id key, strong_actor_ptr val);
+
+  /// Removes the entry for `key` from the map.
+  /// @returns the removed actor or `nullptr`. The caller releases the last
+  ///          reference of the map to the actor.
+  /// @threadsafe
+  strong_actor_ptr erase(actor_id key);
+
+  /// Removes all entries from the map.
+  /// @threadsafe
+  void clear();
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  struct slot {
+    std::atomic<actor_id> key;
+    std::atomic<actor_control_block*> value;
+  };
+
+  struct table;
+
+  struct alignas(CAF_CACHE_LINE_SIZE) reader_counter {
+    std::atomic<size_t> value = 0;
+  };
+
+  using reader_counters = std::array<reader_counter, num_stripes>;
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Announces a new lookup and returns the index of the counter set.
+  size_t enter_read(size_t stripe) const noexcept;
+
+  /// Marks the end of a lookup.
+  void leave_read(size_t set, size_t stripe) const noexcept;
+
+  /// Blocks until all lookups that began before calling this function have
+  /// finished.
+  void synchronize() const noexcept;
+
+  /// Creates a new table with `capacity` slots and moves all entries of the
+  /// current table to it. Returns the old table.
+  /// @pre `mtx_` is locked.
+  table* rehash(size_t capacity);
+
+  // -- member variables -------------------------------------------------------
+
+  /// Points to the current hash table.
+  std::atomic<table*> table_;
+
+  /// Selects the counter set for new lookups.
+  mutable std::atomic<size_t> epoch_ = 0;
+
+  /// Counts active lookups per set and stripe.
+  mutable std::array<reader_counters, 2> readers_;
+
+  /// Serializes all writers.
+  mutable std::mutex mtx_;
+
+  /// Serializes grace periods.
+  mutable std::mutex sync_mtx_;
+
+  /// Number of entries in the table.
+  size_t size_ = 0;
+
+  /// Number of slots that are either in use or marked as erased.
+  size_t used_ = 0;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,133 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/concurrent_actor_map.hpp"
+
+#include "caf/test/fixture/deterministic.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/actor_cast.hpp"
+#include "caf/event_based_actor.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+behavior dummy() {
+  return {[](int i) { return i; }};
+}
+
+struct fixture : test::fixture::deterministic {
+  std::vector<strong_actor_ptr> spawn_dummies(size_t n) {
+    std::vector<strong_actor_ptr> result;
+    for (size_t i = 0; i < n; ++i)
+      result.emplace_back(actor_cast<strong_actor_ptr>(sys.spawn(dummy)));
+    return result;
+  }
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("a new map is empty") {
+  detail::concurrent_actor_map uut;
+  check_eq(uut.size(), 0u);
+  check_eq(uut.capacity(), detail::concurrent_actor_map::min_capacity);
+  check_eq(uut.get(42), nullptr);
+  check_eq(uut.erase(42), nullptr);
+}
+
+TEST("the map stores actors by their ID") {
+  detail::concurrent_actor_map uut;
+  auto actors = spawn_dummies(2);
+  auto& a1 = actors[0];
+  auto& a2 = actors[1];
+  check(uut.insert(a1->id(), a1));
+  check(uut.insert(a2->id(), a2));
+  check_eq(uut.size(), 2u);
+  check_eq(uut.get(a1->id()), a1);
+  check_eq(uut.get(a2->id()), a2);
+  SECTION("inserting an existing key has no effect") {
+    check(!uut.insert(a1->id(), a2));
+    check_eq(uut.get(a1->id()), a1);
+  }
+  SECTION("erasing a key returns the actor") {
+    check_eq(uut.erase(a1->id()), a1);
+    check_eq(uut.size(), 1u);
+    check_eq(uut.get(a1->id()), nullptr);
+    check_eq(uut.get(a2->id()), a2);
+    check_eq(uut.erase(a1->id()), nullptr);
+  }
+  SECTION("keys are available again after erasing them") {
+    uut.erase(a1->id());
+    check(uut.insert(a1->id(), a1));
+    check_eq(uut.get(a1->id()), a1);
+  }
+  SECTION("clearing the map releases all actors") {
+    uut.clear();
+    check_eq(uut.size(), 0u);
+    check_eq(uut.get(a1->id()), nullptr);
+    check_eq(uut.get(a2->id()), nullptr);
+    check_eq(a1->strong_refs.load(), 1u);
+  }
+}
+
+TEST("the map grows when adding more actors") {
+  detail::concurrent_actor_map uut;
+  auto actors = spawn_dummies(100);
+  for (auto& hdl : actors)
+    check(uut.insert(hdl->id(), hdl));
+  check_eq(uut.size(), 100u);
+  check_ge(uut.capacity(), 200u);
+  for (auto& hdl : actors)
+    check_eq(uut.get(hdl->id()), hdl);
+  for (size_t i = 0; i < actors.size(); i += 2)
+    uut.erase(actors[i]->id());
+  check_eq(uut.size(), 50u);
+  for (size_t i = 0; i < actors.size(); ++i) {
+    if (i % 2 == 0)
+      check_eq(uut.get(actors[i]->id()), nullptr);
+    else
+      check_eq(uut.get(actors[i]->id()), actors[i]);
+  }
+}
+
+TEST("readers always see a consistent state while writers modify the map") {
+  detail::concurrent_actor_map uut;
+  auto actors = spawn_dummies(64);
+  std::atomic<bool> done = false;
+  std::atomic<size_t> errors = 0;
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&] {
+      while (!done) {
+        for (auto& hdl : actors) {
+          auto ptr = uut.get(hdl->id());
+          if (ptr != nullptr && ptr != hdl)
+            ++errors;
+        }
+      }
+    });
+  }
+  for (int round = 0; round < 100; ++round) {
+    for (auto& hdl : actors)
+      uut.insert(hdl->id(), hdl);
+    for (auto& hdl : actors)
+      uut.erase(hdl->id());
+  }
+  done = true;
+  for (auto& reader : readers)
+    reader.join();
+  check_eq(errors.load(), 0u);
+  check_eq(uut.size(), 0u);
+  for (auto& hdl : actors)
+    check_eq(hdl->strong_refs.load(), 1u);
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
@@ -0,0 +1,161 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/config.hpp"
+
+#ifdef CAF_LINUX
+#  include <pthread.h>
+#  include <sched.h>
+#endif // CAF_LINUX
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <thread>
+
+namespace caf::detail {
+
+namespace {
+
+constexpr std::string_view default_sysfs_path = "/sys/devices/system/node";
+
+std::optional<size_t> parse_cpu_id(std::string_view str) {
+  size_t result = 0;
+  auto last = str.data() + str.size();
+  auto [ptr, ec] = std::from_chars(str.data(), last, result);
+  if (ec != std::errc{} || ptr != last)
+    return std::nullopt;
+  return result;
+}
+
+std::string_view trim(std::string_view str) {
+  auto is_space = [](char c) { return c == ' ' || c == '\n' || c == '\t'; };
+  while (!str.empty() && is_space(str.front()))
+    str.remove_prefix(1);
+  while (!str.empty() && is_space(str.back()))
+    str.remove_suffix(1);
+  return str;
+}
+
+std::optional<std::vector<size_t>> read_list(const std::string& path) {
+  std::ifstream in{path};
+  std::string line;
+  if (!in || !std::getline(in, line))
+    return std::nullopt;
+  return parse_cpu_list(line);
+}
+
+} // namespace
+
+size_t cpu_topology::num_cpus() const noexcept {
+  size_t result = 0;
+  for (auto& node : nodes)
+    result += node.size();
+  return result;
+}
+
+void cpu_topology::restrict_to(const std::vector<size_t>& allowed) {
+  auto is_allowed = [&allowed](size_t cpu) {
+    return std::binary_search(allowed.begin(), allowed.end(), cpu);
+  };
+  auto result = nodes;
+  size_t remaining = 0;
+  for (auto& node : result) {
+    node.erase(std::remove_if(node.begin(), node.end(),
+                              [&](size_t cpu) { return !is_allowed(cpu); }),
+               node.end());
+    remaining += node.size();
+  }
+  if (remaining > 0)
+    nodes = std::move(result);
+}
+
+cpu_topology cpu_topology::read(std::string_view sysfs_path) {
+  cpu_topology result;
+  // The file `online` lists the IDs of all available nodes in the same format
+  // as the CPU lists. Node IDs may have gaps.
+  std::string path{sysfs_path};
+  if (auto node_ids = read_list(path + "/online")) {
+    for (auto id : *node_ids) {
+      auto cpus = read_list(path + "/node" + std::to_string(id) + "/cpulist");
+      if (cpus && !cpus->empty())
+        result.nodes.emplace_back(std::move(*cpus));
+    }
+  }
+  if (result.nodes.empty()) {
+    auto num = std::max(std::thread::hardware_concurrency(), 1u);
+    auto& cpus = result.nodes.emplace_back();
+    for (size_t cpu = 0; cpu < num; ++cpu)
+      cpus.push_back(cpu);
+  }
+  return result;
+}
+
+cpu_topology cpu_topology::read() {
+  return read(default_sysfs_path);
+}
+
+std::optional<std::vector<size_t>> parse_cpu_list(std::string_view str) {
+  std::vector<size_t> result;
+  str = trim(str);
+  while (!str.empty()) {
+    auto sep = str.find(',');
+    auto range = str.substr(0, sep);
+    str = sep == std::string_view::npos ? std::string_view{}
+                                        : str.substr(sep + 1);
+    auto dash = range.find('-');
+    if (dash == std::string_view::npos) {
+      auto cpu = parse_cpu_id(range);
+      if (!cpu)
+        return std::nullopt;
+      result.push_back(*cpu);
+      continue;
+    }
+    auto first = parse_cpu_id(range.substr(0, dash));
+    auto last = parse_cpu_id(range.substr(dash + 1));
+    if (!first || !last || *first > *last)
+      return std::nullopt;
+    for (auto cpu = *first; cpu <= *last; ++cpu)
+      result.push_back(cpu);
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::optional<std::vector<size_t>> thread_affinity() {
+#ifdef CAF_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    return std::nullopt;
+  std::vector<size_t> result;
+  for (size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &set))
+      result.push_back(cpu);
+  return result;
+#else
+  return std::nullopt;
+#endif // CAF_LINUX
+}
+
+bool set_thread_affinity(const std::vector<size_t>& cpus) {
+#ifdef CAF_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : cpus)
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &set);
+  if (CPU_COUNT(&set) == 0)
+    return false;
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  CAF_IGNORE_UNUSED(cpus);
+  return false;
+#endif // CAF_LINUX
+}
+
+} // namespace caf::detail
@@ -0,0 +1,54 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace caf::detail {
+
+/// Describes the CPUs of a machine, grouped by NUMA node.
+struct CAF_CORE_EXPORT cpu_topology {
+  /// Lists the CPU IDs for each NUMA node.
+  std::vector<std::vector<size_t>> nodes;
+
+  /// Returns the total number of CPUs.
+  size_t num_cpus() const noexcept;
+
+  /// Removes all CPUs that are not in `allowed`. Keeps empty nodes to preserve
+  /// the node IDs. Leaves the topology unchanged if no CPU would remain.
+  void restrict_to(const std::vector<size_t>& allowed);
+
+  /// Reads the topology from `sysfs_path`, e.g., `/sys/devices/system/node`.
+  /// Falls back to a single node with `std::thread::hardware_concurrency()`
+  /// CPUs if the directory does not exist or contains no node.
+  static cpu_topology read(std::string_view sysfs_path);
+
+  /// Reads the topology of this machine.
+  static cpu_topology read();
+};
+
+/// Parses a CPU list in the Linux sysfs format, e.g., `0-3,8,10-11`.
+/// @returns the CPU IDs in ascending order or `std::nullopt` on a parser error.
+CAF_CORE_EXPORT std::optional<std::vector<size_t>>
+parse_cpu_list(std::string_view str);
+
+/// Returns the CPUs that the calling thread may run on in ascending order. On
+/// Linux, this set also reflects the cpuset of the cgroup of the process.
+/// @returns the CPU IDs or `std::nullopt` if the platform does not support
+///          thread affinity.
+CAF_CORE_EXPORT std::optional<std::vector<size_t>> thread_affinity();
+
+/// Restricts the calling thread to the given CPUs.
+/// @returns `true` on success, `false` if the platform does not support thread
+///          affinity or if the operating system rejected the CPU set.
+CAF_CORE_EXPORT bool set_thread_affinity(const std::vector<size_t>& cpus);
+
+} // namespace caf::detail
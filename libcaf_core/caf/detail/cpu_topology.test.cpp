@@ -0,0 +1,75 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/cpu_topology.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+
+using namespace caf;
+
+using detail::parse_cpu_list;
+
+using cpu_list = std::vector<size_t>;
+
+namespace {
+
+TEST("parse_cpu_list accepts single IDs and ranges") {
+  check_eq(parse_cpu_list("0"), cpu_list{0});
+  check_eq(parse_cpu_list("0-3"), cpu_list({0, 1, 2, 3}));
+  check_eq(parse_cpu_list("0-1,4,6-7\n"), cpu_list({0, 1, 4, 6, 7}));
+  check_eq(parse_cpu_list("3,1,1"), cpu_list({1, 3}));
+  check_eq(parse_cpu_list(""), cpu_list{});
+}
+
+TEST("parse_cpu_list rejects malformed input") {
+  check_eq(parse_cpu_list("a"), std::nullopt);
+  check_eq(parse_cpu_list("3-1"), std::nullopt);
+  check_eq(parse_cpu_list("1-"), std::nullopt);
+  check_eq(parse_cpu_list("1,,2"), std::nullopt);
+}
+
+TEST("reading the topology from a missing directory yields a single node") {
+  auto topo = detail::cpu_topology::read("/does/not/exist");
+  check_eq(topo.nodes.size(), 1u);
+  check_ge(topo.num_cpus(), 1u);
+}
+
+TEST("restricting a topology removes CPUs that are not allowed") {
+  detail::cpu_topology topo;
+  topo.nodes = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+  SECTION("each node keeps its allowed CPUs") {
+    topo.restrict_to({2, 3, 5});
+    check_eq(topo.nodes[0], cpu_list({2, 3}));
+    check_eq(topo.nodes[1], cpu_list{5});
+  }
+  SECTION("nodes without allowed CPUs keep their position") {
+    topo.restrict_to({4, 6});
+    check_eq(topo.nodes.size(), 2u);
+    check_eq(topo.nodes[0], cpu_list{});
+    check_eq(topo.nodes[1], cpu_list({4, 6}));
+  }
+  SECTION("the topology remains unchanged if no CPU is allowed") {
+    topo.restrict_to({8, 9});
+    check_eq(topo.num_cpus(), 8u);
+  }
+}
+
+TEST("the thread affinity contains the CPUs the thread may run on") {
+  auto cpus = detail::thread_affinity();
+  if (!cpus) {
+    // Thread affinity is not available on this platform.
+    return;
+  }
+  check(!cpus->empty());
+  check(std::is_sorted(cpus->begin(), cpus->end()));
+  auto topo = detail::cpu_topology::read();
+  topo.restrict_to(*cpus);
+  for (auto& node : topo.nodes)
+    for (auto cpu : node)
+      check(std::binary_search(cpus->begin(), cpus->end(), cpu));
+}
+
+} // namespace
@@ -6,6 +6,7 @@
 
 #include "caf/config.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <condition_variable>
@@ -101,6 +102,27 @@ public:
     return nullptr;
   }
 
+  /// Takes up to half of the queued jobs (but at most `max_count`) from the
+  /// tail under a single lock and stores them to `buf`, oldest job first.
+  /// @returns the number of stored jobs.
+  size_t try_take_tail_half(pointer* buf, size_t max_count) {
+    std::unique_lock guard{mtx_};
+    auto count = std::min((items_.size() + 1) / 2, max_count);
+    for (size_t i = 0; i < count; ++i) {
+      buf[i] = items_.back();
+      items_.pop_back();
+    }
+    return count;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of queued jobs.
+  size_t size() {
+    std::unique_lock guard{mtx_};
+    return items_.size();
+  }
+
 private:
   std::mutex mtx_;
   std::condition_variable cv_;
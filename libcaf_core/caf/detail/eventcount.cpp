@@ -0,0 +1,61 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/eventcount.hpp"
+
+namespace caf::detail {
+
+namespace {
+
+using guard_type = std::unique_lock<std::mutex>;
+
+} // namespace
+
+void eventcount::wait(key_type key) {
+  auto epoch = [this] {
+    return static_cast<key_type>(state_.load(std::memory_order_acquire)
+                                 >> epoch_shift);
+  };
+  {
+    guard_type guard{mtx_};
+    while (epoch() == key)
+      cv_.wait(guard);
+  }
+  state_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool eventcount::wait_until(key_type key,
+                            std::chrono::steady_clock::time_point deadline) {
+  auto epoch = [this] {
+    return static_cast<key_type>(state_.load(std::memory_order_acquire)
+                                 >> epoch_shift);
+  };
+  auto notified = true;
+  {
+    guard_type guard{mtx_};
+    while (epoch() == key) {
+      if (cv_.wait_until(guard, deadline) == std::cv_status::timeout) {
+        notified = epoch() != key;
+        break;
+      }
+    }
+  }
+  state_.fetch_sub(1, std::memory_order_relaxed);
+  return notified;
+}
+
+void eventcount::do_notify(bool all) {
+  {
+    // Bumping the epoch while holding the mutex makes sure that a thread in
+    // `wait` either sees the new epoch or already waits on the cv.
+    guard_type guard{mtx_};
+    state_.fetch_add(epoch_inc, std::memory_order_release);
+  }
+  if (all)
+    cv_.notify_all();
+  else
+    cv_.notify_one();
+}
+
+} // namespace caf::detail
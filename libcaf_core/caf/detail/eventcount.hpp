@@ -0,0 +1,99 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace caf::detail {
+
+/// Allows threads to wait for a condition that other threads signal without
+/// locking on the fast path. Waiting threads follow a two-phase protocol:
+///
+/// 1. Call `prepare_wait` to obtain a key.
+/// 2. Check the condition again. If it became true, call `cancel_wait`.
+///    Otherwise, call `wait` with the key from the first step.
+///
+/// Signaling threads first make the condition true and then call `notify_one`
+/// or `notify_all`. As long as no thread waits, notifying costs one fence and
+/// one atomic load.
+class CAF_CORE_EXPORT eventcount {
+public:
+  using key_type = uint32_t;
+
+  eventcount() = default;
+
+  eventcount(const eventcount&) = delete;
+
+  eventcount& operator=(const eventcount&) = delete;
+
+  /// Registers the calling thread as waiter.
+  /// @returns a key for calling `wait`.
+  key_type prepare_wait() noexcept {
+    auto prev = state_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return static_cast<key_type>(prev >> epoch_shift);
+  }
+
+  /// Deregisters the calling thread after calling `prepare_wait` without
+  /// calling `wait`.
+  void cancel_wait() noexcept {
+    state_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /// Blocks the calling thread until another thread calls `notify_one` or
+  /// `notify_all` after the call to `prepare_wait` that returned `key`.
+  void wait(key_type key);
+
+  /// Blocks the calling thread like `wait`, but returns at `deadline` at the
+  /// latest.
+  /// @returns `true` if another thread has called `notify_one` or `notify_all`
+  ///          after the call to `prepare_wait`, `false` on timeout.
+  bool wait_until(key_type key, std::chrono::steady_clock::time_point deadline);
+
+  /// Wakes up one waiting thread, if any.
+  void notify_one() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((state_.load(std::memory_order_relaxed) & waiter_mask) != 0)
+      do_notify(false);
+  }
+
+  /// Wakes up all waiting threads.
+  void notify_all() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if ((state_.load(std::memory_order_relaxed) & waiter_mask) != 0)
+      do_notify(true);
+  }
+
+  /// Returns the number of threads that currently wait or prepare to wait.
+  size_t num_waiters() const noexcept {
+    return static_cast<size_t>(state_.load() & waiter_mask);
+  }
+
+private:
+  // The lower 32 bits of the state count waiters, the upper 32 bits store the
+  // current epoch.
+  static constexpr int epoch_shift = 32;
+
+  static constexpr uint64_t waiter_mask = (uint64_t{1} << epoch_shift) - 1;
+
+  static constexpr uint64_t epoch_inc = uint64_t{1} << epoch_shift;
+
+  void do_notify(bool all);
+
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<uint64_t> state_ = 0;
+
+  std::mutex mtx_;
+
+  std::condition_variable cv_;
+};
+
+} // namespace caf::detail
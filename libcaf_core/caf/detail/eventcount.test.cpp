@@ -0,0 +1,82 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/eventcount.hpp"
+
+#include "caf/test/scenario.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+SCENARIO("an eventcount wakes up threads that wait for a condition") {
+  GIVEN("an eventcount and a flag") {
+    detail::eventcount uut;
+    std::atomic<bool> flag = false;
+    WHEN("the condition becomes true between prepare_wait and wait") {
+      THEN("wait returns immediately after a notify") {
+        auto key = uut.prepare_wait();
+        check_eq(uut.num_waiters(), 1u);
+        flag = true;
+        uut.notify_one();
+        uut.wait(key);
+        check_eq(uut.num_waiters(), 0u);
+      }
+    }
+    WHEN("the condition becomes true before calling wait") {
+      THEN("cancel_wait deregisters the waiter") {
+        uut.prepare_wait();
+        check_eq(uut.num_waiters(), 1u);
+        uut.cancel_wait();
+        check_eq(uut.num_waiters(), 0u);
+      }
+    }
+    WHEN("threads wait for the flag") {
+      THEN("notify_all wakes up all of them") {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 3; ++i) {
+          threads.emplace_back([&uut, &flag] {
+            for (;;) {
+              auto key = uut.prepare_wait();
+              if (flag.load()) {
+                uut.cancel_wait();
+                return;
+              }
+              uut.wait(key);
+            }
+          });
+        }
+        flag = true;
+        uut.notify_all();
+        for (auto& t : threads)
+          t.join();
+        check_eq(uut.num_waiters(), 0u);
+      }
+    }
+    WHEN("no thread calls notify before the deadline") {
+      THEN("wait_until returns false after the deadline") {
+        auto key = uut.prepare_wait();
+        auto deadline = std::chrono::steady_clock::now() + 1ms;
+        check(!uut.wait_until(key, deadline));
+        check_ge(std::chrono::steady_clock::now(), deadline);
+        check_eq(uut.num_waiters(), 0u);
+      }
+    }
+    WHEN("a thread calls notify before the deadline") {
+      THEN("wait_until returns true") {
+        auto key = uut.prepare_wait();
+        uut.notify_one();
+        check(uut.wait_until(key, std::chrono::steady_clock::now() + 1h));
+        check_eq(uut.num_waiters(), 0u);
+      }
+    }
+  }
+}
+
+} // namespace
@@ -15,6 +15,7 @@ public:
   virtual ~mailbox_factory();
 
   /// Creates a new mailbox for `owner`.
+  /// @returns a new mailbox or `nullptr` to select the default mailbox.
   virtual abstract_mailbox* make(scheduled_actor* owner) = 0;
 
   /// Creates a new mailbox for `owner`.
@@ -8,6 +8,7 @@
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/implicit_conversions.hpp"
 #include "caf/detail/padded_size.hpp"
+#include "caf/detail/size_class_allocator.hpp"
 #include "caf/fwd.hpp"
 #include "caf/type_id_list.hpp"
 
@@ -32,6 +33,16 @@ namespace caf::detail {
 /// Container for storing an arbitrary number of message elements.
 class CAF_CORE_EXPORT message_data {
 public:
+  // -- constants --------------------------------------------------------------
+
+  /// Messages with a payload of up to this many bytes reserve room for their
+  /// mailbox element in the same memory block when created via
+  /// `make_message`.
+  static constexpr size_t max_colocated_payload_size = 48;
+
+  /// The number of bytes that `make_message` reserves for the mailbox element.
+  static constexpr size_t colocated_element_size = 48;
+
   // -- constructors, destructors, and assignment operators --------------------
 
   message_data() = delete;
@@ -61,7 +72,7 @@ public:
   void deref() noexcept {
     if (unique() || rc_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
       this->~message_data();
-      free(const_cast<message_data*>(this));
+      size_class_allocator::deallocate(const_cast<message_data*>(this));
     }
   }
 
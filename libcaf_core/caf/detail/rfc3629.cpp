@@ -4,6 +4,9 @@
 
 #include "caf/detail/rfc3629.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 namespace {
 
 // Convenient literal for std::byte.
@@ -37,6 +40,31 @@ constexpr bool is_continuation_byte(std::byte value) noexcept {
   return head<2>(value) == 0b1000'0000_b;
 }
 
+/// Returns a pointer to the first non-ASCII character in `[first, last)`.
+/// Checks 32 bytes per iteration while possible.
+const std::byte* skip_ascii(const std::byte* first,
+                            const std::byte* last) noexcept {
+  // Selects the highest bit of each byte in a 64-bit word.
+  constexpr uint64_t high_bits = 0x8080'8080'8080'8080;
+  while (last - first >= 32) {
+    uint64_t words[4];
+    memcpy(words, first, 32);
+    if (((words[0] | words[1] | words[2] | words[3]) & high_bits) != 0)
+      break;
+    first += 32;
+  }
+  while (last - first >= 8) {
+    uint64_t word = 0;
+    memcpy(&word, first, 8);
+    if ((word & high_bits) != 0)
+      break;
+    first += 8;
+  }
+  while (first != last && head<1>(*first) == 0b0000'0000_b)
+    ++first;
+  return first;
+}
+
 // The following code is based on the algorithm described in
 // http://unicode.org/mail-arch/unicode-ml/y2003-m02/att-0467/01-The_Algorithm_to_Valide_an_UTF-8_String
 // Returns a pair consisting of an iterator to the of the valid  range, and a
@@ -47,9 +75,12 @@ std::pair<const std::byte*, bool> validate_rfc3629(const std::byte* first,
   while (first != last) {
     auto checkpoint = first;
     auto x = *first++;
-    // First bit is zero: ASCII character.
-    if (head<1>(x) == 0b0000'0000_b)
+    // First bit is zero: ASCII character. Skip all ASCII characters that
+    // follow, since text usually contains long runs of them.
+    if (head<1>(x) == 0b0000'0000_b) {
+      first = skip_ascii(first, last);
       continue;
+    }
     // 110b'xxxx: 2-byte sequence.
     if (head<3>(x) == 0b1100'0000_b) {
       // No non-shortest form.
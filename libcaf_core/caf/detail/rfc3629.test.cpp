@@ -221,4 +221,22 @@ TEST("rfc3629::validate stops at the first invalid byte") {
   }
 }
 
+TEST("rfc3629::validate finds errors at any position in long ASCII runs") {
+  // The validator skips ASCII characters in blocks, so errors must be found
+  // regardless of their offset within such a block.
+  for (size_t size : {7u, 8u, 9u, 31u, 32u, 33u, 100u}) {
+    for (size_t pos = 0; pos < size; ++pos) {
+      byte_buffer data(size, std::byte{'a'});
+      data[pos] = 0xff_b;
+      check_eq(rfc3629::validate(data), res_t{pos, false});
+      data[pos] = 0xc8_b;
+      check_eq(rfc3629::validate(make_span(data.data(), pos + 1)),
+               res_t{pos, true});
+      data[pos] = 0xc3_b;
+      data.insert(data.begin() + static_cast<ptrdiff_t>(pos) + 1, 0xa4_b);
+      check_eq(rfc3629::validate(data), res_t{size + 1, false});
+    }
+  }
+}
+
 } // namespace
@@ -0,0 +1,391 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/size_class_allocator.hpp"
+
+#include "caf/config.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+namespace caf::detail {
+
+namespace {
+
+constexpr size_t num_size_classes = size_class_allocator::num_size_classes;
+
+/// Marks blocks that bypass the pools.
+constexpr size_t unpooled = num_size_classes;
+
+/// Marks objects that share a block with another object.
+constexpr size_t paired = num_size_classes + 1;
+
+/// Limits how many bytes a thread keeps in its free list per size class.
+constexpr size_t max_cached_bytes = 64 * 1024;
+
+constexpr size_t max_cached_blocks(size_t size_class) {
+  return max_cached_bytes / size_class_allocator::max_size_of(size_class);
+}
+
+struct thread_cache;
+
+/// Precedes each allocated object and tells `deallocate` where the memory
+/// belongs to. The alignment keeps the objects suitably aligned for any type.
+/// For objects of a pair, `owner` points to the header of the shared block.
+struct alignas(std::max_align_t) block_header {
+  void* owner;
+  size_t size_class;
+};
+
+/// Follows the header of a block that holds a pair of objects.
+struct alignas(std::max_align_t) pair_control {
+  /// Number of objects in the block that are still alive.
+  std::atomic<size_t> count;
+};
+
+constexpr size_t pad(size_t size) {
+  constexpr auto align = alignof(std::max_align_t);
+  return (size + align - 1) / align * align;
+}
+
+/// Overlays the header of a block while the block sits in a free list.
+struct free_block {
+  free_block* next;
+};
+
+/// Caches free blocks of a single size class.
+struct alignas(CAF_CACHE_LINE_SIZE) bin {
+  /// Free blocks of the owning thread.
+  free_block* head = nullptr;
+
+  /// Number of blocks in `head`.
+  size_t length = 0;
+
+  /// Blocks that other threads have released.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<free_block*> returned = nullptr;
+};
+
+/// Stores the free lists of a thread. Caches outlive their thread, because
+/// other threads may still return blocks to them. Hence, we recycle caches of
+/// terminated threads instead of deleting them.
+struct thread_cache {
+  std::array<bin, num_size_classes> bins;
+
+  /// Counts allocations that we did not report to the telemetry counters yet.
+  std::array<size_t, num_size_classes + 1> unreported = {};
+
+  /// Links caches of terminated threads.
+  thread_cache* next = nullptr;
+};
+
+/// Stores the telemetry counters of an attached registry.
+struct counter_set {
+  telemetry::metric_registry* registry = nullptr;
+  std::array<telemetry::int_counter*, num_size_classes + 1> counters = {};
+};
+
+/// Global state of the allocator. Intentionally leaked to allow threads to
+/// release memory during static destruction.
+struct global_state {
+  /// Protects `orphans` and serializes `attach` and `detach`.
+  std::mutex mtx;
+  thread_cache* orphans = nullptr;
+};
+
+global_state& globals() {
+  static auto* instance = new global_state;
+  return *instance;
+}
+
+std::atomic<bool> pooling_enabled;
+
+/// Points to the counters of the attached registry if present.
+std::atomic<counter_set*> active_counters;
+
+/// Counts threads that currently access `active_counters`. Allows `detach` to
+/// wait until no thread uses the counters of a registry anymore.
+std::atomic<size_t> active_reporters;
+
+void report(size_t size_class, size_t count) {
+  // Note: the operations on active_counters and active_reporters must be
+  //       sequentially consistent. Otherwise, `retire` could miss a reporter
+  //       that still uses the counters.
+  active_reporters.fetch_add(1);
+  if (auto* set = active_counters.load())
+    if (auto* ptr = set->counters[size_class])
+      ptr->inc(static_cast<int64_t>(count));
+  active_reporters.fetch_sub(1);
+}
+
+/// Waits until no thread reports to `set` anymore and then deletes it.
+/// @pre `set` is no longer reachable via `active_counters`
+void retire(counter_set* set) {
+  if (set == nullptr)
+    return;
+  while (active_reporters.load() != 0)
+    std::this_thread::yield();
+  delete set;
+}
+
+void count_allocation(thread_cache* cache, size_t size_class) {
+  if (++cache->unreported[size_class] == size_class_allocator::report_interval) {
+    report(size_class, size_class_allocator::report_interval);
+    cache->unreported[size_class] = 0;
+  }
+}
+
+void release(thread_cache* cache) {
+  for (size_t index = 0; index < num_size_classes; ++index) {
+    auto& b = cache->bins[index];
+    while (b.head != nullptr) {
+      auto* blk = b.head;
+      b.head = blk->next;
+      free(blk);
+    }
+    b.length = 0;
+  }
+  for (size_t index = 0; index <= num_size_classes; ++index) {
+    if (auto count = cache->unreported[index]; count > 0) {
+      report(index, count);
+      cache->unreported[index] = 0;
+    }
+  }
+  auto& st = globals();
+  std::lock_guard guard{st.mtx};
+  cache->next = st.orphans;
+  st.orphans = cache;
+}
+
+/// Points to the cache of the current thread. Trivially destructible to
+/// remain accessible while destroying other thread-local objects.
+thread_local thread_cache* this_thread_cache;
+
+/// Stops the current thread from acquiring a new cache after its cache guard
+/// released the previous cache.
+thread_local bool this_thread_released;
+
+/// Hands the cache of the current thread over to the next thread on exit.
+struct cache_guard {
+  ~cache_guard() {
+    if (auto* cache = this_thread_cache) {
+      this_thread_cache = nullptr;
+      this_thread_released = true;
+      release(cache);
+    }
+  }
+};
+
+thread_local cache_guard this_thread_guard;
+
+thread_cache* acquire_cache() {
+  if (this_thread_cache != nullptr || this_thread_released)
+    return this_thread_cache;
+  // Touch the guard to make sure it gets constructed (and thus destroyed).
+  [[maybe_unused]] auto* guard = &this_thread_guard;
+  thread_cache* result = nullptr;
+  {
+    auto& st = globals();
+    std::lock_guard lock{st.mtx};
+    if (st.orphans != nullptr) {
+      result = st.orphans;
+      st.orphans = result->next;
+      result->next = nullptr;
+    }
+  }
+  if (result == nullptr)
+    result = new (std::nothrow) thread_cache;
+  this_thread_cache = result;
+  return result;
+}
+
+block_header* init_block(void* vptr, thread_cache* owner, size_t size_class) {
+  if (vptr == nullptr)
+    return nullptr;
+  return new (vptr) block_header{owner, size_class};
+}
+
+/// Allocates a block for a header plus `size` bytes.
+block_header* allocate_block(size_t size) noexcept {
+  if (pooling_enabled.load(std::memory_order_relaxed)) {
+    if (auto* cache = acquire_cache()) {
+      auto size_class = size_class_allocator::size_class_of(size);
+      count_allocation(cache, size_class);
+      if (size_class != unpooled) {
+        auto& b = cache->bins[size_class];
+        if (b.head == nullptr) {
+          // Reclaim all blocks that other threads have returned to us.
+          b.head = b.returned.exchange(nullptr, std::memory_order_acquire);
+          for (auto* i = b.head; i != nullptr; i = i->next)
+            ++b.length;
+        }
+        if (auto* blk = b.head) {
+          b.head = blk->next;
+          --b.length;
+          return init_block(blk, cache, size_class);
+        }
+        auto block_size = sizeof(block_header)
+                          + size_class_allocator::max_size_of(size_class);
+        return init_block(malloc(block_size), cache, size_class);
+      }
+    }
+  }
+  return init_block(malloc(sizeof(block_header) + size), nullptr, unpooled);
+}
+
+/// Returns a block to its owner or to the system.
+void release_block(block_header* hdr) noexcept {
+  auto* owner = static_cast<thread_cache*>(hdr->owner);
+  auto size_class = hdr->size_class;
+  if (size_class == unpooled) {
+    free(hdr);
+    return;
+  }
+  auto* blk = new (hdr) free_block{nullptr};
+  auto& b = owner->bins[size_class];
+  if (owner == this_thread_cache) {
+    if (b.length < max_cached_blocks(size_class)) {
+      blk->next = b.head;
+      b.head = blk;
+      ++b.length;
+    } else {
+      free(blk);
+    }
+    return;
+  }
+  // Return the block to its owner. No ABA problem here, because the owner
+  // only ever takes the entire list.
+  auto* head = b.returned.load(std::memory_order_relaxed);
+  do {
+    blk->next = head;
+  } while (!b.returned.compare_exchange_weak(head, blk,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+}
+
+} // namespace
+
+// -- allocation ---------------------------------------------------------------
+
+void* size_class_allocator::allocate(size_t size) noexcept {
+  if (auto* hdr = allocate_block(size))
+    return hdr + 1;
+  return nullptr;
+}
+
+std::pair<void*, void*>
+size_class_allocator::allocate_pair(size_t size1, size_t size2) noexcept {
+  // Layout: block header, pair control, header 1, object 1, header 2, object 2.
+  auto offset1 = sizeof(pair_control) + sizeof(block_header);
+  auto offset2 = offset1 + pad(size1) + sizeof(block_header);
+  auto* hdr = allocate_block(offset2 + size2);
+  if (hdr == nullptr)
+    return {nullptr, nullptr};
+  auto* base = reinterpret_cast<std::byte*>(hdr + 1);
+  new (base) pair_control{{2}};
+  auto* hdr1 = new (base + offset1 - sizeof(block_header))
+    block_header{hdr, paired};
+  auto* hdr2 = new (base + offset2 - sizeof(block_header))
+    block_header{hdr, paired};
+  return {hdr1 + 1, hdr2 + 1};
+}
+
+void* size_class_allocator::allocate_with_spare(size_t spare_size,
+                                                size_t size) noexcept {
+  auto [ptr1, ptr2] = allocate_pair(spare_size, size);
+  // Releasing the first object leaves the block to the second one.
+  deallocate(ptr1);
+  return ptr2;
+}
+
+void* size_class_allocator::claim_spare(const void* ptr, size_t size) noexcept {
+  auto* hdr2 = static_cast<const block_header*>(ptr) - 1;
+  if (hdr2->size_class != paired)
+    return nullptr;
+  auto* block = static_cast<block_header*>(hdr2->owner);
+  auto* base = reinterpret_cast<std::byte*>(block + 1);
+  auto* ptr1 = base + sizeof(pair_control) + sizeof(block_header);
+  // Fails for the first object of a pair and for slots that are too small.
+  auto* end1 = reinterpret_cast<const std::byte*>(hdr2);
+  if (end1 <= ptr1 || static_cast<size_t>(end1 - ptr1) < size)
+    return nullptr;
+  // The first slot is free if the object at `ptr` is the only one alive.
+  auto* ctrl = reinterpret_cast<pair_control*>(base);
+  size_t expected = 1;
+  if (!ctrl->count.compare_exchange_strong(expected, 2,
+                                           std::memory_order_acq_rel))
+    return nullptr;
+  return ptr1;
+}
+
+void size_class_allocator::deallocate(void* ptr) noexcept {
+  if (ptr == nullptr)
+    return;
+  auto* hdr = static_cast<block_header*>(ptr) - 1;
+  if (hdr->size_class != paired) {
+    release_block(hdr);
+    return;
+  }
+  auto* block = static_cast<block_header*>(hdr->owner);
+  auto* ctrl = reinterpret_cast<pair_control*>(block + 1);
+  if (ctrl->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    release_block(block);
+}
+
+bool size_class_allocator::same_block(const void* ptr1,
+                                      const void* ptr2) noexcept {
+  auto* hdr1 = static_cast<const block_header*>(ptr1) - 1;
+  auto* hdr2 = static_cast<const block_header*>(ptr2) - 1;
+  return ptr1 != ptr2 && hdr1->size_class == paired
+         && hdr2->size_class == paired && hdr1->owner == hdr2->owner;
+}
+
+// -- configuration ------------------------------------------------------------
+
+void size_class_allocator::enable(bool value) noexcept {
+  pooling_enabled.store(value, std::memory_order_relaxed);
+}
+
+bool size_class_allocator::enabled() noexcept {
+  return pooling_enabled.load(std::memory_order_relaxed);
+}
+
+// -- telemetry ----------------------------------------------------------------
+
+void size_class_allocator::attach(telemetry::metric_registry& reg) {
+  auto* family = reg.counter_family("caf.system", "allocations", {"size-class"},
+                                    "Number of allocations per size class.",
+                                    "1", true);
+  auto set = std::make_unique<counter_set>();
+  set->registry = &reg;
+  for (size_t index = 0; index < num_size_classes; ++index) {
+    auto name = std::to_string(max_size_of(index));
+    set->counters[index] = family->get_or_add({{"size-class", name}});
+  }
+  set->counters[unpooled] = family->get_or_add({{"size-class", "large"}});
+  auto& st = globals();
+  std::lock_guard guard{st.mtx};
+  retire(active_counters.exchange(set.release()));
+}
+
+void size_class_allocator::detach(telemetry::metric_registry& reg) noexcept {
+  auto& st = globals();
+  std::lock_guard guard{st.mtx};
+  auto* set = active_counters.load();
+  if (set != nullptr && set->registry == &reg) {
+    active_counters.store(nullptr);
+    retire(set);
+  }
+}
+
+} // namespace caf::detail
@@ -0,0 +1,114 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/core_export.hpp"
+#include "caf/fwd.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace caf::detail {
+
+/// Allocates small objects on the hot path of message passing, i.e.,
+/// `message_data` and `mailbox_element` objects. Each thread caches freed
+/// blocks in one free list per size class. Threads that release a block of
+/// another thread push it to a lock-free return list of the owning thread,
+/// which reclaims all returned blocks at once when running out of cached
+/// blocks.
+///
+/// While pooling is disabled or for objects larger than the largest size
+/// class, the allocator simply forwards to `malloc` and `free`.
+class CAF_CORE_EXPORT size_class_allocator {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// The number of size classes.
+  static constexpr size_t num_size_classes = 5;
+
+  /// The largest object size that the allocator serves from its pools.
+  static constexpr size_t max_pooled_size = size_t{64} << (num_size_classes - 1);
+
+  /// Allocations up to this number per thread and size class may remain
+  /// unreported to the telemetry counters.
+  static constexpr size_t report_interval = 64;
+
+  // -- allocation -------------------------------------------------------------
+
+  /// Allocates `size` bytes of memory that is suitably aligned for any type.
+  /// @returns the allocated memory or `nullptr` on failure.
+  static void* allocate(size_t size) noexcept;
+
+  /// Allocates a single block for two objects with `size1` and `size2` bytes.
+  /// The caller releases each object individually via `deallocate`. The block
+  /// itself returns to the pool once both objects were released.
+  /// @returns the memory for both objects or `nullptr` on failure.
+  static std::pair<void*, void*> allocate_pair(size_t size1,
+                                               size_t size2) noexcept;
+
+  /// Allocates a single block for two objects like `allocate_pair`, but only
+  /// returns the memory for the second object. The memory for the first
+  /// object remains spare until claimed via `claim_spare`.
+  /// @returns the memory for the second object or `nullptr` on failure.
+  static void* allocate_with_spare(size_t spare_size, size_t size) noexcept;
+
+  /// Returns the memory for the first object in the block of `ptr` if `ptr`
+  /// is the second object of a pair, the first object is not alive and its
+  /// slot has room for `size` bytes. The caller releases the returned memory
+  /// via `deallocate`.
+  /// @returns the spare memory or `nullptr` if the block has no free slot.
+  /// @pre `ptr` was allocated by this allocator and is still alive
+  /// @pre no other thread calls `claim_spare` for `ptr` concurrently
+  static void* claim_spare(const void* ptr, size_t size) noexcept;
+
+  /// Releases memory that was allocated by `allocate`, `allocate_pair`,
+  /// `allocate_with_spare` or `claim_spare`. May get called from any thread.
+  static void deallocate(void* ptr) noexcept;
+
+  /// Checks whether `ptr1` and `ptr2` are the two objects of a single call to
+  /// `allocate_pair`.
+  /// @pre both pointers were allocated by this allocator and are still alive
+  static bool same_block(const void* ptr1, const void* ptr2) noexcept;
+
+  // -- configuration ----------------------------------------------------------
+
+  /// Enables or disables pooling of small objects for all threads.
+  /// @note Changing this setting at runtime is safe. The allocator keeps track
+  ///       of how it allocated each object.
+  static void enable(bool value) noexcept;
+
+  /// Returns whether the allocator currently serves small objects from its
+  /// pools.
+  static bool enabled() noexcept;
+
+  /// Returns the size class for objects of `size` bytes or `num_size_classes`
+  /// if the allocator does not pool objects of this size.
+  static constexpr size_t size_class_of(size_t size) noexcept {
+    size_t index = 0;
+    for (auto block_size = size_t{64}; index < num_size_classes;
+         block_size <<= 1, ++index)
+      if (size <= block_size)
+        return index;
+    return num_size_classes;
+  }
+
+  /// Returns the maximum object size for given size class.
+  static constexpr size_t max_size_of(size_t size_class) noexcept {
+    return size_t{64} << size_class;
+  }
+
+  // -- telemetry --------------------------------------------------------------
+
+  /// Starts counting allocations per size class in the metric family
+  /// `caf.system.allocations` of `reg`. Replaces any previously attached
+  /// registry.
+  static void attach(telemetry::metric_registry& reg);
+
+  /// Stops counting allocations in `reg` unless another registry was attached
+  /// in the meantime.
+  static void detach(telemetry::metric_registry& reg) noexcept;
+};
+
+} // namespace caf::detail
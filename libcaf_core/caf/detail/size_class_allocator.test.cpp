@@ -0,0 +1,155 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/size_class_allocator.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::size_class_allocator;
+
+namespace {
+
+// Enables pooling for the lifetime of the fixture and restores the previous
+// setting afterwards.
+struct fixture {
+  fixture() : was_enabled(size_class_allocator::enabled()) {
+    size_class_allocator::enable(true);
+  }
+
+  ~fixture() {
+    size_class_allocator::enable(was_enabled);
+  }
+
+  bool was_enabled;
+};
+
+TEST("objects map to the smallest size class that fits") {
+  check_eq(size_class_allocator::size_class_of(1), 0u);
+  check_eq(size_class_allocator::size_class_of(64), 0u);
+  check_eq(size_class_allocator::size_class_of(65), 1u);
+  check_eq(size_class_allocator::size_class_of(1024), 4u);
+  check_eq(size_class_allocator::size_class_of(1025),
+           size_class_allocator::num_size_classes);
+}
+
+WITH_FIXTURE(fixture) {
+
+TEST("threads reuse blocks that they have released") {
+  auto* ptr = size_class_allocator::allocate(48);
+  require_ne(ptr, nullptr);
+  size_class_allocator::deallocate(ptr);
+  auto* ptr2 = size_class_allocator::allocate(40);
+  check_eq(ptr, ptr2);
+  size_class_allocator::deallocate(ptr2);
+}
+
+TEST("large objects bypass the pools") {
+  std::vector<std::byte> buf(4096);
+  auto* ptr = size_class_allocator::allocate(buf.size());
+  require_ne(ptr, nullptr);
+  memcpy(ptr, buf.data(), buf.size());
+  size_class_allocator::deallocate(ptr);
+}
+
+TEST("paired objects share a single block") {
+  auto [ptr1, ptr2] = size_class_allocator::allocate_pair(40, 80);
+  require_ne(ptr1, nullptr);
+  auto* ptr3 = size_class_allocator::allocate(40);
+  check(size_class_allocator::same_block(ptr1, ptr2));
+  check(!size_class_allocator::same_block(ptr1, ptr3));
+  size_class_allocator::deallocate(ptr3);
+  size_class_allocator::deallocate(ptr1);
+  size_class_allocator::deallocate(ptr2);
+}
+
+TEST("spare slots become available once their object is gone") {
+  auto* ptr2 = size_class_allocator::allocate_with_spare(40, 80);
+  require_ne(ptr2, nullptr);
+  check_eq(size_class_allocator::claim_spare(ptr2, 100), nullptr);
+  auto* ptr1 = size_class_allocator::claim_spare(ptr2, 40);
+  require_ne(ptr1, nullptr);
+  check(size_class_allocator::same_block(ptr1, ptr2));
+  check_eq(size_class_allocator::claim_spare(ptr2, 40), nullptr);
+  check_eq(size_class_allocator::claim_spare(ptr1, 40), nullptr);
+  size_class_allocator::deallocate(ptr1);
+  check_eq(size_class_allocator::claim_spare(ptr2, 40), ptr1);
+  size_class_allocator::deallocate(ptr2);
+  size_class_allocator::deallocate(ptr1);
+  auto* ptr3 = size_class_allocator::allocate(40);
+  check_eq(size_class_allocator::claim_spare(ptr3, 40), nullptr);
+  size_class_allocator::deallocate(ptr3);
+}
+
+TEST("blocks released by other threads return to their owner") {
+  auto* ptr = size_class_allocator::allocate(1000);
+  require_ne(ptr, nullptr);
+  std::thread{[ptr] { size_class_allocator::deallocate(ptr); }}.join();
+  // The block sits either in the free list or in the return list of this
+  // thread. Hence, we must get it back before the allocator calls `malloc`.
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < 10'000; ++i) {
+    auto* ptr2 = size_class_allocator::allocate(1000);
+    blocks.push_back(ptr2);
+    if (ptr2 == ptr)
+      break;
+  }
+  check_eq(blocks.back(), ptr);
+  for (auto* block : blocks)
+    size_class_allocator::deallocate(block);
+}
+
+TEST("the allocator counts allocations per size class") {
+  telemetry::metric_registry reg;
+  size_class_allocator::attach(reg);
+  std::thread{[] {
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < size_class_allocator::report_interval; ++i)
+      blocks.push_back(size_class_allocator::allocate(32));
+    for (auto* block : blocks)
+      size_class_allocator::deallocate(block);
+  }}.join();
+  size_class_allocator::detach(reg);
+  auto* family = reg.counter_family("caf.system", "allocations",
+                                    {"size-class"}, "", "1", true);
+  check_eq(family->get_or_add({{"size-class", "64"}})->value(),
+           static_cast<int64_t>(size_class_allocator::report_interval));
+}
+
+TEST("detaching a registry waits for threads that report to it") {
+  std::atomic<bool> stop = false;
+  auto allocate_loop = [&stop] {
+    while (!stop.load()) {
+      auto* ptr = size_class_allocator::allocate(32);
+      size_class_allocator::deallocate(ptr);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.emplace_back(allocate_loop);
+  // Destroying the registry right after detaching it must be safe.
+  for (int i = 0; i < 100; ++i) {
+    telemetry::metric_registry reg;
+    size_class_allocator::attach(reg);
+    std::this_thread::yield();
+    size_class_allocator::detach(reg);
+  }
+  stop = true;
+  for (auto& thread : threads)
+    thread.join();
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
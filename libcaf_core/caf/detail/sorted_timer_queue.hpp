@@ -0,0 +1,84 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace caf::detail {
+
+/// Stores pending timeouts in a vector that remains sorted by timestamp. Each
+/// insertion and each call to `advance` takes linear time.
+/// @tparam Entry Stores a timestamp in the member `t` and an action in the
+///               member `f`.
+/// @tparam Deleter Releases entries that leave the queue.
+template <class Entry, class Deleter = std::default_delete<Entry>>
+class sorted_timer_queue {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = std::chrono::steady_clock;
+
+  using time_point = clock_type::time_point;
+
+  using entry_ptr = std::unique_ptr<Entry, Deleter>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  sorted_timer_queue() {
+    tbl_.reserve(128);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of stored entries, including disposed entries that
+  /// the queue did not remove yet.
+  size_t size() const noexcept {
+    return tbl_.size();
+  }
+
+  /// Checks whether the queue contains no entries.
+  bool empty() const noexcept {
+    return tbl_.empty();
+  }
+
+  /// Returns the timestamp of the next entry.
+  /// @pre `!empty()`
+  time_point next_timeout() const noexcept {
+    return tbl_.front()->t;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a new entry to the queue.
+  void insert(entry_ptr ptr) {
+    auto by_timeout = [](auto& x, auto& y) { return x->t < y->t; };
+    auto pos = std::upper_bound(tbl_.begin(), tbl_.end(), ptr, by_timeout);
+    tbl_.insert(pos, std::move(ptr));
+  }
+
+  /// Calls `fn` for each entry that timed out at `now` and removes all
+  /// disposed entries from the queue.
+  template <class F>
+  void advance(time_point now, F&& fn) {
+    auto is_disposed = [](auto& x) { return !x || x->f.disposed(); };
+    auto i = tbl_.begin();
+    for (; i != tbl_.end() && (*i)->t <= now; ++i)
+      fn(*i);
+    // Here, we have [begin, i) be the entries that timed out. Move any
+    // already disposed entry also to the beginning so that we can erase them
+    // at once.
+    i = std::stable_partition(i, tbl_.end(), is_disposed);
+    tbl_.erase(tbl_.begin(), i);
+  }
+
+private:
+  std::vector<entry_ptr> tbl_;
+};
+
+} // namespace caf::detail
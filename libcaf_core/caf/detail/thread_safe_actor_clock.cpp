@@ -6,62 +6,192 @@
 
 #include "caf/actor_control_block.hpp"
 #include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/size_class_allocator.hpp"
 #include "caf/log/core.hpp"
+#include "caf/make_counted.hpp"
+#include "caf/raise_error.hpp"
 #include "caf/sec.hpp"
 #include "caf/system_messages.hpp"
 #include "caf/thread_owner.hpp"
 
+#include <cstdio>
+#include <new>
+#include <type_traits>
+
 namespace caf::detail {
 
+void thread_safe_actor_clock::entry_deleter::operator()(
+  schedule_entry* ptr) const noexcept {
+  ptr->deref();
+}
+
+void thread_safe_actor_clock::entry_deleter::operator()(
+  cancellation_node* ptr) const noexcept {
+  static_cast<schedule_entry*>(ptr)->deref();
+}
+
+thread_safe_actor_clock::cancellation_queue::~cancellation_queue() {
+  // nop
+}
+
+void thread_safe_actor_clock::cancellation_queue::push(
+  schedule_entry* ptr) noexcept {
+  ptr->ref();
+  // Drops the reference again if the queue has been closed.
+  inbox_.push_front(ptr);
+}
+
+void thread_safe_actor_clock::cancellation_queue::close() {
+  inbox_.close();
+}
+
+void thread_safe_actor_clock::schedule_entry::dispose() {
+  f.dispose();
+  if (cancellations && !canceled.exchange(true))
+    cancellations->push(this);
+}
+
+bool thread_safe_actor_clock::schedule_entry::disposed() const noexcept {
+  return f.disposed();
+}
+
+void thread_safe_actor_clock::schedule_entry::ref_disposable() const noexcept {
+  ref();
+}
+
+void thread_safe_actor_clock::schedule_entry::deref_disposable()
+  const noexcept {
+  deref();
+}
+
+void* thread_safe_actor_clock::schedule_entry::operator new(size_t size) {
+  auto* ptr = size_class_allocator::allocate(size);
+  if (ptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  return ptr;
+}
+
+void thread_safe_actor_clock::schedule_entry::operator delete(
+  void* ptr) noexcept {
+  size_class_allocator::deallocate(ptr);
+}
+
 disposable thread_safe_actor_clock::schedule(time_point abs_time, action f) {
-  queue_.push(schedule_entry_ptr{new schedule_entry{abs_time, f}});
-  return std::move(f).as_disposable();
+  auto* ptr = new schedule_entry(abs_time, std::move(f), cancellations_);
+  // Create the handle first, because the entry may time out right away.
+  auto result = ptr->as_disposable();
+  auto res = queue_.push_front(ptr);
+  if (res == intrusive::inbox_result::unblocked_reader) {
+    std::unique_lock guard{mtx_};
+    wakeup_ = true;
+    cv_.notify_one();
+  }
+  return result;
 }
 
-void thread_safe_actor_clock::run(queue_type* queue) {
-  auto lg = log::core::trace("");
-  std::vector<schedule_entry_ptr> tbl;
-  tbl.reserve(buffer_size * 2);
-  auto is_disposed = [](auto& x) { return !x || x->f.disposed(); };
-  auto by_timeout = [](auto& x, auto& y) { return x->t < y->t; };
+template <class TimerQueue>
+void thread_safe_actor_clock::drain(TimerQueue& timers) {
+  using node_pointer = schedule_entry::node_pointer;
+  // The queue returns new entries in LIFO order. Reverse the list to preserve
+  // the order of entries with the same timestamp.
+  node_pointer head = queue_.take_head();
+  node_pointer fifo = nullptr;
+  while (head != nullptr) {
+    auto next = head->next;
+    head->next = fifo;
+    fifo = head;
+    head = next;
+  }
+  while (fifo != nullptr) {
+    auto next = fifo->next;
+    schedule_entry_ptr ptr{queue_type::promote(fifo)};
+    // Skip entries that were canceled before reaching the timer queue.
+    if (!ptr->f.disposed())
+      timers.insert(std::move(ptr));
+    fifo = next;
+  }
+  // Unlink canceled entries from the wheel right away instead of keeping them
+  // until they time out. The sorted queue drops them in `advance`.
+  if constexpr (std::is_same_v<TimerQueue, wheel_type>) {
+    cancellations_->drain([&timers](schedule_entry* x) {
+      if (x->linked())
+        timers.erase(x);
+    });
+  }
+}
 
+template <class TimerQueue>
+void thread_safe_actor_clock::run(TimerQueue& timers) {
+  auto lg = log::core::trace("");
+  auto fire = [](schedule_entry_ptr& x) { x->f.run(); };
   for (;;) {
-    // Fetch additional scheduling requests from the queue.
-    if (tbl.empty()) {
-      auto ptr = queue->pop();
-      if (!ptr)
-        return;
-      tbl.emplace_back(std::move(ptr));
-    } else {
-      auto next_timeout = (*tbl.begin())->t;
-      if (auto maybe_ptr = queue->try_pop(next_timeout)) {
-        if (!*maybe_ptr)
-          return;
-        auto insert_pos = std::upper_bound(tbl.begin(), tbl.end(), *maybe_ptr,
-                                           by_timeout);
-        tbl.insert(insert_pos, std::move(*maybe_ptr));
-      }
-    }
+    // Fetch all new scheduling requests from the queue at once.
+    drain(timers);
     // Run all actions that timed out.
-    auto n = clock_type::now();
-    auto i = tbl.begin();
-    for (; i != tbl.end() && (*i)->t <= n; ++i)
-      (*i)->f.run();
-    // Here, we have [begin, i) be the actions that were executed. Move any
-    // already disposed action also to the beginning so that we can erase them
-    // at once.
-    i = std::stable_partition(i, tbl.end(), is_disposed);
-    tbl.erase(tbl.begin(), i);
+    timers.advance(clock_type::now(), fire);
+    // Free memory of timeouts that were canceled by disposing the action
+    // directly.
+    if constexpr (std::is_same_v<TimerQueue, wheel_type>)
+      timers.sweep();
+    // Wait for the next timeout or for new entries. Writers only need to
+    // signal us after we have marked the queue as blocked.
+    std::unique_lock guard{mtx_};
+    if (stopped_)
+      break;
+    if (!queue_.try_block())
+      continue;
+    auto pred = [this] { return wakeup_ || stopped_; };
+    if (timers.empty())
+      cv_.wait(guard, pred);
+    else if (auto timeout = timers.next_timeout();
+             timeout != time_point::max())
+      cv_.wait_until(guard, timeout, pred);
+    else
+      cv_.wait(guard, pred);
+    wakeup_ = false;
+    // Fails if a writer has unblocked the queue in the meantime.
+    queue_.try_unblock();
   }
+  // Drop all pending timeouts and discard any entry that arrives later on.
+  queue_.close();
+  if (cancellations_)
+    cancellations_->close();
 }
 
 void thread_safe_actor_clock::start_dispatch_loop(caf::actor_system& sys) {
-  dispatcher_ = sys.launch_thread("caf.clock", thread_owner::system,
-                                  [qptr = &queue_] { run(qptr); });
+  auto timer_queue = get_or(sys.config(), "caf.clock.timer-queue",
+                            defaults::clock::timer_queue);
+  if (timer_queue == "wheel") {
+    auto resolution = get_or(sys.config(), "caf.clock.wheel-resolution",
+                             defaults::clock::wheel_resolution);
+    cancellations_ = make_counted<cancellation_queue>();
+    auto loop = [this, resolution] {
+      wheel_type timers{clock_type::now(), resolution};
+      run(timers);
+    };
+    dispatcher_ = sys.launch_thread("caf.clock", thread_owner::system, loop);
+    return;
+  }
+  if (timer_queue != "sorted")
+    fprintf(stderr,
+            "[WARNING] '%s' is an unrecognized timer queue, falling back to "
+            "'sorted'\n",
+            timer_queue.c_str());
+  auto loop = [this] {
+    sorted_type timers;
+    run(timers);
+  };
+  dispatcher_ = sys.launch_thread("caf.clock", thread_owner::system, loop);
 }
 
 void thread_safe_actor_clock::stop_dispatch_loop() {
-  queue_.push(nullptr);
+  {
+    std::unique_lock guard{mtx_};
+    stopped_ = true;
+    cv_.notify_one();
+  }
   dispatcher_.join();
 }
 
@@ -7,34 +7,121 @@
 #include "caf/action.hpp"
 #include "caf/actor_clock.hpp"
 #include "caf/actor_control_block.hpp"
+#include "caf/disposable.hpp"
+#include "caf/detail/atomic_ref_counted.hpp"
 #include "caf/detail/core_export.hpp"
-#include "caf/detail/sync_ring_buffer.hpp"
+#include "caf/detail/sorted_timer_queue.hpp"
+#include "caf/detail/timer_wheel.hpp"
 #include "caf/fwd.hpp"
+#include "caf/intrusive/lifo_inbox.hpp"
+#include "caf/intrusive/singly_linked.hpp"
+#include "caf/intrusive_ptr.hpp"
+#include "caf/ref_counted.hpp"
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <thread>
-#include <vector>
 
 namespace caf::detail {
 
 class CAF_CORE_EXPORT thread_safe_actor_clock : public actor_clock {
 public:
-  // -- constants --------------------------------------------------------------
-
-  static constexpr size_t buffer_size = 64;
-
   // -- member types -----------------------------------------------------------
 
   using super = actor_clock;
 
-  /// Stores actions along with their scheduling period.
-  struct schedule_entry {
+  struct schedule_entry;
+
+  /// Intrusive base for passing canceled entries back to their owner.
+  struct cancellation_node : intrusive::singly_linked<cancellation_node> {};
+
+  /// Releases a reference to an entry that leaves a queue.
+  struct CAF_CORE_EXPORT entry_deleter {
+    void operator()(schedule_entry* ptr) const noexcept;
+
+    void operator()(cancellation_node* ptr) const noexcept;
+  };
+
+  /// Collects canceled entries for the thread that stores them in a timer
+  /// wheel. Allows the owner of the wheel to unlink each canceled entry in
+  /// constant time instead of keeping it until it times out.
+  class CAF_CORE_EXPORT cancellation_queue : public ref_counted {
+  public:
+    ~cancellation_queue() override;
+
+    /// Adds a reference to `ptr` to the queue.
+    /// @threadsafe
+    void push(schedule_entry* ptr) noexcept;
+
+    /// Calls `fn` for each entry in the queue and releases the references.
+    /// @warning Call only from the owner.
+    template <class F>
+    void drain(F&& fn);
+
+    /// Releases all entries in the queue and drops any entry that arrives
+    /// later on.
+    /// @warning Call only from the owner.
+    void close();
+
+  private:
+    intrusive::lifo_inbox<cancellation_node, entry_deleter> inbox_;
+  };
+
+  /// @relates cancellation_queue
+  using cancellation_queue_ptr = intrusive_ptr<cancellation_queue>;
+
+  /// Stores actions along with their scheduling period. Doubles as the
+  /// disposable for the scheduled action. When passing a cancellation queue
+  /// to the constructor, disposing the entry also hands it over to the owner
+  /// of the queue for removing it from the timer wheel.
+  struct CAF_CORE_EXPORT schedule_entry
+    : intrusive::singly_linked<schedule_entry>,
+      cancellation_node,
+      timer_wheel_node<schedule_entry>,
+      atomic_ref_counted,
+      disposable::impl {
+    // Resolves the ambiguity with the members of `cancellation_node`. Queues
+    // for new entries use these members.
+    using node_type = intrusive::singly_linked<schedule_entry>;
+
+    using node_pointer = node_type*;
+
+    using node_type::next;
+
+    schedule_entry(time_point t, action f,
+                   cancellation_queue_ptr cancellations = nullptr)
+      : t(t), f(std::move(f)), cancellations(std::move(cancellations)) {
+      // nop
+    }
+
     time_point t;
     action f;
+
+    /// Receives this entry when disposing it.
+    cancellation_queue_ptr cancellations;
+
+    /// Makes sure that `dispose` passes this entry to `cancellations` once.
+    std::atomic<bool> canceled{false};
+
+    void dispose() override;
+
+    bool disposed() const noexcept override;
+
+    void ref_disposable() const noexcept override;
+
+    void deref_disposable() const noexcept override;
+
+    /// Allocates memory for an entry via `size_class_allocator`.
+    static void* operator new(size_t size);
+
+    /// Releases memory allocated via `operator new`.
+    static void operator delete(void* ptr) noexcept;
   };
 
   /// @relates schedule_entry
-  using schedule_entry_ptr = std::unique_ptr<schedule_entry>;
+  using schedule_entry_ptr = std::unique_ptr<schedule_entry, entry_deleter>;
 
   // -- overrides --------------------------------------------------------------
 
@@ -50,19 +137,58 @@ public:
 
 private:
   // -- member types -----------------------------------------------------------
-  using queue_type = detail::sync_ring_buffer<schedule_entry_ptr, buffer_size>;
+
+  using queue_type = intrusive::lifo_inbox<schedule_entry, entry_deleter>;
+
+  using sorted_type = detail::sorted_timer_queue<schedule_entry, entry_deleter>;
+
+  using wheel_type = detail::timer_wheel<schedule_entry, entry_deleter>;
 
   // -- internal API -----------------------------------------------------------
 
-  static void run(queue_type* queue);
+  /// Runs the dispatch loop, using `TimerQueue` for storing pending timeouts.
+  template <class TimerQueue>
+  void run(TimerQueue& timers);
+
+  /// Moves all new entries from the queue to `timers`.
+  template <class TimerQueue>
+  void drain(TimerQueue& timers);
 
   // -- member variables -------------------------------------------------------
 
-  /// Communication to the dispatcher thread.
-  detail::sync_ring_buffer<schedule_entry_ptr, buffer_size> queue_;
+  /// Communication to the dispatcher thread. Any thread may push to this queue
+  /// without ever blocking. The dispatcher thread takes all entries at once.
+  queue_type queue_;
+
+  /// Receives canceled entries if the dispatcher thread uses a timer wheel.
+  cancellation_queue_ptr cancellations_;
+
+  /// Protects `wakeup_` and `stopped_`.
+  std::mutex mtx_;
+
+  /// Signals the dispatcher thread after it blocked the queue for waiting.
+  std::condition_variable cv_;
+
+  /// Tells the dispatcher thread that the queue has new entries.
+  bool wakeup_ = false;
+
+  /// Tells the dispatcher thread to shut down.
+  bool stopped_ = false;
 
   /// Handle to the dispatcher thread.
   std::thread dispatcher_;
 };
 
+template <class F>
+void thread_safe_actor_clock::cancellation_queue::drain(F&& fn) {
+  cancellation_node* ptr = inbox_.take_head();
+  while (ptr != nullptr) {
+    auto* next = static_cast<cancellation_node*>(ptr->next);
+    auto* entry = static_cast<schedule_entry*>(ptr);
+    fn(entry);
+    entry_deleter{}(entry);
+    ptr = next;
+  }
+}
+
 } // namespace caf::detail
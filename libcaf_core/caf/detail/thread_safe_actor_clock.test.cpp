@@ -0,0 +1,112 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/thread_safe_actor_clock.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/action.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/detail/latch.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+constexpr size_t num_threads = 4;
+
+constexpr size_t num_timeouts = 10'000;
+
+void run_storm(actor_system& sys) {
+  std::atomic<size_t> count = 0;
+  detail::latch done{1};
+  auto& clock = sys.clock();
+  // Schedule far more timeouts than the clock thread can process at once from
+  // several threads in parallel.
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&clock, &count, &done] {
+      for (size_t j = 0; j < num_timeouts; ++j) {
+        auto f = make_action([&count, &done] {
+          if (++count == num_threads * num_timeouts)
+            done.count_down();
+        });
+        clock.schedule(clock.now() + 1ms, std::move(f));
+      }
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+  done.wait();
+}
+
+TEST("the clock runs all timeouts from concurrent writers") {
+  SECTION("sorted timer queue") {
+    actor_system_config cfg;
+    actor_system sys{cfg};
+    run_storm(sys);
+  }
+  SECTION("timer wheel") {
+    actor_system_config cfg;
+    put(cfg.content, "caf.clock.timer-queue", "wheel");
+    actor_system sys{cfg};
+    run_storm(sys);
+  }
+}
+
+TEST("the clock drops canceled timeouts") {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  auto& clock = sys.clock();
+  std::atomic<bool> canceled_ran = false;
+  detail::latch done{2};
+  auto canceled = make_action([&canceled_ran] { canceled_ran = true; });
+  clock.schedule(clock.now() + 5ms, canceled);
+  canceled.dispose();
+  auto f = make_action([&done] { done.count_down(); });
+  clock.schedule(clock.now() + 10ms, std::move(f));
+  done.count_down_and_wait();
+  check(!canceled_ran);
+}
+
+TEST("disposing the handle cancels timeouts on the timer wheel") {
+  actor_system_config cfg;
+  put(cfg.content, "caf.clock.timer-queue", "wheel");
+  actor_system sys{cfg};
+  auto& clock = sys.clock();
+  std::atomic<bool> canceled_ran = false;
+  detail::latch done{2};
+  auto canceled = make_action([&canceled_ran] { canceled_ran = true; });
+  auto hdl = clock.schedule(clock.now() + 5ms, canceled);
+  hdl.dispose();
+  check(canceled.disposed());
+  // Disposing twice is a no-op.
+  auto far = clock.schedule(clock.now() + 1h, make_action([] {}));
+  auto far_copy = far;
+  far.dispose();
+  far_copy.dispose();
+  check(far_copy.disposed());
+  auto f = make_action([&done] { done.count_down(); });
+  clock.schedule(clock.now() + 10ms, std::move(f));
+  done.count_down_and_wait();
+  check(!canceled_ran);
+}
+
+TEST("shutting down the clock discards pending timeouts") {
+  actor_system_config cfg;
+  auto sys = std::make_unique<actor_system>(cfg);
+  std::atomic<bool> ran = false;
+  sys->clock().schedule(sys->clock().now() + 1h,
+                        make_action([&ran] { ran = true; }));
+  sys.reset();
+  check(!ran);
+}
+
+} // namespace
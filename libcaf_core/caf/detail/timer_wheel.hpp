@@ -0,0 +1,399 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace caf::detail {
+
+template <class Entry, class Deleter>
+class timer_wheel;
+
+/// Intrusive base for entries of a @ref timer_wheel. Links an entry into a
+/// slot of the wheel, which allows the wheel to remove any entry in constant
+/// time. Only the thread that owns the wheel may access the links.
+template <class Entry>
+class timer_wheel_node {
+public:
+  /// Checks whether the entry belongs to a wheel.
+  bool linked() const noexcept {
+    return wheel_slot_ != nullptr;
+  }
+
+private:
+  template <class, class>
+  friend class timer_wheel;
+
+  Entry* wheel_prev_ = nullptr;
+
+  Entry* wheel_next_ = nullptr;
+
+  void* wheel_slot_ = nullptr;
+};
+
+/// A hierarchical timing wheel for storing pending timeouts. The wheel divides
+/// time into ticks of fixed length and stores each entry in a slot of one of
+/// its levels, depending on how far in the future the entry times out. Each
+/// slot of level `n + 1` covers all slots of level `n`. Whenever the current
+/// tick enters the range of a slot, the wheel moves the entries of that slot
+/// to the next lower level ("cascading"). Inserting and erasing an entry takes
+/// constant time and advancing the wheel only touches slots that have entries.
+///
+/// The wheel never runs an entry before its timestamp, but may run an entry up
+/// to one tick late.
+/// @tparam Entry Stores a timestamp in the member `t` and an action in the
+///               member `f`. Must inherit from `timer_wheel_node<Entry>`.
+/// @tparam Deleter Releases entries that leave the wheel.
+template <class Entry, class Deleter = std::default_delete<Entry>>
+class timer_wheel {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = std::chrono::steady_clock;
+
+  using time_point = clock_type::time_point;
+
+  using duration_type = clock_type::duration;
+
+  using entry_ptr = std::unique_ptr<Entry, Deleter>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of bits in a tick that select the slot on a single level.
+  static constexpr size_t slot_bits = 8;
+
+  /// Number of slots per level.
+  static constexpr size_t num_slots = size_t{1} << slot_bits;
+
+  /// Number of levels. Entries beyond the range of the highest level go to an
+  /// overflow list.
+  static constexpr size_t num_levels = 4;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Creates a wheel that starts counting ticks of length `resolution` at
+  /// `origin`.
+  timer_wheel(time_point origin, duration_type resolution)
+    : origin_(origin), resolution_(std::max(resolution, duration_type{1})) {
+    for (size_t level = 0; level < num_levels; ++level)
+      for (auto& slot : levels_[level])
+        slot.level = level;
+  }
+
+  timer_wheel(const timer_wheel&) = delete;
+
+  timer_wheel& operator=(const timer_wheel&) = delete;
+
+  ~timer_wheel() {
+    for (auto& level : levels_)
+      for (auto& slot : level)
+        clear(slot);
+    clear(overflow_);
+    clear(due_);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of stored entries, including disposed entries that
+  /// the wheel did not remove yet.
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Checks whether the wheel contains no entries.
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the length of a single tick.
+  duration_type resolution() const noexcept {
+    return resolution_;
+  }
+
+  /// Returns the point in time when the wheel needs to advance next.
+  /// @pre `!empty()`
+  time_point next_timeout() const noexcept {
+    if (due_.head != nullptr)
+      return origin_;
+    auto tick = next_tick_with_work();
+    if (tick == std::numeric_limits<uint64_t>::max())
+      return time_point::max();
+    return origin_ + resolution_ * static_cast<duration_type::rep>(tick);
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a new entry to the wheel.
+  void insert(entry_ptr ptr) {
+    auto tick = tick_of(ptr->t);
+    place(ptr.release(), tick);
+    ++size_;
+  }
+
+  /// Removes `ptr` from the wheel without running it.
+  /// @pre `ptr->linked()` and `ptr` belongs to this wheel
+  void erase(Entry* ptr) {
+    auto& slot = slot_of(ptr);
+    unlink(slot, ptr);
+    if (slot.level < num_levels)
+      --counts_[slot.level];
+    --size_;
+    Deleter{}(ptr);
+  }
+
+  /// Calls `fn` for each entry that timed out at `now` and drops all disposed
+  /// entries in the slots that the wheel passes.
+  template <class F>
+  void advance(time_point now, F&& fn) {
+    run_all(due_, fn);
+    auto target = floor_tick_of(now);
+    while (current_ < target) {
+      auto next = next_tick_with_work();
+      if (next > target) {
+        current_ = target;
+        return;
+      }
+      current_ = next;
+      cascade();
+      auto& slot = levels_[0][current_ & slot_mask];
+      counts_[0] -= slot.size;
+      run_all(slot, fn);
+      // Cascading may produce entries that time out at the current tick.
+      run_all(due_, fn);
+    }
+  }
+
+  /// Removes disposed entries from the next slot in round-robin order. Calling
+  /// this function on each wakeup eventually frees the memory of all timeouts
+  /// that were canceled without calling `erase`, even if they would time out
+  /// only in the distant future.
+  /// @returns the number of removed entries.
+  size_t sweep() {
+    auto level = sweep_pos_ / num_slots;
+    auto& slot = levels_[level][sweep_pos_ % num_slots];
+    sweep_pos_ = (sweep_pos_ + 1) % (num_levels * num_slots);
+    size_t removed = 0;
+    for (auto* x = slot.head; x != nullptr;) {
+      auto* next = x->wheel_next_;
+      if (x->f.disposed()) {
+        unlink(slot, x);
+        Deleter{}(x);
+        ++removed;
+      }
+      x = next;
+    }
+    counts_[level] -= removed;
+    size_ -= removed;
+    return removed;
+  }
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  /// An intrusive, doubly linked list of entries.
+  struct slot_type {
+    Entry* head = nullptr;
+    Entry* tail = nullptr;
+    size_t size = 0;
+    /// The level of the slot or `num_levels` for lists outside of the levels.
+    size_t level = num_levels;
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr uint64_t slot_mask = num_slots - 1;
+
+  // -- utility functions ------------------------------------------------------
+
+  static slot_type& slot_of(Entry* ptr) noexcept {
+    return *static_cast<slot_type*>(ptr->wheel_slot_);
+  }
+
+  static void push_back(slot_type& slot, Entry* ptr) noexcept {
+    ptr->wheel_prev_ = slot.tail;
+    ptr->wheel_next_ = nullptr;
+    ptr->wheel_slot_ = &slot;
+    if (slot.tail != nullptr)
+      slot.tail->wheel_next_ = ptr;
+    else
+      slot.head = ptr;
+    slot.tail = ptr;
+    ++slot.size;
+  }
+
+  static void unlink(slot_type& slot, Entry* ptr) noexcept {
+    if (ptr->wheel_prev_ != nullptr)
+      ptr->wheel_prev_->wheel_next_ = ptr->wheel_next_;
+    else
+      slot.head = ptr->wheel_next_;
+    if (ptr->wheel_next_ != nullptr)
+      ptr->wheel_next_->wheel_prev_ = ptr->wheel_prev_;
+    else
+      slot.tail = ptr->wheel_prev_;
+    ptr->wheel_prev_ = nullptr;
+    ptr->wheel_next_ = nullptr;
+    ptr->wheel_slot_ = nullptr;
+    --slot.size;
+  }
+
+  /// Removes and returns the first entry of `slot`.
+  /// @pre `slot.head != nullptr`
+  static Entry* pop_front(slot_type& slot) noexcept {
+    auto* ptr = slot.head;
+    unlink(slot, ptr);
+    return ptr;
+  }
+
+  /// Releases all entries of `slot`.
+  static void clear(slot_type& slot) noexcept {
+    while (slot.head != nullptr)
+      Deleter{}(pop_front(slot));
+  }
+
+  /// Returns the first tick that begins at or after `t`.
+  uint64_t tick_of(time_point t) const noexcept {
+    if (t <= origin_)
+      return 0;
+    auto res = resolution_.count();
+    return static_cast<uint64_t>(((t - origin_).count() + res - 1) / res);
+  }
+
+  /// Returns the last tick that begins at or before `t`.
+  uint64_t floor_tick_of(time_point t) const noexcept {
+    if (t <= origin_)
+      return 0;
+    return static_cast<uint64_t>((t - origin_).count() / resolution_.count());
+  }
+
+  /// Stores `ptr` in the lowest level that has a slot for `tick`. An entry
+  /// belongs to level `n` if `tick` and `current_` differ only in the bits
+  /// that select the slot on levels `0` to `n`.
+  void place(Entry* ptr, uint64_t tick) {
+    if (tick <= current_) {
+      push_back(due_, ptr);
+      return;
+    }
+    for (size_t level = 0; level < num_levels; ++level) {
+      auto shift = slot_bits * (level + 1);
+      if ((tick >> shift) == (current_ >> shift)) {
+        auto index = (tick >> (slot_bits * level)) & slot_mask;
+        push_back(levels_[level][index], ptr);
+        ++counts_[level];
+        return;
+      }
+    }
+    push_back(overflow_, ptr);
+  }
+
+  /// Returns the next tick that may require work, i.e., the next tick with a
+  /// non-empty slot on level 0 or the next tick that requires cascading.
+  uint64_t next_tick_with_work() const noexcept {
+    if (counts_[0] > 0) {
+      // All entries on level 0 are within the current range of the level.
+      for (auto tick = current_ + 1; (tick & slot_mask) != 0; ++tick)
+        if (levels_[0][tick & slot_mask].head != nullptr)
+          return tick;
+      CAF_CRITICAL("timer_wheel: level 0 has entries outside of its range");
+    }
+    for (size_t level = 1; level < num_levels; ++level) {
+      if (counts_[level] > 0) {
+        auto shift = slot_bits * level;
+        return ((current_ >> shift) + 1) << shift;
+      }
+    }
+    if (overflow_.head != nullptr) {
+      auto shift = slot_bits * num_levels;
+      return ((current_ >> shift) + 1) << shift;
+    }
+    return std::numeric_limits<uint64_t>::max();
+  }
+
+  /// Moves entries from higher levels to lower levels when `current_` enters
+  /// the range of their slot.
+  void cascade() {
+    if ((current_ & mask_of(num_levels)) == 0)
+      reinsert_all(overflow_);
+    for (auto level = num_levels - 1; level > 0; --level) {
+      if ((current_ & mask_of(level)) == 0) {
+        auto& slot = levels_[level][(current_ >> (slot_bits * level))
+                                    & slot_mask];
+        counts_[level] -= slot.size;
+        reinsert_all(slot);
+      }
+    }
+  }
+
+  /// Returns a mask for all bits of a tick below `level`.
+  static constexpr uint64_t mask_of(size_t level) noexcept {
+    return (uint64_t{1} << (slot_bits * level)) - 1;
+  }
+
+  /// Places all entries of `xs` again and drops disposed entries on the way.
+  void reinsert_all(slot_type& xs) {
+    // Only visit the entries that are in the list right now, because placing
+    // an entry may append it to the same list (overflow).
+    for (auto n = xs.size; n > 0; --n) {
+      auto* x = pop_front(xs);
+      if (x->f.disposed()) {
+        Deleter{}(x);
+        --size_;
+      } else {
+        place(x, tick_of(x->t));
+      }
+    }
+  }
+
+  /// Runs all entries of `xs` that are not disposed and removes them.
+  template <class F>
+  void run_all(slot_type& xs, F& fn) {
+    // Only visit the entries that are in the list right now, because `fn` may
+    // add new entries to `due_`.
+    for (auto n = xs.size; n > 0; --n) {
+      auto x = entry_ptr{pop_front(xs)};
+      --size_;
+      if (!x->f.disposed())
+        fn(x);
+    }
+  }
+
+  // -- member variables -------------------------------------------------------
+
+  /// The point in time of tick 0.
+  time_point origin_;
+
+  /// The length of a single tick.
+  duration_type resolution_;
+
+  /// The last tick that the wheel has processed.
+  uint64_t current_ = 0;
+
+  /// The number of entries in the wheel.
+  size_t size_ = 0;
+
+  /// The next slot for `sweep`.
+  size_t sweep_pos_ = 0;
+
+  /// The number of entries per level.
+  std::array<size_t, num_levels> counts_ = {};
+
+  /// Stores the slots of all levels.
+  std::array<std::array<slot_type, num_slots>, num_levels> levels_;
+
+  /// Stores entries that are too far in the future for the highest level.
+  slot_type overflow_;
+
+  /// Stores entries that timed out on insertion.
+  slot_type due_;
+};
+
+} // namespace caf::detail
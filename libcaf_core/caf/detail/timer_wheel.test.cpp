@@ -0,0 +1,193 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/timer_wheel.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/action.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+struct entry : detail::timer_wheel_node<entry> {
+  entry(std::chrono::steady_clock::time_point t, action f)
+    : t(t), f(std::move(f)) {
+    // nop
+  }
+
+  std::chrono::steady_clock::time_point t;
+  action f;
+};
+
+using wheel_type = detail::timer_wheel<entry>;
+
+using time_point = wheel_type::time_point;
+
+struct fixture {
+  time_point t0 = time_point{} + 1h;
+
+  wheel_type uut{t0, 1ms};
+
+  // Stores the IDs of all entries that ran, in order.
+  std::vector<int> fired;
+
+  // Stores the points in time when entries ran.
+  std::vector<time_point> fired_at;
+
+  // The current time when advancing the wheel.
+  time_point now = t0;
+
+  action add(int id, time_point t) {
+    return add_entry(id, t)->f;
+  }
+
+  entry* add_entry(int id, time_point t) {
+    auto f = make_action([this, id] {
+      fired.push_back(id);
+      fired_at.push_back(now);
+    });
+    auto ptr = std::make_unique<entry>(t, f);
+    auto* result = ptr.get();
+    uut.insert(std::move(ptr));
+    return result;
+  }
+
+  void advance_to(time_point t) {
+    now = t;
+    uut.advance(t, [](auto& ptr) { ptr->f.run(); });
+  }
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("a new wheel is empty") {
+  check(uut.empty());
+  check_eq(uut.size(), 0u);
+}
+
+TEST("the wheel runs entries once their timestamp has been reached") {
+  add(1, t0 + 10ms);
+  add(2, t0 + 5ms);
+  check_eq(uut.size(), 2u);
+  check_eq(uut.next_timeout(), t0 + 5ms);
+  advance_to(t0 + 4ms);
+  check(fired.empty());
+  advance_to(t0 + 5ms);
+  check_eq(fired, std::vector<int>{2});
+  advance_to(t0 + 20ms);
+  check_eq(fired, std::vector<int>{2, 1});
+  check(uut.empty());
+}
+
+TEST("entries in the past run on the next advance") {
+  advance_to(t0 + 100ms);
+  add(1, t0 + 50ms);
+  check_eq(uut.next_timeout(), t0);
+  advance_to(t0 + 100ms);
+  check_eq(fired, std::vector<int>{1});
+}
+
+TEST("the wheel cascades entries from higher levels") {
+  add(1, t0 + 300ms);    // level 1
+  add(2, t0 + 70s);      // level 2
+  add(3, t0 + 5h);       // level 3
+  add(4, t0 + 24 * 60h); // overflow
+  check_le(uut.next_timeout(), t0 + 300ms);
+  advance_to(t0 + 299ms);
+  check(fired.empty());
+  advance_to(t0 + 300ms);
+  check_eq(fired, std::vector<int>{1});
+  advance_to(t0 + 70s - 1ms);
+  check_eq(fired, std::vector<int>{1});
+  advance_to(t0 + 70s);
+  check_eq(fired, std::vector<int>{1, 2});
+  advance_to(t0 + 5h);
+  check_eq(fired, std::vector<int>{1, 2, 3});
+  advance_to(t0 + 24 * 60h - 1ms);
+  check_eq(fired, std::vector<int>{1, 2, 3});
+  advance_to(t0 + 24 * 60h);
+  check_eq(fired, std::vector<int>{1, 2, 3, 4});
+  check(uut.empty());
+}
+
+TEST("the wheel never runs entries early and at most one tick late") {
+  std::minstd_rand rng{42};
+  std::uniform_int_distribution<int> dist{0, 600'000};
+  std::vector<time_point> timeouts;
+  for (int id = 0; id < 1000; ++id) {
+    auto t = t0 + std::chrono::microseconds{dist(rng) * 100};
+    timeouts.push_back(t);
+    add(id, t);
+  }
+  for (auto t = t0; !uut.empty(); t += 7ms)
+    advance_to(t);
+  require_eq(fired.size(), timeouts.size());
+  for (size_t i = 0; i < fired.size(); ++i) {
+    auto t = timeouts[static_cast<size_t>(fired[i])];
+    check_ge(fired_at[i], t);
+    check_lt(fired_at[i] - t, 7ms + 1ms);
+  }
+}
+
+TEST("the wheel skips disposed entries") {
+  auto f1 = add(1, t0 + 10ms);
+  add(2, t0 + 10ms);
+  f1.dispose();
+  advance_to(t0 + 10ms);
+  check_eq(fired, std::vector<int>{2});
+  check(uut.empty());
+}
+
+TEST("sweeping removes disposed entries before they time out") {
+  auto f1 = add(1, t0 + 1h);
+  add(2, t0 + 1h);
+  f1.dispose();
+  size_t removed = 0;
+  for (size_t i = 0; i < wheel_type::num_levels * wheel_type::num_slots; ++i)
+    removed += uut.sweep();
+  check_eq(removed, 1u);
+  check_eq(uut.size(), 1u);
+}
+
+TEST("erasing removes entries from any level right away") {
+  auto* e1 = add_entry(1, t0 + 10ms);     // level 0
+  auto* e2 = add_entry(2, t0 + 300ms);    // level 1
+  add(3, t0 + 300ms);                     // level 1
+  auto* e4 = add_entry(4, t0 + 24 * 60h); // overflow
+  check_eq(uut.size(), 4u);
+  check(e1->linked());
+  uut.erase(e1);
+  check_eq(uut.size(), 3u);
+  check_ge(uut.next_timeout(), t0 + 256ms);
+  uut.erase(e2);
+  uut.erase(e4);
+  check_eq(uut.size(), 1u);
+  advance_to(t0 + 24 * 60h);
+  check_eq(fired, std::vector<int>{3});
+  check(uut.empty());
+}
+
+TEST("entries leave the wheel unlinked") {
+  auto* e1 = add_entry(1, t0 + 10ms);
+  auto* e2 = add_entry(2, t0 + 10ms);
+  check(e1->linked());
+  check(e2->linked());
+  std::vector<std::unique_ptr<entry>> kept;
+  uut.advance(t0 + 10ms,
+              [&kept](auto& ptr) { kept.push_back(std::move(ptr)); });
+  require_eq(kept.size(), 2u);
+  check(!kept[0]->linked());
+  check(!kept[1]->linked());
+  check(uut.empty());
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
@@ -0,0 +1,245 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace caf::detail {
+
+/// A lock-free FIFO queue of pointers for any number of producers and
+/// consumers that never rejects an element. The queue stores its elements in a
+/// linked list of fixed-size segments. Producers and consumers claim slots by
+/// advancing a global tail or head index, so the order of the queue is the
+/// order in which producers claimed their slots. The producer that claims the
+/// last slot of a segment appends the next segment and the consumer that takes
+/// the last slot of a segment moves on to the next segment. The last consumer
+/// that finishes reading from a segment deletes it.
+/// @note A consumer that claims a slot whose producer did not store its element
+///       yet waits for the producer. Likewise, threads that arrive while
+///       another thread moves to the next segment wait until it is done.
+template <class T>
+class unbounded_mpmc_queue {
+public:
+  using value_type = T;
+  using pointer = value_type*;
+
+  /// @pre `segment_size > 0`
+  explicit unbounded_mpmc_queue(size_t segment_size)
+    : segment_size_(segment_size), lap_(segment_size + 1) {
+    CAF_ASSERT(segment_size > 0);
+    auto* seg = new segment(segment_size);
+    head_.index.store(0, std::memory_order_relaxed);
+    head_.seg.store(seg, std::memory_order_relaxed);
+    tail_.index.store(0, std::memory_order_relaxed);
+    tail_.seg.store(seg, std::memory_order_relaxed);
+  }
+
+  unbounded_mpmc_queue(const unbounded_mpmc_queue&) = delete;
+
+  unbounded_mpmc_queue& operator=(const unbounded_mpmc_queue&) = delete;
+
+  ~unbounded_mpmc_queue() {
+    // All segments before the head are gone already.
+    auto* seg = head_.seg.load(std::memory_order_relaxed);
+    while (seg != nullptr) {
+      auto* next = seg->next.load(std::memory_order_relaxed);
+      delete seg;
+      seg = next;
+    }
+  }
+
+  /// Appends `value` to the queue.
+  void push(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    auto tail = tail_.index.load(std::memory_order_acquire);
+    auto* seg = tail_.seg.load(std::memory_order_acquire);
+    std::unique_ptr<segment> next_seg;
+    for (;;) {
+      auto offset = (tail >> index_shift) % lap_;
+      if (offset == segment_size_) {
+        // Another producer is about to install the next segment.
+        std::this_thread::yield();
+        tail = tail_.index.load(std::memory_order_acquire);
+        seg = tail_.seg.load(std::memory_order_acquire);
+        continue;
+      }
+      // Allocate the next segment before claiming the last slot to keep the
+      // time other producers have to wait as short as possible.
+      if (offset + 1 == segment_size_ && next_seg == nullptr)
+        next_seg = std::make_unique<segment>(segment_size_);
+      auto new_tail = tail + index_step;
+      if (tail_.index.compare_exchange_weak(tail, new_tail,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_acquire)) {
+        if (offset + 1 == segment_size_) {
+          auto* next = next_seg.release();
+          tail_.seg.store(next, std::memory_order_release);
+          tail_.index.store(new_tail + index_step, std::memory_order_release);
+          seg->next.store(next, std::memory_order_release);
+        }
+        auto& item = seg->slots[offset];
+        item.value = value;
+        item.state.fetch_or(slot_written, std::memory_order_release);
+        return;
+      }
+      seg = tail_.seg.load(std::memory_order_acquire);
+    }
+  }
+
+  /// Tries to remove the oldest element from the queue.
+  /// @returns the removed element or `nullptr` if the queue is empty.
+  pointer try_pop() {
+    auto head = head_.index.load(std::memory_order_acquire);
+    auto* seg = head_.seg.load(std::memory_order_acquire);
+    for (;;) {
+      auto offset = (head >> index_shift) % lap_;
+      if (offset == segment_size_) {
+        // Another consumer is about to move to the next segment.
+        std::this_thread::yield();
+        head = head_.index.load(std::memory_order_acquire);
+        seg = head_.seg.load(std::memory_order_acquire);
+        continue;
+      }
+      auto new_head = head + index_step;
+      if ((new_head & has_next_flag) == 0) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto tail = tail_.index.load(std::memory_order_relaxed);
+        if ((head >> index_shift) == (tail >> index_shift))
+          return nullptr;
+        // Once the tail is in a later segment, no consumer of this segment
+        // needs to check the tail again.
+        if ((head >> index_shift) / lap_ != (tail >> index_shift) / lap_)
+          new_head |= has_next_flag;
+      }
+      if (head_.index.compare_exchange_weak(head, new_head,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_acquire)) {
+        if (offset + 1 == segment_size_) {
+          auto* next = await_next(seg);
+          auto next_index = (new_head & ~has_next_flag) + index_step;
+          if (next->next.load(std::memory_order_relaxed) != nullptr)
+            next_index |= has_next_flag;
+          head_.seg.store(next, std::memory_order_release);
+          head_.index.store(next_index, std::memory_order_release);
+        }
+        auto& item = seg->slots[offset];
+        while ((item.state.load(std::memory_order_acquire) & slot_written) == 0)
+          std::this_thread::yield();
+        auto* result = item.value;
+        if (offset + 1 == segment_size_)
+          release(seg, 0);
+        else if ((item.state.fetch_or(slot_read, std::memory_order_acq_rel)
+                  & slot_release)
+                 != 0)
+          release(seg, offset + 1);
+        return result;
+      }
+      seg = head_.seg.load(std::memory_order_acquire);
+    }
+  }
+
+  /// Returns an approximation of the current number of elements.
+  size_t size() const noexcept {
+    auto head = head_.index.load(std::memory_order_relaxed) >> index_shift;
+    auto tail = tail_.index.load(std::memory_order_relaxed) >> index_shift;
+    // Each lap of the index skips one position when moving to the next
+    // segment.
+    auto to_count = [this](size_t pos) { return pos - pos / lap_; };
+    return tail > head ? to_count(tail) - to_count(head) : 0u;
+  }
+
+  /// Returns whether the queue appeared empty at the time of the call.
+  bool empty() const noexcept {
+    return size() == 0;
+  }
+
+  /// Returns the number of elements per segment.
+  size_t segment_size() const noexcept {
+    return segment_size_;
+  }
+
+private:
+  /// Signals that the producer has stored its element in the slot.
+  static constexpr size_t slot_written = 0x01;
+
+  /// Signals that the consumer has read the element from the slot.
+  static constexpr size_t slot_read = 0x02;
+
+  /// Signals that the consumer of the slot must release the segment.
+  static constexpr size_t slot_release = 0x04;
+
+  /// Marks a head index whose segment has a successor.
+  static constexpr size_t has_next_flag = 0x01;
+
+  /// The lowest bit of each index is reserved for `has_next_flag`.
+  static constexpr size_t index_shift = 1;
+
+  /// Advances an index by one position.
+  static constexpr size_t index_step = size_t{1} << index_shift;
+
+  struct slot {
+    std::atomic<size_t> state = 0;
+    pointer value = nullptr;
+  };
+
+  struct segment {
+    explicit segment(size_t size) : slots(std::make_unique<slot[]>(size)) {
+      // nop
+    }
+
+    std::atomic<segment*> next = nullptr;
+
+    std::unique_ptr<slot[]> slots;
+  };
+
+  struct position {
+    std::atomic<size_t> index;
+    std::atomic<segment*> seg;
+  };
+
+  /// Waits until the producer of the last slot in `seg` has appended the next
+  /// segment.
+  static segment* await_next(segment* seg) {
+    for (;;) {
+      if (auto* next = seg->next.load(std::memory_order_acquire))
+        return next;
+      std::this_thread::yield();
+    }
+  }
+
+  /// Deletes `seg` unless a consumer still reads one of its slots, starting at
+  /// `first`. In that case, the consumer of that slot calls this function
+  /// again after reading its element.
+  void release(segment* seg, size_t first) {
+    // The consumer of the last slot starts the release, so we can skip it.
+    for (auto i = first; i + 1 < segment_size_; ++i) {
+      auto& state = seg->slots[i].state;
+      if ((state.load(std::memory_order_acquire) & slot_read) == 0
+          && (state.fetch_or(slot_release, std::memory_order_acq_rel)
+              & slot_read)
+               == 0)
+        return;
+    }
+    delete seg;
+  }
+
+  /// Number of slots per segment.
+  size_t segment_size_;
+
+  /// Number of index positions per segment. The extra position marks that a
+  /// producer or consumer moves to the next segment.
+  size_t lap_;
+
+  alignas(CAF_CACHE_LINE_SIZE) position head_;
+
+  alignas(CAF_CACHE_LINE_SIZE) position tail_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,128 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/unbounded_mpmc_queue.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::unbounded_mpmc_queue;
+
+namespace {
+
+TEST("a new queue is empty") {
+  unbounded_mpmc_queue<int> uut{4};
+  check(uut.empty());
+  check_eq(uut.try_pop(), nullptr);
+}
+
+TEST("the queue keeps the FIFO order across segments") {
+  std::vector<int> xs(10);
+  unbounded_mpmc_queue<int> uut{4};
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.size(), 10u);
+  for (size_t i = 0; i < 6; ++i)
+    check_eq(uut.try_pop(), &xs[i]);
+  check_eq(uut.size(), 4u);
+  int y = 0;
+  uut.push(&y);
+  for (size_t i = 6; i < 10; ++i)
+    check_eq(uut.try_pop(), &xs[i]);
+  check_eq(uut.try_pop(), &y);
+  check_eq(uut.try_pop(), nullptr);
+  check(uut.empty());
+}
+
+TEST("segments may hold a single element") {
+  std::vector<int> xs(3);
+  unbounded_mpmc_queue<int> uut{1};
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.size(), 3u);
+  for (auto& x : xs)
+    check_eq(uut.try_pop(), &x);
+  check_eq(uut.try_pop(), nullptr);
+}
+
+TEST("the destructor releases all remaining segments") {
+  std::vector<int> xs(10);
+  unbounded_mpmc_queue<int> uut{4};
+  for (auto& x : xs)
+    uut.push(&x);
+  check_eq(uut.try_pop(), &xs[0]);
+}
+
+TEST("each element is taken exactly once under contention") {
+  constexpr size_t num_items = 10'000;
+  constexpr size_t num_threads = 2;
+  std::vector<int> xs(num_items);
+  std::vector<std::atomic<int>> taken(num_items);
+  unbounded_mpmc_queue<int> uut{8};
+  std::atomic<size_t> total = 0;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i] {
+      for (auto j = i; j < num_items; j += num_threads)
+        uut.push(&xs[j]);
+    });
+    threads.emplace_back([&] {
+      while (total.load() < num_items) {
+        if (auto* ptr = uut.try_pop()) {
+          taken[static_cast<size_t>(ptr - xs.data())].fetch_add(1);
+          total.fetch_add(1);
+        }
+      }
+    });
+  }
+  for (auto& hdl : threads)
+    hdl.join();
+  check_eq(total.load(), num_items);
+  check(std::all_of(taken.begin(), taken.end(),
+                    [](const auto& x) { return x.load() == 1; }));
+}
+
+TEST("consumers see the elements of each producer in FIFO order") {
+  constexpr size_t num_items = 10'000;
+  constexpr size_t num_producers = 2;
+  constexpr size_t num_consumers = 2;
+  // Element i of producer p is xs[p * num_items + i].
+  std::vector<int> xs(num_producers * num_items);
+  unbounded_mpmc_queue<int> uut{8};
+  std::atomic<size_t> total = 0;
+  std::atomic<bool> in_order = true;
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < num_producers; ++p)
+    threads.emplace_back([&, p] {
+      for (size_t i = 0; i < num_items; ++i)
+        uut.push(&xs[p * num_items + i]);
+    });
+  for (size_t c = 0; c < num_consumers; ++c)
+    threads.emplace_back([&] {
+      std::vector<ptrdiff_t> last(num_producers, -1);
+      while (total.load() < xs.size()) {
+        if (auto* ptr = uut.try_pop()) {
+          auto pos = ptr - xs.data();
+          auto& prev = last[static_cast<size_t>(pos) / num_items];
+          if (pos <= prev)
+            in_order = false;
+          prev = pos;
+          total.fetch_add(1);
+        }
+      }
+    });
+  for (auto& hdl : threads)
+    hdl.join();
+  check_eq(total.load(), xs.size());
+  check(in_order.load());
+  check(uut.empty());
+}
+
+} // namespace
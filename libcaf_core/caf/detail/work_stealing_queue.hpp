@@ -0,0 +1,166 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/config.hpp"
+#include "caf/detail/chase_lev_deque.hpp"
+#include "caf/detail/unbounded_mpmc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace caf::detail {
+
+/// A lock-free job queue for work-stealing that offers the same interface as
+/// `double_ended_queue`. Jobs from the owner go to a Chase-Lev deque, jobs
+/// from other threads go to an MPMC inbox. The mutex and condition variable
+/// only come into play when the owner goes to sleep.
+template <class T>
+class work_stealing_queue {
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+
+  /// The default segment size of the inbox for jobs from other threads.
+  static constexpr size_t default_inbox_segment_size = 1024;
+
+  explicit work_stealing_queue(
+    size_t inbox_segment_size = default_inbox_segment_size)
+    : inbox_(inbox_segment_size) {
+    // nop
+  }
+
+  // -- for the owner ----------------------------------------------------------
+
+  void prepend(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    local_.push(value);
+  }
+
+  pointer try_take_head() {
+    if (auto* result = local_.pop())
+      return result;
+    return inbox_.try_pop();
+  }
+
+  template <class Duration>
+  pointer try_take_head(Duration rel_timeout) {
+    if (auto* result = try_take_head())
+      return result;
+    auto abs_timeout = std::chrono::steady_clock::now() + rel_timeout;
+    std::unique_lock guard{mtx_};
+    for (;;) {
+      if (auto* result = try_take_head_sleepy())
+        return result;
+      if (cv_.wait_until(guard, abs_timeout) == std::cv_status::timeout) {
+        sleeping_.store(false, std::memory_order_relaxed);
+        return try_take_head();
+      }
+    }
+  }
+
+  pointer take_head() {
+    if (auto* result = try_take_head())
+      return result;
+    std::unique_lock guard{mtx_};
+    for (;;) {
+      if (auto* result = try_take_head_sleepy())
+        return result;
+      cv_.wait(guard);
+    }
+  }
+
+  // Puts `value` to the end of the line without waking up the owner, i.e.,
+  // after all jobs from other threads that are currently waiting.
+  void unsafe_append(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    inbox_.push(value);
+  }
+
+  // -- for others -------------------------------------------------------------
+
+  void append(pointer value) {
+    CAF_ASSERT(value != nullptr);
+    inbox_.push(value);
+    // Pairs with the fence in `try_take_head_sleepy`: either the owner sees
+    // our job or we see that the owner went to sleep.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+      { // Lifetime scope of guard: makes sure the owner is waiting on the cv.
+        std::unique_lock guard{mtx_};
+      }
+      cv_.notify_one();
+    }
+  }
+
+  pointer try_take_tail() {
+    if (auto* result = local_.steal())
+      return result;
+    return inbox_.try_pop();
+  }
+
+  /// Takes up to half of the queued jobs (but at most `max_count`) and stores
+  /// them to `buf`, oldest job first.
+  /// @returns the number of stored jobs.
+  /// @note Moving multiple elements with a single CAS on the top index of the
+  ///       Chase-Lev deque would race with `pop`, so we steal one job at a
+  ///       time. This still avoids returning to the victim selection after each
+  ///       job and never blocks.
+  size_t try_take_tail_half(pointer* buf, size_t max_count) {
+    auto count = std::min((size() + 1) / 2, max_count);
+    for (size_t i = 0; i < count; ++i) {
+      auto* job = try_take_tail();
+      if (job == nullptr)
+        return i;
+      buf[i] = job;
+    }
+    return count;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns an approximation of the number of queued jobs.
+  size_t size() const noexcept {
+    return local_.size() + inbox_.size();
+  }
+
+private:
+  // Announces that the owner is about to sleep and checks the queue one last
+  // time. Must be called while holding `mtx_`.
+  pointer try_take_head_sleepy() {
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (auto* result = try_take_head()) {
+      sleeping_.store(false, std::memory_order_relaxed);
+      return result;
+    }
+    return nullptr;
+  }
+
+  /// Stores jobs from the owner.
+  chase_lev_deque<T> local_;
+
+  /// Stores jobs from other threads.
+  unbounded_mpmc_queue<T> inbox_;
+
+  /// Signals that the owner waits on `cv_`.
+  alignas(CAF_CACHE_LINE_SIZE) std::atomic<bool> sleeping_ = false;
+
+  /// Protects `cv_`.
+  std::mutex mtx_;
+
+  /// Allows the owner to sleep while waiting for new jobs.
+  std::condition_variable cv_;
+};
+
+} // namespace caf::detail
@@ -0,0 +1,114 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/work_stealing_queue.hpp"
+
+#include "caf/test/test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+
+using detail::work_stealing_queue;
+
+namespace {
+
+TEST("thieves take nothing from an empty queue") {
+  int* buf[4];
+  work_stealing_queue<int> uut;
+  check_eq(uut.try_take_tail_half(buf, 4), 0u);
+}
+
+TEST("thieves take half of the queued jobs, oldest first") {
+  int xs[] = {1, 2, 3, 4, 5};
+  int* buf[8];
+  work_stealing_queue<int> uut;
+  for (auto& x : xs)
+    uut.prepend(&x);
+  SECTION("an odd number of jobs rounds up") {
+    check_eq(uut.try_take_tail_half(buf, 8), 3u);
+    check_eq(buf[0], &xs[0]);
+    check_eq(buf[1], &xs[1]);
+    check_eq(buf[2], &xs[2]);
+    check_eq(uut.size(), 2u);
+    check_eq(uut.try_take_head(), &xs[4]);
+    check_eq(uut.try_take_head(), &xs[3]);
+    check_eq(uut.try_take_head(), nullptr);
+  }
+  SECTION("a single job goes to the thief") {
+    for (int i = 0; i < 4; ++i)
+      uut.try_take_head();
+    check_eq(uut.try_take_tail_half(buf, 8), 1u);
+    check_eq(buf[0], &xs[0]);
+    check_eq(uut.size(), 0u);
+  }
+}
+
+TEST("thieves take jobs from other threads in FIFO order") {
+  int xs[] = {1, 2, 3, 4};
+  int* buf[4];
+  work_stealing_queue<int> uut;
+  for (auto& x : xs)
+    uut.append(&x);
+  check_eq(uut.try_take_tail_half(buf, 4), 2u);
+  check_eq(buf[0], &xs[0]);
+  check_eq(buf[1], &xs[1]);
+  check_eq(uut.size(), 2u);
+}
+
+TEST("thieves take no more than max_count jobs") {
+  std::vector<int> xs(10);
+  int* buf[10];
+  work_stealing_queue<int> uut;
+  for (auto& x : xs)
+    uut.prepend(&x);
+  check_eq(uut.try_take_tail_half(buf, 2), 2u);
+  check_eq(buf[0], &xs[0]);
+  check_eq(buf[1], &xs[1]);
+  check_eq(uut.size(), 8u);
+  check_eq(uut.try_take_tail_half(buf, 1), 1u);
+  check_eq(buf[0], &xs[2]);
+  check_eq(uut.size(), 7u);
+}
+
+TEST("each job is taken exactly once while the owner pops concurrently") {
+  constexpr size_t num_items = 10'000;
+  constexpr size_t num_thieves = 3;
+  std::vector<int> xs(num_items);
+  std::vector<std::atomic<int>> taken(num_items);
+  work_stealing_queue<int> uut;
+  std::atomic<size_t> total = 0;
+  auto mark = [&](int* ptr) {
+    taken[static_cast<size_t>(ptr - xs.data())].fetch_add(1);
+    total.fetch_add(1);
+  };
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < num_thieves; ++i)
+    thieves.emplace_back([&] {
+      int* buf[8];
+      while (total.load() < num_items) {
+        auto count = uut.try_take_tail_half(buf, 8);
+        for (size_t j = 0; j < count; ++j)
+          mark(buf[j]);
+      }
+    });
+  for (size_t i = 0; i < num_items; ++i) {
+    uut.prepend(&xs[i]);
+    if (i % 3 == 0)
+      if (auto* ptr = uut.try_take_head())
+        mark(ptr);
+  }
+  while (auto* ptr = uut.try_take_head())
+    mark(ptr);
+  for (auto& thief : thieves)
+    thief.join();
+  check_eq(total.load(), num_items);
+  check(std::all_of(taken.begin(), taken.end(),
+                    [](const auto& x) { return x.load() == 1; }));
+}
+
+} // namespace
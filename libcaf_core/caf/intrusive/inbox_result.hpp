@@ -23,6 +23,10 @@ enum class inbox_result {
   /// Indicates that the enqueue operation failed because the
   /// queue has been closed by the reader.
   queue_closed,
+
+  /// Indicates that the enqueue operation failed because the
+  /// queue has reached its capacity.
+  queue_full,
 };
 
 CAF_CORE_EXPORT std::string to_string(inbox_result);
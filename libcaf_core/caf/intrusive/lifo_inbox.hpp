@@ -14,7 +14,9 @@ namespace caf::intrusive {
 
 /// An intrusive, thread-safe LIFO queue implementation for a single reader
 /// with any number of writers.
-template <class T>
+/// @tparam T The element type.
+/// @tparam Deleter Releases elements that the inbox drops.
+template <class T, class Deleter = std::default_delete<T>>
 class lifo_inbox {
 public:
   // -- member types -----------------------------------------------------------
@@ -27,7 +29,7 @@ public:
 
   using node_pointer = node_type*;
 
-  using unique_pointer = std::unique_ptr<value_type>;
+  using unique_pointer = std::unique_ptr<value_type, Deleter>;
 
   using deleter_type = typename unique_pointer::deleter_type;
 
@@ -233,6 +233,21 @@ public:
     return iterator{ptr};
   }
 
+  // -- removal ----------------------------------------------------------------
+
+  /// Removes the element after `pos` from the list and returns it.
+  /// @pre `pos != end()` and `pos` does not point to the last element
+  unique_pointer take_after(iterator pos) noexcept {
+    CAF_ASSERT(pos != end());
+    auto ptr = pos.ptr->next;
+    CAF_ASSERT(ptr != &tail_);
+    pos.ptr->next = ptr->next;
+    if (ptr->next == &tail_)
+      tail_.next = pos.ptr;
+    --size_;
+    return unique_pointer{promote(ptr)};
+  }
+
   // -- algorithms -------------------------------------------------------------
 
   /// Tries to find an element in the list that matches the given predicate.
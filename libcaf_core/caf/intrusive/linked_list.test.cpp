@@ -74,6 +74,33 @@ TEST("insert_after inserts elements after a given position") {
   check_eq(deep_to_string(uut), "[0, 1, 2, 3]");
 }
 
+TEST("take_after removes the element after a given position") {
+  list_type uut;
+  fill(uut, 1, 2, 3);
+  SECTION("removing the first element") {
+    auto ptr = uut.take_after(uut.before_begin());
+    check_eq(ptr->value, 1);
+    check_eq(deep_to_string(uut), "[2, 3]");
+    check_eq(uut.size(), 2u);
+  }
+  SECTION("removing the last element") {
+    auto ptr = uut.take_after(uut.begin().next());
+    check_eq(ptr->value, 3);
+    check_eq(deep_to_string(uut), "[1, 2]");
+    uut.emplace_back(4);
+    check_eq(deep_to_string(uut), "[1, 2, 4]");
+  }
+  SECTION("removing the only element") {
+    uut.clear();
+    uut.emplace_back(1);
+    auto ptr = uut.take_after(uut.before_begin());
+    check_eq(ptr->value, 1);
+    check(uut.empty());
+    uut.emplace_back(2);
+    check_eq(deep_to_string(uut), "[2]");
+  }
+}
+
 TEST("lists are movable") {
   list_type uut;
   SECTION("move constructor") {
@@ -4,7 +4,11 @@
 
 #include "caf/mailbox_element.hpp"
 
+#include "caf/detail/size_class_allocator.hpp"
+#include "caf/raise_error.hpp"
+
 #include <memory>
+#include <new>
 
 namespace caf {
 
@@ -14,8 +18,32 @@ mailbox_element::mailbox_element(strong_actor_ptr sender, message_id mid,
   // nop
 }
 
+void* mailbox_element::operator new(size_t size) {
+  auto* ptr = detail::size_class_allocator::allocate(size);
+  if (ptr == nullptr)
+    CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
+  return ptr;
+}
+
+void mailbox_element::operator delete(void* ptr) noexcept {
+  detail::size_class_allocator::deallocate(ptr);
+}
+
+static_assert(sizeof(mailbox_element)
+              <= detail::message_data::colocated_element_size);
+
 mailbox_element_ptr make_mailbox_element(strong_actor_ptr sender, message_id id,
                                          message payload) {
+  using detail::size_class_allocator;
+  // Note: the element keeps the block alive even if the actor moves the
+  //       payload elsewhere and the message data goes away first.
+  if (payload.unique()) {
+    auto* vptr = size_class_allocator::claim_spare(payload.cptr(),
+                                                   sizeof(mailbox_element));
+    if (vptr != nullptr)
+      return mailbox_element_ptr{::new (vptr) mailbox_element(
+        std::move(sender), id, std::move(payload))};
+  }
   return std::make_unique<mailbox_element>(std::move(sender), id,
                                            std::move(payload));
 }
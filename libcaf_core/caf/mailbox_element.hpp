@@ -19,6 +19,12 @@ namespace caf {
 class CAF_CORE_EXPORT mailbox_element
   : public intrusive::singly_linked<mailbox_element> {
 public:
+  /// Messages with a payload of up to this many bytes share a single memory
+  /// block with their mailbox element unless the message data has more than
+  /// one owner when creating the element.
+  static constexpr size_t max_colocated_payload_size
+    = detail::message_data::max_colocated_payload_size;
+
   /// Source of this message and receiver of the final response.
   strong_actor_ptr sender;
 
@@ -57,6 +63,14 @@ public:
     return mid.category() == message_id::urgent_message_category;
   }
 
+  // -- memory management ------------------------------------------------------
+
+  /// Allocates memory for a mailbox element via `size_class_allocator`.
+  static void* operator new(size_t size);
+
+  /// Releases memory allocated via `operator new`.
+  static void operator delete(void* ptr) noexcept;
+
   mailbox_element(mailbox_element&&) = delete;
   mailbox_element(const mailbox_element&) = delete;
   mailbox_element& operator=(mailbox_element&&) = delete;
@@ -83,6 +97,9 @@ bool inspect(Inspector& f, mailbox_element& x) {
 /// @relates mailbox_element
 using mailbox_element_ptr = std::unique_ptr<mailbox_element>;
 
+/// Creates a new mailbox element for `content`. Places the element into the
+/// memory block of the message data if `content` is the only reference to its
+/// data and the block has room for the element.
 /// @relates mailbox_element
 CAF_CORE_EXPORT mailbox_element_ptr
 make_mailbox_element(strong_actor_ptr sender, message_id id, message content);
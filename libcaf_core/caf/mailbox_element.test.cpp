@@ -4,9 +4,11 @@
 
 #include "caf/mailbox_element.hpp"
 
+#include "caf/test/fixture/deterministic.hpp"
 #include "caf/test/test.hpp"
 
 #include "caf/all.hpp"
+#include "caf/detail/size_class_allocator.hpp"
 
 #include <string>
 #include <tuple>
@@ -65,4 +67,71 @@ TEST("high_priority") {
   check(m1->mid.category() == message_id::urgent_message_category);
 }
 
+TEST("small messages share a memory block with their element") {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), 1, 2, 3);
+  SECTION("the element reuses the block after re-sending the message") {
+    auto msg = std::move(m1->payload);
+    m1.reset();
+    m1 = make_mailbox_element(nullptr, make_message_id(), std::move(msg));
+  }
+  auto* elem_ptr = reinterpret_cast<const std::byte*>(m1.get());
+  auto* data_ptr = reinterpret_cast<const std::byte*>(m1->payload.cptr());
+  check_gt(data_ptr, elem_ptr);
+  check_lt(data_ptr, elem_ptr + 256);
+  check(detail::size_class_allocator::same_block(m1.get(), data_ptr));
+  SECTION("the message outlives its element") {
+    auto msg = m1->payload;
+    m1.reset();
+    check_eq((fetch<int, int, int>(msg)), make_tuple(1, 2, 3));
+  }
+}
+
+TEST("shared messages use a separate memory block") {
+  auto msg = make_message(1, 2, 3);
+  auto copy = msg;
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), std::move(msg));
+  check(!detail::size_class_allocator::same_block(m1.get(), m1->payload.cptr()));
+}
+
+TEST("large messages use a separate memory block") {
+  auto m1 = make_mailbox_element(nullptr, make_message_id(), string{"a"},
+                                 string{"b"}, string{"c"});
+  auto* data_ptr = m1->payload.cptr();
+  check(!detail::size_class_allocator::same_block(m1.get(), data_ptr));
+  check_eq((fetch<string, string, string>(*m1)),
+           make_tuple(string{"a"}, string{"b"}, string{"c"}));
+}
+
+WITH_FIXTURE(test::fixture::deterministic) {
+
+TEST("actors send small messages without a separate element allocation") {
+  auto colocated = std::make_shared<std::vector<bool>>();
+  auto receiver = sys.spawn([colocated](event_based_actor* self) -> behavior {
+    auto same_block = [self] {
+      auto* ptr = self->current_mailbox_element();
+      return detail::size_class_allocator::same_block(ptr,
+                                                      ptr->payload.cptr());
+    };
+    return {
+      [colocated, same_block](int) { colocated->push_back(same_block()); },
+      [colocated, same_block](int, int) {
+        colocated->push_back(same_block());
+        return 42;
+      },
+    };
+  });
+  auto sender = sys.spawn([receiver, colocated](event_based_actor* self) {
+    self->mail(1).send(receiver);
+    self->mail(1, 2).request(receiver, infinite).then([self, colocated](int) {
+      auto* ptr = self->current_mailbox_element();
+      colocated->push_back(
+        detail::size_class_allocator::same_block(ptr, ptr->payload.cptr()));
+    });
+  });
+  dispatch_messages();
+  check_eq(*colocated, std::vector<bool>{true, true, true});
+}
+
+} // WITH_FIXTURE(test::fixture::deterministic)
+
 } // namespace
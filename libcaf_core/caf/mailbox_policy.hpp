@@ -0,0 +1,51 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/default_enum_inspect.hpp"
+#include "caf/detail/core_export.hpp"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace caf {
+
+/// Configures how a bounded mailbox reacts to new messages after reaching its
+/// capacity.
+enum class mailbox_policy {
+  /// Rejects the new message. The receiver answers requests with
+  /// `sec::mailbox_full`.
+  reject,
+  /// Discards the oldest pending message to make room for the new message. The
+  /// receiver answers a discarded request with `sec::mailbox_full`.
+  drop_oldest,
+  /// Discards the new message but reports a successful delivery to the
+  /// sender. The receiver answers a discarded request with
+  /// `sec::mailbox_full`.
+  drop_newest,
+  /// Blocks the sender until the receiver has room for the new message if the
+  /// sender is a blocking actor. Rejects messages from all other senders to
+  /// keep scheduler threads responsive.
+  block,
+};
+
+/// @relates mailbox_policy
+CAF_CORE_EXPORT std::string to_string(mailbox_policy);
+
+/// @relates mailbox_policy
+CAF_CORE_EXPORT bool from_string(std::string_view, mailbox_policy&);
+
+/// @relates mailbox_policy
+CAF_CORE_EXPORT bool from_integer(std::underlying_type_t<mailbox_policy>,
+                                  mailbox_policy&);
+
+/// @relates mailbox_policy
+template <class Inspector>
+bool inspect(Inspector& f, mailbox_policy& x) {
+  return default_enum_inspect(f, x);
+}
+
+} // namespace caf
@@ -221,10 +221,19 @@ message make_message(Ts&&... xs) {
   using namespace detail;
   static_assert((!std::is_pointer_v<strip_and_convert_t<Ts>> && ...));
   static_assert((is_complete<type_id<strip_and_convert_t<Ts>>> && ...));
-  static constexpr size_t data_size
-    = sizeof(message_data) + (padded_size_v<strip_and_convert_t<Ts>> + ...);
+  static constexpr size_t payload_size
+    = (padded_size_v<strip_and_convert_t<Ts>> + ...);
+  static constexpr size_t data_size = sizeof(message_data) + payload_size;
   auto types = make_type_id_list<strip_and_convert_t<Ts>...>();
-  auto vptr = malloc(data_size);
+  void* vptr = nullptr;
+  if constexpr (payload_size <= message_data::max_colocated_payload_size) {
+    // Reserve room for a mailbox element in the same memory block. Sending the
+    // message then needs no additional allocation for the element.
+    vptr = size_class_allocator::allocate_with_spare(
+      message_data::colocated_element_size, data_size);
+  } else {
+    vptr = size_class_allocator::allocate(data_size);
+  }
   if (vptr == nullptr)
     CAF_RAISE_ERROR(std::bad_alloc, "bad_alloc");
   auto raw_ptr = new (vptr) message_data(types);
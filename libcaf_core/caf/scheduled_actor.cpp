@@ -123,16 +123,18 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
     down_handler_(default_down_handler),
     node_down_handler_(default_node_down_handler),
     exit_handler_(default_exit_handler),
-    private_thread_(nullptr)
+    private_thread_(nullptr),
+    numa_node_(cfg.numa_node)
 #ifdef CAF_ENABLE_EXCEPTIONS
     ,
     exception_handler_(default_exception_handler)
 #endif // CAF_ENABLE_EXCEPTIONS
 {
-  if (cfg.mbox_factory == nullptr)
+  // Note: factories may return nullptr to select the default mailbox.
+  mailbox_ = cfg.mbox_factory != nullptr ? cfg.mbox_factory->make(this)
+                                         : nullptr;
+  if (mailbox_ == nullptr)
     mailbox_ = new (&default_mailbox_) detail::default_mailbox();
-  else
-    mailbox_ = cfg.mbox_factory->make(this);
 }
 
 scheduled_actor::~scheduled_actor() {
@@ -163,6 +165,8 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       intrusive_ptr_add_ref(ctrl());
       if (private_thread_)
         private_thread_->resume(this);
+      else if (numa_node_ >= 0)
+        home_system().scheduler().enqueue_on_node(this, numa_node_);
       else if (eu != nullptr)
         eu->exec_later(this);
       else
@@ -173,6 +177,14 @@ bool scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
       // enqueued to a running actors' mailbox; nothing to do
       CAF_LOG_ACCEPT_EVENT(false);
       return true;
+    case intrusive::inbox_result::queue_full:
+      // A bounded mailbox rejected the message and already answered it with
+      // `sec::mailbox_full` if it was a request.
+      CAF_LOG_REJECT_EVENT();
+      home_system().base_metrics().rejected_messages->inc();
+      if (collects_metrics)
+        metrics_.mailbox_size->dec();
+      return false;
     default: { // intrusive::inbox_result::queue_closed
       CAF_LOG_REJECT_EVENT();
       home_system().base_metrics().rejected_messages->inc();
@@ -206,6 +218,13 @@ void scheduled_actor::launch(execution_unit* ctx, bool lazy, bool hide) {
   CAF_ASSERT(!getf(is_blocking_flag));
   if (!hide)
     register_at_system();
+  if (getf(abstract_actor::collects_metrics_flag)
+      && mailbox().capacity() > 0) {
+    auto* fill_level = home_system().actor_metric_families().mailbox_fill;
+    std::string_view sv{name()};
+    mailbox().setup_metrics(metrics_.mailbox_size,
+                            fill_level->get_or_add({{"name", sv}}));
+  }
   auto delay_first_scheduling = lazy && mailbox().try_block();
   if (getf(is_detached_flag)) {
     private_thread_ = ctx->system().acquire_private_thread();
@@ -215,7 +234,10 @@ void scheduled_actor::launch(execution_unit* ctx, bool lazy, bool hide) {
     }
   } else if (!delay_first_scheduling) {
     intrusive_ptr_add_ref(ctrl());
-    ctx->exec_later(this);
+    if (numa_node_ >= 0)
+      ctx->system().scheduler().enqueue_on_node(this, numa_node_);
+    else
+      ctx->exec_later(this);
   }
 }
 
@@ -277,6 +299,14 @@ resumable::resume_result scheduled_actor::resume(execution_unit* ctx,
       }
       continue; // Interrupted by a new message, try again.
     }
+    if (batch_handler_ && awaited_responses_.empty()
+        && batch_handler_->accepts(*ptr)) {
+      auto res = run_batch(std::move(ptr), max_throughput - consumed,
+                           consumed);
+      if (res == activation_result::terminated)
+        return resumable::done;
+      continue;
+    }
     auto res = run_with_metrics(*ptr, [this, &ptr, &consumed] {
       auto res = reactivate(*ptr);
       switch (res) {
@@ -846,6 +876,53 @@ auto scheduled_actor::reactivate(mailbox_element& x) -> activation_result {
   return activation_result::terminated;
 }
 
+auto scheduled_actor::run_batch(mailbox_element_ptr x, size_t max_batch_size,
+                                size_t& consumed) -> activation_result {
+  auto lg = log::core::trace("x = {}, max_batch_size = {}", *x,
+                             max_batch_size);
+  // Keep the handler alive until it returns, even if it calls
+  // `set_batch_handler` or `unset_batch_handler`.
+  auto handler_ptr = batch_handler_;
+  auto& handler = *handler_ptr;
+  auto t0 = std::chrono::steady_clock::now();
+  do {
+    if (metrics_.mailbox_time)
+      metrics_.mailbox_time->observe(x->seconds_until(t0));
+    handler.add(*x);
+    x = handler.size() < max_batch_size ? mailbox().pop_front() : nullptr;
+  } while (x != nullptr && handler.accepts(*x));
+  // Put back the first message that does not belong into this batch.
+  if (x != nullptr)
+    mailbox().push_front(std::move(x));
+  auto batch_size = handler.size();
+  consumed += batch_size;
+  if (metrics_.mailbox_size)
+    metrics_.mailbox_size->dec(static_cast<int64_t>(batch_size));
+  current_element_ = nullptr;
+#ifdef CAF_ENABLE_EXCEPTIONS
+  try {
+#endif // CAF_ENABLE_EXCEPTIONS
+    handler.run();
+#ifdef CAF_ENABLE_EXCEPTIONS
+  } catch (...) {
+    log::core::info("actor died because of an exception in a batch handler");
+    auto eptr = std::current_exception();
+    quit(call_handler(exception_handler_, this, eptr));
+    finalize();
+    return activation_result::terminated;
+  }
+#endif // CAF_ENABLE_EXCEPTIONS
+  if (metrics_.processing_time)
+    telemetry::timer::observe(metrics_.processing_time, t0);
+  bhvr_stack_.cleanup();
+  if (finalize()) {
+    log::core::debug("actor finalized");
+    return activation_result::terminated;
+  }
+  unstash();
+  return activation_result::success;
+}
+
 // -- behavior management ----------------------------------------------------
 
 void scheduled_actor::do_become(behavior bhvr, bool discard_old) {
@@ -16,6 +16,7 @@
 #include "caf/actor_traits.hpp"
 #include "caf/async/fwd.hpp"
 #include "caf/cow_string.hpp"
+#include "caf/detail/batch_handler.hpp"
 #include "caf/detail/behavior_stack.hpp"
 #include "caf/detail/core_export.hpp"
 #include "caf/detail/default_mailbox.hpp"
@@ -335,6 +336,25 @@ public:
                                          exit_msg& x) mutable { fn(x); };
   }
 
+  /// Sets a handler for processing consecutive asynchronous messages that
+  /// consist of a single `T` in batches. Instead of dispatching each message
+  /// through the behavior, the actor collects up to `max-throughput` of these
+  /// messages from its mailbox and passes them to `fun` as `span<T>`. Requests,
+  /// responses and all other messages still go to the current behavior.
+  /// @note Calling `current_sender()` or `current_message_id()` is not allowed
+  ///       inside of `fun`, because a batch has no single sender.
+  template <class T, class F>
+  void set_batch_handler(F fun) {
+    using impl_t = detail::batch_handler_impl<T, F>;
+    batch_handler_ = std::make_shared<impl_t>(std::move(fun));
+  }
+
+  /// Removes the batch handler, i.e., dispatches each message through the
+  /// behavior again.
+  void unset_batch_handler() noexcept {
+    batch_handler_.reset();
+  }
+
 #ifdef CAF_ENABLE_EXCEPTIONS
   /// Sets a custom exception handler for this actor. If multiple handlers are
   /// defined, only the functor that was added *last* is being executed.
@@ -395,6 +415,11 @@ public:
   /// number of additional times after `activate`.
   activation_result reactivate(mailbox_element& x);
 
+  /// Runs the batch handler on `x` plus all directly following messages that
+  /// belong into the same batch, up to `max_batch_size` messages in total.
+  activation_result run_batch(mailbox_element_ptr x, size_t max_batch_size,
+                              size_t& consumed);
+
   // -- behavior management ----------------------------------------------------
 
   /// Returns `true` if the behavior stack is not empty.
@@ -633,9 +658,16 @@ protected:
   /// Customization point for setting a default `exit_msg` callback.
   exit_handler exit_handler_;
 
+  /// Processes messages of a single type in batches if set. Shared with
+  /// `run_batch`, because the handler may replace or remove itself.
+  std::shared_ptr<detail::batch_handler> batch_handler_;
+
   /// Pointer to a private thread object associated with a detached actor.
   detail::private_thread* private_thread_;
 
+  /// Preferred NUMA node for running this actor or -1 for any node.
+  int numa_node_;
+
 #ifdef CAF_ENABLE_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
@@ -6,6 +6,14 @@
 
 #include "caf/test/test.hpp"
 
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/mailbox_element.hpp"
+
+#include <string>
+#include <vector>
+
 using namespace caf;
 
 #define ASSERT_COMPILES(expr, msg)                                             \
@@ -138,4 +146,120 @@ ASSERT_COMPILES(set_exception_handler(const_exception_fn{}),
 
 #endif // CAF_ENABLE_EXCEPTIONS
 
+// -- batch handlers -----------------------------------------------------------
+
+struct batch_log {
+  std::vector<std::vector<int32_t>> batches;
+  std::vector<std::string> strings;
+};
+
+class batch_testee : public event_based_actor {
+public:
+  batch_testee(actor_config& cfg, batch_log* log)
+    : event_based_actor(cfg), log_(log) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    set_batch_handler<int32_t>([this](span<int32_t> xs) {
+      log_->batches.emplace_back(xs.begin(), xs.end());
+    });
+    return {
+      [this](const std::string& str) { log_->strings.push_back(str); },
+    };
+  }
+
+private:
+  batch_log* log_;
+};
+
+TEST("batch handlers receive consecutive messages of the same type") {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  batch_log log;
+  auto [self, launch] = sys.spawn_inactive<batch_testee>(&log);
+  auto put = [self = self](auto value) {
+    self->mailbox().push_back(
+      make_mailbox_element(nullptr, make_message_id(), std::move(value)));
+  };
+  for (int32_t i = 0; i < 5; ++i)
+    put(i);
+  put(std::string{"hello"});
+  put(int32_t{5});
+  put(int32_t{6});
+  SECTION("the batch ends at the first message of another type") {
+    self->resume(sys.dummy_execution_unit(), 100);
+    using batch = std::vector<int32_t>;
+    check_eq(log.batches, std::vector<batch>{{0, 1, 2, 3, 4}, {5, 6}});
+    check_eq(log.strings, std::vector<std::string>{"hello"});
+  }
+  SECTION("batches never exceed the maximum throughput") {
+    auto res = self->resume(sys.dummy_execution_unit(), 3);
+    check_eq(res, resumable::resume_later);
+    self->resume(sys.dummy_execution_unit(), 100);
+    using batch = std::vector<int32_t>;
+    check_eq(log.batches, std::vector<batch>{{0, 1, 2}, {3, 4}, {5, 6}});
+    check_eq(log.strings, std::vector<std::string>{"hello"});
+  }
+}
+
+class resetting_batch_testee : public event_based_actor {
+public:
+  resetting_batch_testee(actor_config& cfg, batch_log* log, bool replace)
+    : event_based_actor(cfg), log_(log), replace_(replace) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    set_batch_handler<int32_t>([this](span<int32_t> xs) {
+      log_->batches.emplace_back(xs.begin(), xs.end());
+      if (replace_) {
+        set_batch_handler<int32_t>([this](span<int32_t> ys) {
+          for (auto y : ys)
+            log_->strings.push_back(std::to_string(y));
+        });
+      } else {
+        unset_batch_handler();
+      }
+      // Access the captured state after the handler has been replaced.
+      log_->batches.back().push_back(static_cast<int32_t>(xs.size()));
+    });
+    return {
+      [this](int32_t x) {
+        log_->strings.push_back("single " + std::to_string(x));
+      },
+    };
+  }
+
+private:
+  batch_log* log_;
+  bool replace_;
+};
+
+TEST("batch handlers may replace or remove themselves") {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  batch_log log;
+  using batch = std::vector<int32_t>;
+  auto run = [&](bool replace) {
+    auto [self, launch] = sys.spawn_inactive<resetting_batch_testee>(&log,
+                                                                     replace);
+    for (int32_t i = 0; i < 5; ++i)
+      self->mailbox().push_back(
+        make_mailbox_element(nullptr, make_message_id(), i));
+    self->resume(sys.dummy_execution_unit(), 3);
+    self->resume(sys.dummy_execution_unit(), 100);
+  };
+  SECTION("removing the handler dispatches later messages to the behavior") {
+    run(false);
+    check_eq(log.batches, std::vector<batch>{{0, 1, 2, 3}});
+    check_eq(log.strings, std::vector<std::string>{"single 3", "single 4"});
+  }
+  SECTION("replacing the handler passes later messages to the new handler") {
+    run(true);
+    check_eq(log.batches, std::vector<batch>{{0, 1, 2, 3}});
+    check_eq(log.strings, std::vector<std::string>{"3", "4"});
+  }
+}
+
 } // namespace
@@ -10,14 +10,24 @@
 #include "caf/blocking_actor.hpp"
 #include "caf/config.hpp"
 #include "caf/defaults.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/double_ended_queue.hpp"
+#include "caf/detail/eventcount.hpp"
 #include "caf/detail/thread_safe_actor_clock.hpp"
+#include "caf/detail/timer_wheel.hpp"
+#include "caf/detail/unbounded_mpmc_queue.hpp"
+#include "caf/detail/work_stealing_queue.hpp"
+#include "caf/log/system.hpp"
 #include "caf/logger.hpp"
+#include "caf/make_counted.hpp"
 #include "caf/scheduled_actor.hpp"
 #include "caf/scoped_actor.hpp"
 #include "caf/send.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 #include "caf/thread_owner.hpp"
 
+#include <algorithm>
 #include <condition_variable>
 #include <fstream>
 #include <ios>
@@ -192,6 +202,7 @@ public:
 namespace work_stealing {
 
 // Holds job queue of a worker and a random number generator.
+template <class Queue>
 struct worker_data {
   // Configuration for aggressive/moderate/relaxed poll strategies.
   struct poll_strategy {
@@ -224,39 +235,121 @@ struct worker_data {
           get_or(p->config(), "caf.work-stealing.relaxed-steal-interval",
                  defaults::work_stealing::relaxed_steal_interval),
           get_or(p->config(), "caf.work-stealing.relaxed-sleep-duration",
-                 defaults::work_stealing::relaxed_sleep_duration)}}} {
+                 defaults::work_stealing::relaxed_sleep_duration)}}},
+      steal_buf(std::max(get_or(p->config(),
+                                "caf.work-stealing.steal-batch-size",
+                                defaults::work_stealing::steal_batch_size),
+                         size_t{1})) {
     // nop
   }
 
   worker_data(const worker_data& other)
     : rengine(std::random_device{}()),
       uniform(other.uniform),
-      strategies(other.strategies) {
+      strategies(other.strategies),
+      steal_buf(other.steal_buf.size()),
+      siblings(other.siblings),
+      idle_workers(other.idle_workers),
+      searching_workers(other.searching_workers),
+      wake_pending(other.wake_pending),
+      local_timers(other.local_timers),
+      timer_resolution(other.timer_resolution) {
     // nop
   }
 
   // This queue is exposed to other workers that may attempt to steal jobs
   // from it and the central scheduling unit can push new jobs to the queue.
-  detail::double_ended_queue<resumable> queue;
+  Queue queue;
 
   // Needed to generate pseudo random numbers.
   std::default_random_engine rengine;
   std::uniform_int_distribution<size_t> uniform;
   std::array<poll_strategy, 3> strategies;
+
+  // Receives stolen jobs. The size of this buffer limits how many jobs a
+  // worker may steal at once.
+  std::vector<resumable*> steal_buf;
+
+  // IDs of workers that share a cache with this worker. Thieves prefer
+  // stealing from siblings, because the stolen jobs are more likely to find
+  // their data in a shared cache.
+  std::vector<size_t> siblings;
+
+  // CPUs this worker may run on or an empty list for "any CPU".
+  std::vector<size_t> cpus;
+
+  // NUMA node of the worker. Only meaningful if `cpus` is not empty.
+  size_t numa_node = 0;
+
+  // Allows idle workers to sleep until new jobs arrive. Workers fall back to
+  // the moderate and relaxed poll strategies if this pointer is `nullptr`.
+  detail::eventcount* idle_workers = nullptr;
+
+  // Counts workers that ran out of jobs and look for new jobs before parking.
+  // While this counter is positive, enqueueing a job wakes no other worker.
+  std::atomic<size_t>* searching_workers = nullptr;
+
+  // Signals that a worker received a wake-up but did not start searching yet.
+  // Stays set until a worker enters the search phase, which keeps a burst of
+  // jobs from waking more than one worker.
+  std::atomic<bool>* wake_pending = nullptr;
+
+  // Configures whether the worker runs timeouts that its jobs schedule on a
+  // local timer wheel instead of passing them to the clock thread.
+  bool local_timers = false;
+
+  // Length of a single tick of the local timer wheel.
+  timespan timer_resolution = defaults::clock::wheel_resolution;
 };
 
 /// Implementation of the work stealing worker class.
+template <class Queue>
 class worker : public execution_unit {
 public:
   using job_ptr = resumable*;
 
-  worker(size_t worker_id, scheduler* worker_parent, const worker_data& init,
+  using data_type = worker_data<Queue>;
+
+  using timer_entry = detail::thread_safe_actor_clock::schedule_entry;
+
+  using timer_wheel_type
+    = detail::timer_wheel<timer_entry,
+                          detail::thread_safe_actor_clock::entry_deleter>;
+
+  using cancellation_queue_ptr
+    = detail::thread_safe_actor_clock::cancellation_queue_ptr;
+
+  worker(size_t worker_id, scheduler* worker_parent, const data_type& init,
          size_t throughput)
     : execution_unit(&worker_parent->system()),
       max_throughput_(throughput),
+      parent_(worker_parent),
       id_(worker_id),
       data_(init) {
-    // nop
+    if (init.local_timers) {
+      timers_ = std::make_unique<timer_wheel_type>(
+        actor_clock::clock_type::now(), init.timer_resolution);
+      cancellations_
+        = make_counted<detail::thread_safe_actor_clock::cancellation_queue>();
+    }
+    auto& reg = system().metrics();
+    auto id_str = std::to_string(worker_id);
+    auto enqueued_jobs = reg.counter_family(
+      "caf.scheduler", "enqueued-jobs", {"origin", "worker"},
+      "Number of jobs that arrived at a worker through the scheduler.", "1",
+      true);
+    local_enqueues_ = enqueued_jobs->get_or_add(
+      {{"origin", "local"}, {"worker", id_str}});
+    external_enqueues_ = enqueued_jobs->get_or_add(
+      {{"origin", "external"}, {"worker", id_str}});
+    stolen_enqueues_ = enqueued_jobs->get_or_add(
+      {{"origin", "stolen"}, {"worker", id_str}});
+  }
+
+  ~worker() {
+    // Breaks the cycle between the queue and its entries.
+    if (cancellations_)
+      cancellations_->close();
   }
 
   worker(const worker&) = delete;
@@ -274,26 +367,47 @@ public:
   /// source, i.e., from any other thread.
   void external_enqueue(job_ptr job) {
     CAF_ASSERT(job != nullptr);
+    external_enqueues_->inc();
     data_.queue.append(job);
+    wake_idle_worker();
+  }
+
+  /// Enqueues a new job that the scheduler received from a job that is
+  /// currently executed by this worker.
+  /// @warning Must not be called from other threads.
+  void local_enqueue(job_ptr job) {
+    CAF_ASSERT(job != nullptr);
+    local_enqueues_->inc();
+    data_.queue.prepend(job);
+    wake_idle_worker();
   }
 
   /// Enqueues a new job to the worker's queue from an internal
   /// source, i.e., a job that is currently executed by this worker.
   /// @warning Must not be called from other threads.
   void exec_later(job_ptr job) override {
-    CAF_ASSERT(job != nullptr);
-    data_.queue.prepend(job);
+    local_enqueue(job);
   }
 
   size_t id() const {
     return id_;
   }
 
+  scheduler* parent() const noexcept {
+    return parent_;
+  }
+
+  /// Returns the worker that runs on the calling thread or `nullptr` if the
+  /// calling thread is not a worker thread.
+  static worker* current() noexcept {
+    return current_;
+  }
+
   std::thread& get_thread() {
     return this_thread_;
   }
 
-  worker_data& data() {
+  data_type& data() {
     return data_;
   }
 
@@ -301,7 +415,72 @@ public:
     return max_throughput_;
   }
 
+  /// Schedules `f` for execution at `t` on this worker.
+  /// @pre `data().local_timers`
+  /// @warning Must not be called from other threads.
+  disposable schedule_local(actor_clock::time_point t, action f) {
+    CAF_ASSERT(timers_ != nullptr);
+    auto* ptr = new timer_entry(t, std::move(f), cancellations_);
+    auto result = ptr->as_disposable();
+    timers_->insert(typename timer_wheel_type::entry_ptr{ptr});
+    return result;
+  }
+
 private:
+  // Runs all local timeouts that expired. The actions usually enqueue jobs to
+  // this worker.
+  void run_timers() {
+    if (!timers_)
+      return;
+    cancellations_->drain([this](timer_entry* x) {
+      if (x->linked())
+        timers_->erase(x);
+    });
+    if (timers_->empty())
+      return;
+    timers_->advance(actor_clock::clock_type::now(),
+                     [](auto& x) { x->f.run(); });
+    timers_->sweep();
+  }
+
+  // Caps `max_sleep` to make sure the worker wakes up for its next local
+  // timeout.
+  timespan sleep_duration(timespan max_sleep) {
+    if (!timers_ || timers_->empty())
+      return max_sleep;
+    auto delta = timers_->next_timeout() - actor_clock::clock_type::now();
+    auto ns = std::chrono::duration_cast<timespan>(delta);
+    return std::clamp(ns, timespan{0}, max_sleep);
+  }
+
+  // Wakes up a sleeping worker (if any) that may steal the new job, unless
+  // another worker already searches for jobs or is about to.
+  void wake_idle_worker() {
+    if (data_.idle_workers == nullptr)
+      return;
+    // Pairs with the fence in `prepare_wait`: either we see the searching
+    // worker or the worker sees the new job in its final check.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (data_.searching_workers->load() > 0 || data_.wake_pending->load())
+      return;
+    if (!data_.wake_pending->exchange(true))
+      data_.idle_workers->notify_one();
+  }
+
+  // Counts this worker as searching and consumes any pending wake-up.
+  void start_searching() {
+    data_.searching_workers->fetch_add(1);
+    data_.wake_pending->store(false);
+  }
+
+  // Stops counting this worker as searching after it found a job. The last
+  // searching worker passes the search on to a parked worker, because more
+  // jobs may have arrived without waking anyone.
+  void stop_searching() {
+    if (data_.searching_workers->fetch_sub(1) == 1)
+      wake_idle_worker();
+  }
+
   // Goes on a raid in quest for a shiny new job.
   template <typename Parent>
   resumable* try_steal(Parent* p) {
@@ -309,12 +488,39 @@ private:
       // You can't steal from yourthis, can you?
       return nullptr;
     }
+    // Try a sibling first, since its jobs probably have their data in a cache
+    // that we share.
+    auto& siblings = data_.siblings;
+    if (!siblings.empty()) {
+      auto victim = siblings[data_.rengine() % siblings.size()];
+      if (auto* job = steal_from(p->worker_by_id(victim)))
+        return job;
+    }
     // Roll the dice to pick a victim other than ourselves.
     auto victim = data_.uniform(data_.rengine);
     if (victim == this->id())
       victim = p->num_workers() - 1;
-    // Steal oldest element from the victim's queue.
-    return p->worker_by_id(victim)->data_.queue.try_take_tail();
+    return steal_from(p->worker_by_id(victim));
+  }
+
+  // Steals the oldest job from `victim`. If enabled, also moves up to half of
+  // the remaining jobs of `victim` to our own queue.
+  resumable* steal_from(worker* victim) {
+    auto& buf = data_.steal_buf;
+    if (buf.size() == 1)
+      return victim->data_.queue.try_take_tail();
+    auto count = victim->data_.queue.try_take_tail_half(buf.data(),
+                                                        buf.size());
+    if (count == 0)
+      return nullptr;
+    // Push the stolen jobs in reverse order to run the oldest job first.
+    for (auto i = count - 1; i > 0; --i)
+      data_.queue.prepend(buf[i]);
+    if (count > 1) {
+      stolen_enqueues_->inc(static_cast<int64_t>(count - 1));
+      wake_idle_worker();
+    }
+    return buf[0];
   }
 
   template <typename Parent>
@@ -323,9 +529,12 @@ private:
     // active work load on the machine and perform aggressive polling, then we
     // relax our polling a bit and wait 50us between dequeue attempts.
     auto& strategies = data_.strategies;
+    run_timers();
     auto* job = data_.queue.try_take_head();
     if (job)
       return job;
+    if (data_.idle_workers != nullptr)
+      return park_dequeue(parent);
     for (size_t k = 0; k < 2; ++k) { // Iterate over the first two strategies.
       for (size_t i = 0; i < strategies[k].attempts;
            i += strategies[k].step_size) {
@@ -336,9 +545,11 @@ private:
             return job;
         }
         // Wait for some work to appear.
-        job = data_.queue.try_take_head(strategies[k].sleep_duration);
+        job = data_.queue.try_take_head(
+          sleep_duration(strategies[k].sleep_duration));
         if (job)
           return job;
+        run_timers();
       }
     }
     // We assume pretty much nothing is going on so we can relax polling
@@ -346,14 +557,95 @@ private:
     // of the relaxed polling strategy
     auto& relaxed = strategies[2];
     do {
-      job = data_.queue.try_take_head(relaxed.sleep_duration);
+      job = data_.queue.try_take_head(sleep_duration(relaxed.sleep_duration));
+      if (job == nullptr) {
+        run_timers();
+        job = data_.queue.try_take_head();
+      }
     } while (job == nullptr);
     return job;
   }
 
+  // Polls aggressively for a while and then sleeps until another thread
+  // enqueues a new job.
+  template <typename Parent>
+  resumable* park_dequeue(Parent* parent) {
+    auto& aggressive = data_.strategies[0];
+    auto& idle_workers = *data_.idle_workers;
+    start_searching();
+    for (;;) {
+      run_timers();
+      for (size_t i = 0; i < aggressive.attempts; ++i) {
+        if ((i % aggressive.steal_interval) == 0) {
+          if (auto* job = try_steal(parent)) {
+            stop_searching();
+            return job;
+          }
+        }
+        if (auto* job = data_.queue.try_take_head()) {
+          stop_searching();
+          return job;
+        }
+      }
+      // Announce that we are going to sleep and then check all queues one
+      // last time. Any job that arrives after this check wakes us up again.
+      auto was_last = data_.searching_workers->fetch_sub(1) == 1;
+      auto key = idle_workers.prepare_wait();
+      if (auto* job = try_take_any(parent)) {
+        idle_workers.cancel_wait();
+        // Pass the search on like `stop_searching`, since more jobs may have
+        // arrived without waking anyone.
+        auto pending = data_.wake_pending->exchange(false);
+        if (was_last || pending)
+          wake_idle_worker();
+        return job;
+      }
+      if (has_pending_jobs(parent) || data_.wake_pending->exchange(false)) {
+        // Lost a race against another thief or received a wake-up before
+        // parking. Try again.
+        idle_workers.cancel_wait();
+        start_searching();
+        continue;
+      }
+      // Sleep no longer than until the next local timeout.
+      if (timers_ && !timers_->empty())
+        idle_workers.wait_until(key, timers_->next_timeout());
+      else
+        idle_workers.wait(key);
+      start_searching();
+    }
+  }
+
+  // Checks our own queue and tries to steal from all other workers.
+  template <typename Parent>
+  resumable* try_take_any(Parent* p) {
+    if (auto* job = data_.queue.try_take_head())
+      return job;
+    auto num = p->num_workers();
+    for (size_t i = 1; i < num; ++i) {
+      auto victim = (id_ + i) % num;
+      if (auto* job = p->worker_by_id(victim)->data_.queue.try_take_tail())
+        return job;
+    }
+    return nullptr;
+  }
+
+  // Checks whether any worker has at least one job in its queue.
+  template <typename Parent>
+  bool has_pending_jobs(Parent* p) {
+    auto num = p->num_workers();
+    for (size_t i = 0; i < num; ++i)
+      if (p->worker_by_id(i)->data_.queue.size() > 0)
+        return true;
+    return false;
+  }
+
   template <typename Parent>
   void run(Parent* parent) {
     CAF_SET_LOGGER_SYS(&system());
+    current_ = this;
+    if (!data_.cpus.empty() && !detail::set_thread_affinity(data_.cpus))
+      log::system::warning("failed to pin worker {} to its CPUs", id_);
     // scheduling loop
     for (;;) {
       auto job = policy_dequeue(parent);
@@ -383,29 +675,100 @@ private:
       }
     }
   }
+  // Points to the worker that runs on this thread.
+  static inline thread_local worker* current_ = nullptr;
+
   // Number of messages each actor is allowed to consume per resume.
   size_t max_throughput_;
 
   // The worker's thread.
   std::thread this_thread_;
 
+  // The scheduler that owns this worker.
+  scheduler* parent_;
+
   // The worker's ID received from scheduler.
   size_t id_;
 
   // Policy-specific data.
-  worker_data data_;
+  data_type data_;
+
+  // Counts jobs that this worker enqueued via the scheduler.
+  telemetry::int_counter* local_enqueues_;
+
+  // Counts jobs that other threads enqueued to this worker.
+  telemetry::int_counter* external_enqueues_;
+
+  // Counts jobs that this worker moved to its own queue while stealing.
+  telemetry::int_counter* stolen_enqueues_;
+
+  // Stores timeouts that jobs on this worker scheduled. Only set if the
+  // scheduler runs timeouts on its workers.
+  std::unique_ptr<timer_wheel_type> timers_;
+
+  // Receives timeouts from `timers_` that other threads disposed.
+  cancellation_queue_ptr cancellations_;
 };
 
 /// Policy-based implementation of the scheduler base class.
+template <class Queue>
 class scheduler_impl : public scheduler {
 public:
   using super = scheduler;
 
   scheduler_impl(actor_system& sys) : super(sys) {
-    // nop
+    using defaults::work_stealing::external_enqueue;
+    auto str = get_or(sys.config(), "caf.work-stealing.external-enqueue",
+                      external_enqueue);
+    if (str == "least-loaded") {
+      least_loaded_ = true;
+    } else if (str != "round-robin") {
+      fprintf(stderr,
+              "[WARNING] '%s' is an unrecognized external enqueue strategy, "
+              "falling back to 'round-robin'\n",
+              str.c_str());
+    }
+    numa_aware_ = get_or(sys.config(), "caf.work-stealing.numa-aware",
+                         defaults::work_stealing::numa_aware);
+    using defaults::work_stealing::idle_strategy;
+    str = get_or(sys.config(), "caf.work-stealing.idle-strategy",
+                 idle_strategy);
+    if (str == "polling") {
+      park_idle_workers_ = false;
+    } else if (str != "parking") {
+      fprintf(stderr,
+              "[WARNING] '%s' is an unrecognized idle strategy, falling back "
+              "to 'parking'\n",
+              str.c_str());
+    }
+    worker_timers_ = get_or(sys.config(), "caf.work-stealing.worker-timers",
+                            defaults::work_stealing::worker_timers);
+    timer_resolution_ = get_or(sys.config(), "caf.clock.wheel-resolution",
+                               defaults::clock::wheel_resolution);
   }
 
-  using worker_type = worker;
+  using worker_type = worker<Queue>;
+
+  /// Runs timeouts on the timer wheel of the current worker if called from
+  /// one of our workers. Otherwise, passes timeouts to the system-wide clock.
+  class worker_clock : public actor_clock {
+  public:
+    explicit worker_clock(scheduler_impl* parent) : parent_(parent) {
+      // nop
+    }
+
+    using actor_clock::schedule;
+
+    disposable schedule(time_point t, action f) override {
+      auto* self = worker_type::current();
+      if (self != nullptr && self->parent() == parent_)
+        return self->schedule_local(t, std::move(f));
+      return parent_->clock_.schedule(t, std::move(f));
+    }
+
+  private:
+    scheduler_impl* parent_;
+  };
 
   worker_type* worker_by_id(size_t x) {
     return workers_[x].get();
@@ -414,17 +777,47 @@ public:
   // -- implementation of scheduler interface ----------------------------------
 
   void enqueue(resumable* ptr) override {
-    auto w = this->worker_by_id(next_worker++ % this->num_workers());
-    w->external_enqueue(ptr);
+    // Jobs from one of our workers stay on that worker to keep caches warm.
+    if (auto* self = worker_type::current(); self && self->parent() == this) {
+      self->local_enqueue(ptr);
+      return;
+    }
+    select_worker()->external_enqueue(ptr);
   }
 
-  detail::thread_safe_actor_clock& clock() noexcept override {
+  void enqueue_on_node(resumable* ptr, int numa_node) override {
+    auto node = static_cast<size_t>(numa_node);
+    if (numa_node < 0 || node >= node_workers_.size()
+        || node_workers_[node].empty()) {
+      enqueue(ptr);
+      return;
+    }
+    if (auto* self = worker_type::current();
+        self && self->parent() == this && self->data().numa_node == node) {
+      self->local_enqueue(ptr);
+      return;
+    }
+    auto& group = node_workers_[node];
+    auto idx = next_worker.fetch_add(1, std::memory_order_relaxed);
+    worker_by_id(group[idx % group.size()])->external_enqueue(ptr);
+  }
+
+  actor_clock& clock() noexcept override {
+    if (worker_timers_)
+      return worker_clock_;
     return clock_;
   }
 
   void start() override {
     // Create initial state for all workers.
-    worker_data init{this};
+    typename worker_type::data_type init{this};
+    if (park_idle_workers_) {
+      init.idle_workers = &idle_workers_;
+      init.searching_workers = &searching_workers_;
+      init.wake_pending = &wake_pending_;
+    }
+    init.local_timers = worker_timers_;
+    init.timer_resolution = timer_resolution_;
     // Prepare workers vector.
     auto num = num_workers();
     workers_.reserve(num);
@@ -432,6 +825,17 @@ public:
     for (size_t i = 0; i < num; ++i)
       workers_.emplace_back(
         std::make_unique<worker_type>(i, this, init, max_throughput_));
+    if (numa_aware_) {
+      auto path = get_or(system().config(),
+                         "caf.work-stealing.numa-topology-path",
+                         defaults::work_stealing::numa_topology_path);
+      auto topo = detail::cpu_topology::read(path);
+      // Never pin workers to CPUs that the process may not use, e.g., because
+      // of `taskset` or the cpuset of a container.
+      if (auto allowed = detail::thread_affinity())
+        topo.restrict_to(*allowed);
+      apply_topology(topo);
+    }
     // Start all workers.
     for (auto& w : workers_)
       w->start(this);
@@ -502,15 +906,90 @@ public:
   }
 
 private:
+  // Pins each worker to one CPU and groups workers by NUMA node. Assigns
+  // workers to the CPUs of `topo` in round-robin order. Nodes without CPUs get
+  // no workers.
+  void apply_topology(const detail::cpu_topology& topo) {
+    std::vector<std::pair<size_t, size_t>> cpus; // (node, cpu)
+    for (size_t node = 0; node < topo.nodes.size(); ++node)
+      for (auto cpu : topo.nodes[node])
+        cpus.emplace_back(node, cpu);
+    node_workers_.clear();
+    node_workers_.resize(topo.nodes.size());
+    for (size_t id = 0; id < workers_.size(); ++id) {
+      auto [node, cpu] = cpus[id % cpus.size()];
+      auto& data = workers_[id]->data();
+      data.numa_node = node;
+      data.cpus.assign(1, cpu);
+      node_workers_[node].push_back(id);
+    }
+    for (auto& group : node_workers_) {
+      for (auto id : group) {
+        auto& siblings = workers_[id]->data().siblings;
+        siblings.clear();
+        for (auto other : group)
+          if (other != id)
+            siblings.push_back(other);
+      }
+    }
+  }
+
+  // Picks a worker for a job from a thread outside of this scheduler.
+  worker_type* select_worker() {
+    auto num = num_workers();
+    auto first = next_worker.fetch_add(1, std::memory_order_relaxed) % num;
+    if (!least_loaded_ || num < 2)
+      return worker_by_id(first);
+    // Use the power of two choices: compare the queue sizes of two workers
+    // instead of scanning all of them.
+    thread_local std::minstd_rand rengine{std::random_device{}()};
+    auto second = (first + 1 + rengine() % (num - 1)) % num;
+    auto* w1 = worker_by_id(first);
+    auto* w2 = worker_by_id(second);
+    return w1->data().queue.size() <= w2->data().queue.size() ? w1 : w2;
+  }
+
   /// System-wide clock.
   detail::thread_safe_actor_clock clock_;
 
+  /// Dispatches timeouts to the workers if `worker_timers_` is set.
+  worker_clock worker_clock_{this};
+
+  /// Configures whether workers run timeouts of their jobs on a local timer
+  /// wheel.
+  bool worker_timers_ = false;
+
+  /// Length of a single tick of the local timer wheels.
+  timespan timer_resolution_;
+
   /// Set of workers.
   std::vector<std::unique_ptr<worker_type>> workers_;
 
   /// Next worker.
   std::atomic<size_t> next_worker = 0;
 
+  /// Configures whether `select_worker` picks the worker with fewer jobs.
+  bool least_loaded_ = false;
+
+  /// Configures whether workers run pinned and grouped by NUMA node.
+  bool numa_aware_ = false;
+
+  /// Lists the IDs of all workers per NUMA node.
+  std::vector<std::vector<size_t>> node_workers_;
+
+  /// Configures whether idle workers sleep on `idle_workers_` instead of
+  /// polling their queue periodically.
+  bool park_idle_workers_ = true;
+
+  /// Allows idle workers to sleep until new jobs arrive.
+  detail::eventcount idle_workers_;
+
+  /// Number of workers that look for jobs before parking.
+  std::atomic<size_t> searching_workers_ = 0;
+
+  /// Set while a parked worker received a wake-up but did not start searching.
+  std::atomic<bool> wake_pending_ = false;
+
   /// Thread for managing timeouts and delayed messages.
   std::thread timer_;
 };
@@ -617,18 +1096,20 @@ public:
   using worker_type = worker<scheduler_impl>;
 
   // A thread-safe queue implementation.
-  using queue_type = std::list<resumable*>;
+  using queue_type = detail::unbounded_mpmc_queue<resumable>;
 
-  scheduler_impl(actor_system& sys) : super(sys) {
+  scheduler_impl(actor_system& sys)
+    : super(sys),
+      queue(std::max(get_or(sys.config(), "caf.work-sharing.segment-size",
+                            defaults::work_sharing::segment_size),
+                     size_t{1})) {
     // nop
   }
 
   void enqueue(resumable* ptr) override {
-    queue_type l;
-    l.push_back(ptr);
-    std::unique_lock<std::mutex> guard(lock);
-    queue.splice(queue.end(), l);
-    cv.notify_one();
+    queue.push(ptr);
+    // Only touches the mutex of the eventcount if a worker actually sleeps.
+    idle_workers.notify_one();
   }
 
   detail::thread_safe_actor_clock& clock() noexcept override {
@@ -709,11 +1190,16 @@ public:
   }
 
   resumable* dequeue() {
-    std::unique_lock<std::mutex> guard(lock);
-    cv.wait(guard, [&] { return !queue.empty(); });
-    resumable* job = queue.front();
-    queue.pop_front();
-    return job;
+    for (;;) {
+      if (auto* job = queue.try_pop())
+        return job;
+      auto key = idle_workers.prepare_wait();
+      if (auto* job = queue.try_pop()) {
+        idle_workers.cancel_wait();
+        return job;
+      }
+      idle_workers.wait(key);
+    }
   }
 
 private:
@@ -723,16 +1209,7 @@ private:
 
   template <class UnaryFunction>
   void foreach_central_resumable(UnaryFunction f) {
-    auto next = [&]() -> resumable* {
-      if (queue.empty()) {
-        return nullptr;
-      }
-      auto front = queue.front();
-      queue.pop_front();
-      return front;
-    };
-    std::unique_lock<std::mutex> guard(lock);
-    for (auto job = next(); job != nullptr; job = next()) {
+    for (auto job = queue.try_pop(); job != nullptr; job = queue.try_pop()) {
       f(job);
     }
   }
@@ -745,9 +1222,8 @@ private:
 
   queue_type queue;
 
-  std::mutex lock;
-
-  std::condition_variable cv;
+  /// Allows idle workers to sleep until new jobs arrive.
+  detail::eventcount idle_workers;
 
   /// Thread for managing timeouts and delayed messages.
   std::thread timer_;
@@ -760,7 +1236,20 @@ private:
 // -- factory functions ------------------------------------------------------
 
 std::unique_ptr<scheduler> scheduler::make_work_stealing(actor_system& sys) {
-  return std::make_unique<work_stealing::scheduler_impl>(sys);
+  using defaults::work_stealing::queue;
+  auto config_queue = get_or(sys.config(), "caf.work-stealing.queue", queue);
+  if (config_queue == "locking") {
+    using queue_type = detail::double_ended_queue<resumable>;
+    return std::make_unique<work_stealing::scheduler_impl<queue_type>>(sys);
+  }
+  // Any invalid configuration falls back to the lock-free queue.
+  if (config_queue != "lock-free")
+    fprintf(stderr,
+            "[WARNING] '%s' is an unrecognized work-stealing queue, falling "
+            "back to 'lock-free'\n",
+            config_queue.c_str());
+  using queue_type = detail::work_stealing_queue<resumable>;
+  return std::make_unique<work_stealing::scheduler_impl<queue_type>>(sys);
 }
 
 std::unique_ptr<scheduler> scheduler::make_work_sharing(actor_system& sys) {
@@ -780,6 +1269,10 @@ scheduler::~scheduler() {
 
 // -- default implementation of scheduler --------------------------------------
 
+void scheduler::enqueue_on_node(resumable* what, int) {
+  enqueue(what);
+}
+
 void scheduler::start() {
   auto lg = log::core::trace("");
   // Launch print utility actors.
@@ -32,6 +32,11 @@ public:
   /// Puts `what` into the queue of a randomly chosen worker.
   virtual void enqueue(resumable* what) = 0;
 
+  /// Puts `what` into the queue of a worker on the NUMA node `numa_node`.
+  /// Falls back to `enqueue` if the scheduler has no worker on that node or
+  /// does not group its workers by NUMA node.
+  virtual void enqueue_on_node(resumable* what, int numa_node);
+
   virtual actor_clock& clock() noexcept = 0;
 
   virtual void start();
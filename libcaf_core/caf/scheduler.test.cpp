@@ -6,11 +6,23 @@
 
 #include "caf/test/outline.hpp"
 
+#include "caf/action.hpp"
+#include "caf/actor_clock.hpp"
 #include "caf/actor_system_config.hpp"
+#include "caf/detail/cpu_topology.hpp"
 #include "caf/detail/latch.hpp"
+#include "caf/event_based_actor.hpp"
 #include "caf/resumable.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/spawn_options.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
 #include <string>
+#include <thread>
 
 using namespace caf;
 using namespace std::literals;
@@ -27,8 +39,8 @@ struct testee : resumable, ref_counted {
   }
   resume_result resume(execution_unit*, size_t max_throughput) override {
     if (++runs == 10) {
-      rendesvous->count_down();
       received_throughput = max_throughput;
+      rendesvous->count_down();
       return resumable::done;
     }
     return resumable::resume_later;
@@ -44,13 +56,22 @@ struct testee : resumable, ref_counted {
   std::shared_ptr<latch> rendesvous;
 };
 
+// The scheduler releases its reference only after the last call to `resume`
+// returned, i.e., after the job counted down its latch.
+template <class Job>
+void await_release(const Job& job) {
+  while (job.get_reference_count() > 1)
+    std::this_thread::yield();
+}
+
 OUTLINE("scheduling resumables") {
-  GIVEN("an actor system using the work <sched> scheduler") {
-    auto sched = block_parameters<std::string>();
+  GIVEN("an actor system using <sched> scheduling with <queue> queues") {
+    auto [sched, queue] = block_parameters<std::string, std::string>();
     actor_system_config cfg;
     cfg.set("caf.scheduler.max-throughput", 5);
     cfg.set("caf.scheduler.max-threads", 2);
     cfg.set("caf.scheduler.policy", sched);
+    cfg.set("caf.work-stealing.queue", queue);
     actor_system sys(cfg);
     auto& sut = sys.scheduler();
     WHEN("scheduling a resumable") {
@@ -66,6 +87,7 @@ OUTLINE("scheduling resumables") {
         check_eq(worker->received_throughput, 5u);
       }
       AND_THEN("the scheduler releases the ref when done") {
+        await_release(*worker);
         check_eq(worker->get_reference_count(), 1u);
       }
     }
@@ -90,15 +112,18 @@ OUTLINE("scheduling resumables") {
           check_eq(worker->received_throughput, 5u);
       }
       AND_THEN("the scheduler releases the ref when done") {
-        for (const auto& worker : workers)
+        for (const auto& worker : workers) {
+          await_release(*worker);
           check_eq(worker->get_reference_count(), 1u);
+        }
       }
     }
   }
   EXAMPLES = R"(
-    |    sched    |
-    | sharing     |
-    | stealing    |
+    |    sched    |   queue     |
+    | sharing     | lock-free   |
+    | stealing    | lock-free   |
+    | stealing    | locking     |
   )";
 }
 
@@ -125,10 +150,11 @@ struct awaiting_testee : resumable, ref_counted {
 };
 
 OUTLINE("scheduling units that are awaiting") {
-  GIVEN("an actor system using the work <sched> scheduler") {
-    auto sched = block_parameters<std::string>();
+  GIVEN("an actor system using <sched> scheduling with <queue> queues") {
+    auto [sched, queue] = block_parameters<std::string, std::string>();
     actor_system_config cfg;
     cfg.set("caf.scheduler.policy", sched);
+    cfg.set("caf.work-stealing.queue", queue);
     cfg.set("caf.scheduler.max-threads", 2);
     cfg.set("caf.scheduler.max-throughput", 5);
     actor_system sys(cfg);
@@ -148,16 +174,431 @@ OUTLINE("scheduling units that are awaiting") {
         }
       }
       AND_THEN("the scheduler releases the ref when done") {
-        for (const auto& worker : workers)
+        for (const auto& worker : workers) {
+          await_release(*worker);
           check_eq(worker->get_reference_count(), 1u);
+        }
+      }
+    }
+  }
+  EXAMPLES = R"(
+    |    sched    |   queue     |
+    | sharing     | lock-free   |
+    | stealing    | lock-free   |
+    | stealing    | locking     |
+  )";
+}
+
+struct timer_testee : resumable, ref_counted {
+  timer_testee(actor_clock& clock, std::shared_ptr<latch> latch_handle)
+    : clock(clock), rendesvous(std::move(latch_handle)) {
+  }
+  subtype_t subtype() const override {
+    return resumable::function_object;
+  }
+  resume_result resume(execution_unit*, size_t) override {
+    resumed_on = std::this_thread::get_id();
+    clock.schedule(clock.now() + 1ms, make_action([this] {
+                     fired_on = std::this_thread::get_id();
+                     rendesvous->count_down();
+                   }));
+    return resumable::done;
+  }
+  void intrusive_ptr_add_ref_impl() override {
+    ref();
+  }
+  void intrusive_ptr_release_impl() override {
+    deref();
+  }
+  actor_clock& clock;
+  std::thread::id resumed_on;
+  std::thread::id fired_on;
+  std::shared_ptr<latch> rendesvous;
+};
+
+SCENARIO("workers may run the timeouts of their jobs") {
+  GIVEN("an actor system with worker timers") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.work-stealing.worker-timers", true);
+    actor_system sys(cfg);
+    WHEN("a job schedules a timeout") {
+      THEN("the timeout fires on the worker that ran the job") {
+        auto rendesvous = std::make_shared<latch>(2);
+        auto job = make_counted<timer_testee>(sys.clock(), rendesvous);
+        job->ref();
+        sys.scheduler().enqueue(job.get());
+        rendesvous->count_down_and_wait();
+        check_ne(job->resumed_on, std::thread::id{});
+        check_eq(job->fired_on, job->resumed_on);
+      }
+    }
+    WHEN("a thread outside of the scheduler schedules a timeout") {
+      THEN("the timeout fires on the clock thread") {
+        detail::latch done{2};
+        auto caller = std::this_thread::get_id();
+        auto fired_on = caller;
+        auto& clock = sys.clock();
+        clock.schedule(clock.now() + 1ms, make_action([&fired_on, &done] {
+                         fired_on = std::this_thread::get_id();
+                         done.count_down();
+                       }));
+        done.count_down_and_wait();
+        check_ne(fired_on, caller);
+      }
+    }
+  }
+}
+
+struct burst_testee : resumable, ref_counted {
+  burst_testee(std::vector<intrusive_ptr<awaiting_testee>> jobs)
+    : jobs(std::move(jobs)) {
+  }
+  subtype_t subtype() const override {
+    return resumable::function_object;
+  }
+  resume_result resume(execution_unit* ctx, size_t) override {
+    for (auto& job : jobs) {
+      job->ref();
+      ctx->exec_later(job.get());
+    }
+    return resumable::done;
+  }
+  void intrusive_ptr_add_ref_impl() override {
+    ref();
+  }
+  void intrusive_ptr_release_impl() override {
+    deref();
+  }
+  std::vector<intrusive_ptr<awaiting_testee>> jobs;
+};
+
+SCENARIO("parked workers pick up bursts of local jobs") {
+  GIVEN("an actor system with parking work-stealing workers") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 4);
+    cfg.set("caf.work-stealing.idle-strategy", "parking");
+    actor_system sys(cfg);
+    WHEN("a job enqueues many jobs from a worker while others sleep") {
+      THEN("the scheduler runs all jobs") {
+        for (int round = 0; round < 20; ++round) {
+          // Give the workers time to park.
+          std::this_thread::sleep_for(1ms);
+          auto rendesvous = std::make_shared<latch>(33);
+          auto jobs = std::vector<intrusive_ptr<awaiting_testee>>{};
+          for (int i = 0; i < 32; ++i)
+            jobs.push_back(make_counted<awaiting_testee>(rendesvous));
+          auto burst = make_counted<burst_testee>(jobs);
+          burst->ref();
+          sys.scheduler().enqueue(burst.get());
+          rendesvous->count_down_and_wait();
+          for (const auto& job : jobs)
+            check_eq(job->runs, 1u);
+        }
+      }
+    }
+  }
+}
+
+struct function_testee : resumable, ref_counted {
+  explicit function_testee(std::function<void(execution_unit*)> fn)
+    : fn(std::move(fn)) {
+  }
+  subtype_t subtype() const override {
+    return resumable::function_object;
+  }
+  resume_result resume(execution_unit* ctx, size_t) override {
+    fn(ctx);
+    return resumable::done;
+  }
+  void intrusive_ptr_add_ref_impl() override {
+    ref();
+  }
+  void intrusive_ptr_release_impl() override {
+    deref();
+  }
+  std::function<void(execution_unit*)> fn;
+};
+
+resumable* make_job(std::function<void(execution_unit*)> fn) {
+  auto job = make_counted<function_testee>(std::move(fn));
+  // The scheduler releases this reference once the job is done.
+  job->ref();
+  return job.get();
+}
+
+int64_t enqueued_jobs(actor_system& sys, std::string_view origin,
+                      size_t worker) {
+  auto id = std::to_string(worker);
+  auto* fam = sys.metrics().counter_family("caf.scheduler", "enqueued-jobs",
+                                           {"origin", "worker"}, "", "1", true);
+  return fam->get_or_add({{"origin", origin}, {"worker", id}})->value();
+}
+
+SCENARIO("jobs from workers stay local to that worker") {
+  GIVEN("an actor system with a single work-stealing worker") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 1);
+    actor_system sys(cfg);
+    auto& sut = sys.scheduler();
+    WHEN("a thread outside of the scheduler enqueues a job") {
+      THEN("the worker counts an external enqueue") {
+        auto local = enqueued_jobs(sys, "local", 0);
+        auto external = enqueued_jobs(sys, "external", 0);
+        latch done{2};
+        sut.enqueue(make_job([&done](execution_unit*) { done.count_down(); }));
+        done.count_down_and_wait();
+        check_eq(enqueued_jobs(sys, "local", 0), local);
+        check_eq(enqueued_jobs(sys, "external", 0), external + 1);
+      }
+    }
+    WHEN("a job enqueues more jobs via the scheduler or exec_later") {
+      THEN("the worker counts local enqueues") {
+        auto local = enqueued_jobs(sys, "local", 0);
+        auto external = enqueued_jobs(sys, "external", 0);
+        latch done{3};
+        sut.enqueue(make_job([&done, &sut](execution_unit* ctx) {
+          auto nested = [&done](execution_unit*) { done.count_down(); };
+          sut.enqueue(make_job(nested));
+          ctx->exec_later(make_job(nested));
+        }));
+        done.count_down_and_wait();
+        check_eq(enqueued_jobs(sys, "local", 0), local + 2);
+        check_eq(enqueued_jobs(sys, "external", 0), external + 1);
+      }
+    }
+  }
+}
+
+SCENARIO("external jobs go to the next worker in round-robin order") {
+  GIVEN("an actor system with two work-stealing workers") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.work-stealing.external-enqueue", "round-robin");
+    actor_system sys(cfg);
+    auto& sut = sys.scheduler();
+    WHEN("a thread outside of the scheduler enqueues four jobs") {
+      THEN("each worker receives two of them") {
+        auto external0 = enqueued_jobs(sys, "external", 0);
+        auto external1 = enqueued_jobs(sys, "external", 1);
+        latch done{5};
+        auto noop = [&done](execution_unit*) { done.count_down(); };
+        for (int i = 0; i < 4; ++i)
+          sut.enqueue(make_job(noop));
+        done.count_down_and_wait();
+        check_eq(enqueued_jobs(sys, "external", 0), external0 + 2);
+        check_eq(enqueued_jobs(sys, "external", 1), external1 + 2);
+      }
+    }
+  }
+}
+
+SCENARIO("external jobs may go to the least loaded of two workers") {
+  GIVEN("an actor system with two work-stealing workers") {
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.work-stealing.external-enqueue", "least-loaded");
+    actor_system sys(cfg);
+    auto& sut = sys.scheduler();
+    WHEN("one worker has a longer queue than the other") {
+      THEN("new jobs from other threads go to the other worker") {
+        auto local0 = enqueued_jobs(sys, "local", 0);
+        // Block both workers and fill the queue of one of them with three
+        // local jobs. Since both workers are busy, no one steals them.
+        latch started{3};
+        latch loaded{2};
+        latch release{1};
+        latch done{9};
+        auto noop = [&done](execution_unit*) { done.count_down(); };
+        auto blocker = [&](bool fill) {
+          return [&, fill](execution_unit*) {
+            started.count_down_and_wait();
+            if (fill) {
+              for (int i = 0; i < 3; ++i)
+                sut.enqueue(make_job(noop));
+              loaded.count_down();
+            }
+            release.wait();
+            done.count_down();
+          };
+        };
+        sut.enqueue(make_job(blocker(true)));
+        sut.enqueue(make_job(blocker(false)));
+        started.count_down_and_wait();
+        loaded.count_down_and_wait();
+        auto busy = enqueued_jobs(sys, "local", 0) == local0 + 3 ? 0u : 1u;
+        auto idle = 1u - busy;
+        auto busy_external = enqueued_jobs(sys, "external", busy);
+        auto idle_external = enqueued_jobs(sys, "external", idle);
+        for (int i = 0; i < 3; ++i)
+          sut.enqueue(make_job(noop));
+        check_eq(enqueued_jobs(sys, "external", busy), busy_external);
+        check_eq(enqueued_jobs(sys, "external", idle), idle_external + 3);
+        release.count_down();
+        done.count_down_and_wait();
+      }
+    }
+  }
+}
+
+OUTLINE("thieves honor the steal batch size") {
+  GIVEN("two work-stealing workers with <queue> queues and batch size <n>") {
+    auto [queue, n] = block_parameters<std::string, int64_t>();
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.work-stealing.queue", queue);
+    cfg.set("caf.work-stealing.steal-batch-size", n);
+    actor_system sys(cfg);
+    auto& sut = sys.scheduler();
+    WHEN("one worker is busy while its queue holds eight jobs") {
+      THEN("the other worker moves <moved> of them to its own queue") {
+        auto moved = block_parameters<int64_t>();
+        auto stolen = enqueued_jobs(sys, "stolen", 0)
+                      + enqueued_jobs(sys, "stolen", 1);
+        // The victim fills its queue while the thief is still blocked, then
+        // stays busy until the thief ran all jobs. Each steal takes
+        // min((size + 1) / 2, n) jobs and moves all but the first one.
+        latch started{3};
+        latch loaded{1};
+        latch release{1};
+        latch jobs_done{9};
+        latch done{3};
+        sut.enqueue(make_job([&](execution_unit*) {
+          started.count_down_and_wait();
+          auto job_fn = [&jobs_done](execution_unit*) {
+            jobs_done.count_down();
+          };
+          for (int i = 0; i < 8; ++i)
+            sut.enqueue(make_job(job_fn));
+          loaded.count_down();
+          release.wait();
+          done.count_down();
+        }));
+        sut.enqueue(make_job([&](execution_unit*) {
+          started.count_down_and_wait();
+          loaded.wait();
+          done.count_down();
+        }));
+        started.count_down_and_wait();
+        jobs_done.count_down_and_wait();
+        check_eq(enqueued_jobs(sys, "stolen", 0)
+                   + enqueued_jobs(sys, "stolen", 1),
+                 stolen + moved);
+        release.count_down();
+        done.count_down_and_wait();
       }
     }
   }
   EXAMPLES = R"(
-    |    sched    |
-    | sharing     |
-    | stealing    |
+    |   queue   | n | moved |
+    | lock-free | 1 |     0 |
+    | lock-free | 2 |     3 |
+    | lock-free | 4 |     4 |
+    | locking   | 1 |     0 |
+    | locking   | 2 |     3 |
+    | locking   | 4 |     4 |
   )";
 }
 
+// Writes a directory in the format of `/sys/devices/system/node` with two NUMA
+// nodes. Both nodes list the same CPU, because the scheduler only uses CPUs
+// that the test process may run on.
+struct fake_topology {
+  fake_topology() {
+    auto cpus = detail::thread_affinity();
+    auto cpu = cpus && !cpus->empty() ? cpus->front() : size_t{0};
+    path = std::filesystem::temp_directory_path()
+           / ("caf-numa-" + std::to_string(std::random_device{}()));
+    for (auto node : {"node0", "node1"}) {
+      std::filesystem::create_directories(path / node);
+      write(path / node / "cpulist", std::to_string(cpu));
+    }
+    write(path / "online", "0-1");
+  }
+
+  ~fake_topology() {
+    std::error_code err;
+    std::filesystem::remove_all(path, err);
+  }
+
+  static void write(const std::filesystem::path& file, const std::string& str) {
+    std::ofstream out{file};
+    out << str << '\n';
+  }
+
+  std::filesystem::path path;
+};
+
+SCENARIO("NUMA-aware schedulers prefer workers on the requested node") {
+  GIVEN("a scheduler with two workers on each of two NUMA nodes") {
+    fake_topology topo;
+    actor_system_config cfg;
+    cfg.set("caf.scheduler.policy", "stealing");
+    cfg.set("caf.scheduler.max-threads", 4);
+    cfg.set("caf.work-stealing.numa-aware", true);
+    cfg.set("caf.work-stealing.numa-topology-path", topo.path.string());
+    actor_system sys(cfg);
+    auto& sut = sys.scheduler();
+    // The scheduler assigns the workers to the nodes in round-robin order:
+    // workers 0 and 2 belong to node 0, workers 1 and 3 belong to node 1.
+    auto jobs_on_node = [&sys](size_t node) {
+      int64_t result = 0;
+      for (auto worker : {node, node + 2})
+        result += enqueued_jobs(sys, "local", worker)
+                  + enqueued_jobs(sys, "external", worker);
+      return result;
+    };
+    WHEN("a thread outside of the scheduler enqueues jobs on node 1") {
+      THEN("only workers on node 1 receive the jobs") {
+        auto node0 = jobs_on_node(0);
+        auto node1 = jobs_on_node(1);
+        latch done{5};
+        auto noop = [&done](execution_unit*) { done.count_down(); };
+        for (int i = 0; i < 4; ++i)
+          sut.enqueue_on_node(make_job(noop), 1);
+        done.count_down_and_wait();
+        check_eq(jobs_on_node(0), node0);
+        check_eq(jobs_on_node(1), node1 + 4);
+      }
+    }
+    WHEN("a thread enqueues a job on a node that does not exist") {
+      THEN("the scheduler falls back to picking any worker") {
+        auto total = jobs_on_node(0) + jobs_on_node(1);
+        latch done{2};
+        sut.enqueue_on_node(make_job([&done](execution_unit*) {
+                              done.count_down();
+                            }),
+                            7);
+        done.count_down_and_wait();
+        check_eq(jobs_on_node(0) + jobs_on_node(1), total + 1);
+      }
+    }
+    WHEN("spawning an actor with the option numa_node(1)") {
+      THEN("the scheduler puts the actor only into queues of node 1") {
+        auto node0 = jobs_on_node(0);
+        auto node1 = jobs_on_node(1);
+        auto aut = sys.spawn<numa_node(1)>([] {
+          return behavior{[](int x) { return x; }};
+        });
+        scoped_actor self{sys};
+        for (int i = 0; i < 3; ++i) {
+          self->mail(i).request(aut, infinite).receive(
+            [this, i](int x) { check_eq(x, i); },
+            [this](const error& err) {
+              fail("unexpected error: {}", to_string(err));
+            });
+        }
+        check_eq(jobs_on_node(0), node0);
+        check_ge(jobs_on_node(1), node1 + 1);
+      }
+    }
+  }
+}
+
 } // namespace
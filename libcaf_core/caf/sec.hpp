@@ -171,6 +171,9 @@ enum class sec : uint8_t {
   invalid_request,
   /// Signals that `future::get` timed out.
   future_timeout,
+  /// Signals that a bounded mailbox rejected a message because it reached its
+  /// capacity.
+  mailbox_full,
 };
 // --(rst-sec-end)--
 
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace caf {
 
 /// @addtogroup ActorCreation
@@ -17,7 +19,8 @@ enum class spawn_options : int {
   detach_flag = 0x04,
   hide_flag = 0x08,
   priority_aware_flag = 0x20,
-  lazy_init_flag = 0x40
+  lazy_init_flag = 0x40,
+  numa_node_flag = 0x80
 };
 
 /// Concatenates two {@link spawn_options}.
@@ -46,6 +49,16 @@ constexpr spawn_options hidden = spawn_options::hide_flag;
 /// initialization until a message arrives.
 constexpr spawn_options lazy_init = spawn_options::lazy_init_flag;
 
+/// Causes the scheduler to prefer workers on the NUMA node `id` when running the
+/// new actor. Only takes effect if the scheduler groups its workers by NUMA
+/// node, i.e., when setting `caf.work-stealing.numa-aware` to `true`. Passing
+/// more than one `numa_node` option to `spawn` is not supported.
+constexpr spawn_options numa_node(uint8_t id) {
+  return static_cast<spawn_options>(
+    static_cast<int>(spawn_options::numa_node_flag)
+    | (static_cast<int>(id) << 8));
+}
+
 /// Checks whether `haystack` contains `needle`.
 constexpr bool has_spawn_option(spawn_options haystack, spawn_options needle) {
   return (static_cast<int>(haystack) & static_cast<int>(needle)) != 0;
@@ -81,6 +94,17 @@ constexpr bool has_lazy_init_flag(spawn_options opts) {
   return has_spawn_option(opts, lazy_init);
 }
 
+/// Checks whether `opts` contains a {@link numa_node} option.
+constexpr bool has_numa_node_flag(spawn_options opts) {
+  return has_spawn_option(opts, spawn_options::numa_node_flag);
+}
+
+/// Returns the NUMA node ID from `opts` or -1 if `opts` contains no
+/// {@link numa_node} option.
+constexpr int numa_node_of(spawn_options opts) {
+  return has_numa_node_flag(opts) ? (static_cast<int>(opts) >> 8) & 0xFF : -1;
+}
+
 /// @}
 
 /// @cond PRIVATE
@@ -96,7 +96,9 @@ public:
     if (open_connections_.size() == max_connections_) {
       owner_->deregister_reading();
     } else if (auto conn = accept(acc_)) {
-      auto child = factory_->make(owner_->mpx_ptr(), std::move(*conn));
+      auto* mpx = owner_->mpx_ptr();
+      auto* child_mpx = distribute_ ? mpx->select_for_connection() : mpx;
+      auto child = factory_->make(child_mpx, std::move(*conn));
       if (!child) {
         log::net::error("factory failed to create a new child");
         on_conn_close_.dispose();
@@ -106,8 +108,17 @@ public:
       open_connections_.push_back(child->as_disposable());
       if (open_connections_.size() == max_connections_)
         owner_->deregister_reading();
-      child->add_cleanup_listener(on_conn_close_);
-      std::ignore = child->start();
+      if (child_mpx == mpx) {
+        child->add_cleanup_listener(on_conn_close_);
+        std::ignore = child->start();
+      } else {
+        // The child runs its cleanup listeners in its own multiplexer, but we
+        // must run `on_conn_close_` in ours.
+        auto ctx = async::execution_context_ptr{mpx};
+        child->add_cleanup_listener(
+          make_action([ctx, f = on_conn_close_] { ctx->schedule(f); }));
+        child_mpx->start(std::move(child));
+      }
     } else if (conn.error() == sec::unavailable_or_would_block) {
       // Encountered a "soft" error: simply try again later.
       log::net::debug("accept failed: {}", conn.error());
@@ -137,6 +148,13 @@ public:
     self_ref_ = std::move(ref);
   }
 
+  /// Configures whether the handler passes accepted connections to other
+  /// multiplexers (see `multiplexer::select_for_connection`). Handlers that
+  /// share a port with `SO_REUSEPORT` keep connections on their multiplexer.
+  void distribute_connections(bool value) noexcept {
+    distribute_ = value;
+  }
+
 private:
   void connection_closed() {
     auto& conns = open_connections_;
@@ -171,6 +189,9 @@ private:
 
   /// List of actors that we add monitors to in `start`.
   std::vector<strong_actor_ptr> monitored_actors_;
+
+  /// Stores whether accepted connections may run on other multiplexers.
+  bool distribute_ = true;
 };
 
 } // namespace caf::detail
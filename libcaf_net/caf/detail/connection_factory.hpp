@@ -34,8 +34,10 @@ public:
   virtual net::socket_manager_ptr make(net::multiplexer*, ConnectionHandle) = 0;
 };
 
+/// Points to a connection factory. Accept handlers for the same server share
+/// their factory when listening on multiple sockets.
 template <class ConnectionHandle>
 using connection_factory_ptr
-  = std::unique_ptr<connection_factory<ConnectionHandle>>;
+  = std::shared_ptr<connection_factory<ConnectionHandle>>;
 
 } // namespace caf::detail
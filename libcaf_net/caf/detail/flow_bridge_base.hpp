@@ -31,6 +31,9 @@ public:
   /// Type for the producer adapter. We produce the input of the application.
   using producer_type = async::producer_adapter<input_type>;
 
+  /// Maximum number of items that the bridge pulls from its input at once.
+  static constexpr size_t max_batch_size = 64;
+
   virtual bool write(const output_type& item) = 0;
 
   bool running() const noexcept {
@@ -77,11 +80,18 @@ public:
   // -- implementation of the lower_layer --------------------------------------
 
   void prepare_send() override {
-    input_type tmp;
+    // Pulls multiple items at once to avoid locking the buffer for each item.
+    // Since we only check `can_send_more` between batches, we may exceed the
+    // soft limit of the lower layer by at most one batch.
+    auto failed = false;
+    auto do_write = [this, &failed](const output_type& item) {
+      if (!failed && !write(item))
+        failed = true;
+    };
     while (down_->can_send_more()) {
-      switch (in_.pull(async::delay_errors, tmp)) {
+      switch (in_.pull(async::delay_errors, max_batch_size, do_write)) {
         case async::read_result::ok:
-          if (!write(tmp)) {
+          if (failed) {
             abort(trait_.last_error());
             down_->shutdown(trait_.last_error());
             return;
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "caf/net/lp/default_trait.hpp"
+#include "caf/net/lp/frame.hpp"
 #include "caf/net/lp/lower_layer.hpp"
 #include "caf/net/lp/upper_layer.hpp"
 
@@ -14,6 +16,7 @@
 #include "caf/fwd.hpp"
 #include "caf/sec.hpp"
 
+#include <type_traits>
 #include <utility>
 
 namespace caf::detail {
@@ -36,9 +39,14 @@ public:
   using super::super;
 
   bool write(const output_type& item) override {
-    super::down_->begin_message();
-    auto& bytes = super::down_->message_buffer();
-    return super::trait_.convert(item, bytes) && super::down_->end_message();
+    if constexpr (std::is_same_v<Trait, net::lp::default_trait>) {
+      // The default trait sends frames as-is, so we can skip copying them.
+      return super::down_->send_message(item);
+    } else {
+      super::down_->begin_message();
+      auto& bytes = super::down_->message_buffer();
+      return super::trait_.convert(item, bytes) && super::down_->end_message();
+    }
   }
 
   // -- implementation of lp::lower_layer --------------------------------------
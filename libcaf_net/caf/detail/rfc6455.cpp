@@ -6,6 +6,7 @@
 
 #include "caf/detail/network_order.hpp"
 
+#include <cstdint>
 #include <cstring>
 
 namespace caf::detail {
@@ -18,9 +19,40 @@ void rfc6455::mask_data(uint32_t key, byte_span data, size_t offset) {
   auto no_key = to_network_order(key);
   std::byte arr[4];
   memcpy(arr, &no_key, 4);
+  auto* first = data.data() + offset;
+  auto* last = data.data() + data.size();
   auto i = offset % 4;
-  for (auto it = data.begin() + offset; it < data.end(); ++it) {
-    *it ^= arr[i];
+  // Mask single bytes until reaching a word boundary in memory.
+  while (first != last && reinterpret_cast<uintptr_t>(first) % 8 != 0) {
+    *first++ ^= arr[i];
+    i = (i + 1) % 4;
+  }
+  // Mask 32 bytes per iteration. The key repeats every four bytes, so the key
+  // for each word starts at index `i` as well. Compilers turn this loop into
+  // vector instructions on most platforms.
+  std::byte word_key_bytes[8];
+  for (size_t j = 0; j < 8; ++j)
+    word_key_bytes[j] = arr[(i + j) % 4];
+  uint64_t word_key = 0;
+  memcpy(&word_key, word_key_bytes, 8);
+  while (last - first >= 32) {
+    uint64_t words[4];
+    memcpy(words, first, 32);
+    for (auto& word : words)
+      word ^= word_key;
+    memcpy(first, words, 32);
+    first += 32;
+  }
+  while (last - first >= 8) {
+    uint64_t word = 0;
+    memcpy(&word, first, 8);
+    word ^= word_key;
+    memcpy(first, &word, 8);
+    first += 8;
+  }
+  // Mask the remaining bytes.
+  while (first != last) {
+    *first++ ^= arr[i];
     i = (i + 1) % 4;
   }
 }
@@ -38,15 +70,23 @@ void rfc6455::assemble_frame(uint32_t mask_key, const_byte_span data,
 void rfc6455::assemble_frame(uint8_t opcode, uint32_t mask_key,
                              const_byte_span data, byte_buffer& out,
                              uint8_t flags) {
+  assemble_header(opcode, mask_key, data.size(), out, flags);
+  // Application data.
+  out.insert(out.end(), data.begin(), data.end());
+}
+
+void rfc6455::assemble_header(uint8_t opcode, uint32_t mask_key,
+                              size_t payload_len, byte_buffer& out,
+                              uint8_t flags) {
   // First 8 bits: flags + opcode
   out.push_back(static_cast<std::byte>(flags | static_cast<uint8_t>(opcode)));
   // Mask flag + payload length (7 bits, 7+16 bits, or 7+64 bits)
   auto mask_bit = std::byte{static_cast<uint8_t>(mask_key == 0 ? 0x00 : 0x80)};
-  if (data.size() < 126) {
-    auto len = static_cast<uint8_t>(data.size());
+  if (payload_len < 126) {
+    auto len = static_cast<uint8_t>(payload_len);
     out.push_back(mask_bit | std::byte{len});
-  } else if (data.size() <= std::numeric_limits<uint16_t>::max()) {
-    auto len = static_cast<uint16_t>(data.size());
+  } else if (payload_len <= std::numeric_limits<uint16_t>::max()) {
+    auto len = static_cast<uint16_t>(payload_len);
     auto no_len = to_network_order(len);
     std::byte len_data[2];
     memcpy(len_data, &no_len, 2);
@@ -54,7 +94,7 @@ void rfc6455::assemble_frame(uint8_t opcode, uint32_t mask_key,
     for (auto x : len_data)
       out.push_back(x);
   } else {
-    auto len = static_cast<uint64_t>(data.size());
+    auto len = static_cast<uint64_t>(payload_len);
     auto no_len = to_network_order(len);
     std::byte len_data[8];
     memcpy(len_data, &no_len, 8);
@@ -68,8 +108,6 @@ void rfc6455::assemble_frame(uint8_t opcode, uint32_t mask_key,
     memcpy(key_data, &no_key, 4);
     out.insert(out.end(), key_data, key_data + 4);
   }
-  // Application data.
-  out.insert(out.end(), data.begin(), data.end());
 }
 
 ptrdiff_t rfc6455::decode_header(const_byte_span data, header& result) {
@@ -63,6 +63,11 @@ struct CAF_NET_EXPORT rfc6455 {
                              const_byte_span data, byte_buffer& out,
                              uint8_t flags = fin_flag);
 
+  /// Writes only the header of a frame with `payload_len` bytes to `out`.
+  static void assemble_header(uint8_t opcode, uint32_t mask_key,
+                              size_t payload_len, byte_buffer& out,
+                              uint8_t flags = fin_flag);
+
   static ptrdiff_t decode_header(const_byte_span data, header& result);
 
   static constexpr bool is_control_frame(uint8_t opcode) noexcept {
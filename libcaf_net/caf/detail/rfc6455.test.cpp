@@ -26,6 +26,18 @@ auto bytes(std::initializer_list<uint8_t> xs) {
   return result;
 }
 
+// Masks one byte at a time. Serves as reference implementation.
+void mask_bytewise(uint32_t key, byte_span data, size_t offset) {
+  std::byte arr[4] = {
+    static_cast<std::byte>((key >> 24) & 0xFF),
+    static_cast<std::byte>((key >> 16) & 0xFF),
+    static_cast<std::byte>((key >> 8) & 0xFF),
+    static_cast<std::byte>(key & 0xFF),
+  };
+  for (auto i = offset; i < data.size(); ++i)
+    data[i] ^= arr[i % 4];
+}
+
 template <class T>
 auto take(const T& xs, size_t num_bytes) {
   auto n = std::min(xs.size(), num_bytes);
@@ -69,6 +81,35 @@ TEST("partial masking with offset") {
   }
 }
 
+TEST("masking gives the same result for all offsets and alignments") {
+  auto key = uint32_t{0xDEADC0DE};
+  // Use a buffer with some extra room for shifting the start of the payload.
+  byte_buffer input;
+  for (size_t i = 0; i < 4'200; ++i)
+    input.push_back(static_cast<std::byte>((i * 7 + 3) & 0xFF));
+  auto run = [&](size_t alignment, size_t size, size_t offset) {
+    auto uut = input;
+    auto expected = input;
+    auto uut_data = make_span(uut.data() + alignment, size);
+    auto expected_data = make_span(expected.data() + alignment, size);
+    impl::mask_data(key, uut_data, offset);
+    mask_bytewise(key, expected_data, offset);
+    return uut == expected;
+  };
+  size_t mismatches = 0;
+  for (size_t alignment = 0; alignment < 16; ++alignment) {
+    for (size_t size = 0; size <= 80; ++size)
+      for (size_t offset = 0; offset <= size; ++offset)
+        if (!run(alignment, size, offset))
+          ++mismatches;
+    for (size_t size : {1'000u, 4'099u})
+      for (size_t offset : {0u, 1u, 2u, 3u, 31u, 33u, 999u})
+        if (!run(alignment, size, offset))
+          ++mismatches;
+  }
+  check_eq(mismatches, 0u);
+}
+
 TEST("decoding a frame with RSV bits fails") {
   std::vector<uint8_t> data;
   byte_buffer out = bytes({
@@ -0,0 +1,152 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/detail/ssl_session_cache.hpp"
+
+#include "caf/config.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+CAF_PUSH_WARNINGS
+#include <openssl/ssl.h>
+CAF_POP_WARNINGS
+
+namespace caf::detail {
+
+namespace {
+
+/// Stores the most recent session per key. Evicts the least recently used
+/// session when reaching the maximum size.
+class session_cache {
+public:
+  explicit session_cache(size_t max_size)
+    : max_size_(max_size > 0 ? max_size : 1) {
+    // nop
+  }
+
+  session_cache(const session_cache&) = delete;
+
+  session_cache& operator=(const session_cache&) = delete;
+
+  ~session_cache() {
+    for (auto& kvp : entries_)
+      SSL_SESSION_free(kvp.second);
+  }
+
+  /// Returns the session for `key` with an incremented reference count or
+  /// `nullptr` if no resumable session exists.
+  SSL_SESSION* get(const std::string& key) {
+    std::lock_guard guard{mtx_};
+    auto i = index_.find(key);
+    if (i == index_.end())
+      return nullptr;
+    auto pos = i->second;
+    if (SSL_SESSION_is_resumable(pos->second) != 1) {
+      SSL_SESSION_free(pos->second);
+      entries_.erase(pos);
+      index_.erase(i);
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, pos);
+    SSL_SESSION_up_ref(pos->second);
+    return pos->second;
+  }
+
+  /// Stores `sess` for `key`. Takes ownership of one reference to `sess`.
+  void put(const std::string& key, SSL_SESSION* sess) {
+    std::lock_guard guard{mtx_};
+    if (auto i = index_.find(key); i != index_.end()) {
+      auto pos = i->second;
+      SSL_SESSION_free(pos->second);
+      pos->second = sess;
+      entries_.splice(entries_.begin(), entries_, pos);
+      return;
+    }
+    if (entries_.size() >= max_size_) {
+      auto& last = entries_.back();
+      SSL_SESSION_free(last.second);
+      index_.erase(last.first);
+      entries_.pop_back();
+    }
+    entries_.emplace_front(key, sess);
+    index_.emplace(key, entries_.begin());
+  }
+
+private:
+  using entry = std::pair<std::string, SSL_SESSION*>;
+
+  std::mutex mtx_;
+  size_t max_size_;
+  std::list<entry> entries_;
+  std::unordered_map<std::string, std::list<entry>::iterator> index_;
+};
+
+void free_cache(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<session_cache*>(ptr);
+}
+
+void free_key(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+  delete static_cast<std::string*>(ptr);
+}
+
+int cache_index() {
+  static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr,
+                                                    nullptr, free_cache);
+  return index;
+}
+
+int key_index() {
+  static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr,
+                                                free_key);
+  return index;
+}
+
+session_cache* cache_of(SSL_CTX* ctx) {
+  return static_cast<session_cache*>(SSL_CTX_get_ex_data(ctx, cache_index()));
+}
+
+// Called by OpenSSL whenever the client receives a new session. For TLS 1.3,
+// this happens after the handshake when the server sends a session ticket.
+int on_new_session(SSL* ssl, SSL_SESSION* sess) {
+  auto* key = static_cast<std::string*>(SSL_get_ex_data(ssl, key_index()));
+  auto* cache = cache_of(SSL_get_SSL_CTX(ssl));
+  if (key == nullptr || cache == nullptr)
+    return 0;
+  cache->put(*key, sess);
+  return 1; // We keep the reference.
+}
+
+} // namespace
+
+void ssl_session_cache_install(void* ctx, size_t max_size) {
+  auto* ptr = static_cast<SSL_CTX*>(ctx);
+  delete cache_of(ptr);
+  SSL_CTX_set_ex_data(ptr, cache_index(), new session_cache(max_size));
+  // Keep client sessions only in our cache to respect `max_size`. OpenSSL uses
+  // a single internal cache for both roles, so we can only bypass it if the
+  // context does not cache sessions for servers as well.
+  auto mode = SSL_CTX_get_session_cache_mode(ptr) | SSL_SESS_CACHE_CLIENT;
+  if ((mode & SSL_SESS_CACHE_SERVER) == 0)
+    mode |= SSL_SESS_CACHE_NO_INTERNAL_STORE;
+  SSL_CTX_set_session_cache_mode(ptr, mode);
+  SSL_CTX_sess_set_new_cb(ptr, on_new_session);
+}
+
+void ssl_session_cache_attach(void* conn, std::string key) {
+  auto* ptr = static_cast<SSL*>(conn);
+  auto* cache = cache_of(SSL_get_SSL_CTX(ptr));
+  if (cache == nullptr)
+    return;
+  if (auto* sess = cache->get(key)) {
+    SSL_set_session(ptr, sess); // Increments the reference count.
+    SSL_SESSION_free(sess);
+  }
+  delete static_cast<std::string*>(SSL_get_ex_data(ptr, key_index()));
+  SSL_set_ex_data(ptr, key_index(), new std::string(std::move(key)));
+}
+
+} // namespace caf::detail
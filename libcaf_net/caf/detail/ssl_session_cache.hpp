@@ -0,0 +1,24 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/detail/net_export.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace caf::detail {
+
+/// Installs a client-side session cache with up to `max_size` entries on the
+/// native SSL context `ctx`, replacing any previously installed cache. The
+/// native context owns the cache and deletes it when OpenSSL frees the context.
+CAF_NET_EXPORT void ssl_session_cache_install(void* ctx, size_t max_size);
+
+/// Associates the native SSL connection `conn` with `key` and restores the
+/// cached session for `key`, if any. Has no effect if the context of `conn`
+/// has no session cache.
+CAF_NET_EXPORT void ssl_session_cache_attach(void* conn, std::string key);
+
+} // namespace caf::detail
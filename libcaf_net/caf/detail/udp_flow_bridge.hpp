@@ -0,0 +1,88 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/udp/datagram.hpp"
+#include "caf/net/udp/lower_layer.hpp"
+#include "caf/net/udp/upper_layer.hpp"
+
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/detail/flow_bridge_base.hpp"
+#include "caf/error.hpp"
+#include "caf/fwd.hpp"
+#include "caf/sec.hpp"
+
+#include <memory>
+#include <utility>
+
+namespace caf::detail {
+
+/// Configures the flow bridge for datagrams. The bridge passes datagrams as-is
+/// and only fails to write datagrams that exceed the maximum size.
+struct udp_flow_bridge_trait {
+  using input_type = net::udp::datagram;
+
+  using output_type = net::udp::datagram;
+
+  error last_error() {
+    return make_error(sec::invalid_argument,
+                      "datagram exceeds the maximum size");
+  }
+};
+
+/// Translates between a datagram-oriented transport and data flows.
+class udp_flow_bridge
+  : public flow_bridge_base<net::udp::upper_layer, net::udp::lower_layer,
+                            udp_flow_bridge_trait> {
+public:
+  using super = flow_bridge_base<net::udp::upper_layer, net::udp::lower_layer,
+                                 udp_flow_bridge_trait>;
+
+  // We consume the output type of the application.
+  using pull_t = async::consumer_resource<net::udp::datagram>;
+
+  // We produce the input type of the application.
+  using push_t = async::producer_resource<net::udp::datagram>;
+
+  udp_flow_bridge(pull_t pull, push_t push)
+    : pull_(std::move(pull)), push_(std::move(push)) {
+    // nop
+  }
+
+  static std::unique_ptr<udp_flow_bridge> make(pull_t pull, push_t push) {
+    return std::make_unique<udp_flow_bridge>(std::move(pull), std::move(push));
+  }
+
+  bool write(const net::udp::datagram& item) override {
+    return down_->send_datagram(item.endpoint(), item.bytes());
+  }
+
+  void abort(const error& err) override {
+    super::abort(err);
+    if (push_)
+      push_.abort(err);
+  }
+
+  error start(net::udp::lower_layer* down_ptr) override {
+    down_ = down_ptr;
+    return init(&down_ptr->mpx(), std::move(pull_), std::move(push_));
+  }
+
+  // -- implementation of udp::upper_layer -------------------------------------
+
+  ptrdiff_t consume(const ip_endpoint& source, byte_span payload) override {
+    if (!out_)
+      return -1;
+    if (out_.push(net::udp::datagram{source, payload}) == 0)
+      down_->suspend_reading();
+    return static_cast<ptrdiff_t>(payload.size());
+  }
+
+private:
+  pull_t pull_;
+  push_t push_;
+};
+
+} // namespace caf::detail
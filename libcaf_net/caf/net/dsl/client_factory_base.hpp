@@ -12,10 +12,12 @@
 
 #include "caf/config_value.hpp"
 #include "caf/make_counted.hpp"
+#include "caf/uri.hpp"
 
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <variant>
 
 namespace caf::net::dsl {
 
@@ -113,6 +115,8 @@ protected:
       auto conn = ctx->new_connection(std::forward<fd_t>(fd));
       if (!conn)
         return res_t{conn.error()};
+      if (auto key = session_key(); !key.empty())
+        conn->resume_session(std::move(key));
       return fn(std::move(*conn));
     };
   }
@@ -131,6 +135,8 @@ protected:
         auto conn = ctx->new_connection(std::forward<fd_t>(fd));
         if (!conn)
           return res_t{conn.error()};
+        if (auto key = session_key(); !key.empty())
+          conn->resume_session(std::move(key));
         return fn(std::move(*conn));
       }
       return fn(std::forward<fd_t>(fd));
@@ -149,6 +155,21 @@ protected:
     };
   }
 
+  /// Returns the key for resuming SSL sessions, i.e., host and port of the
+  /// server, or an empty string if the server address is unknown.
+  std::string session_key() const {
+    auto* lazy = get_if<client_config::lazy>(&cfg_->data);
+    if (lazy == nullptr)
+      return {};
+    if (auto* addr = std::get_if<server_address>(&lazy->server)) {
+      auto result = addr->host;
+      result += ':';
+      result += std::to_string(addr->port);
+      return result;
+    }
+    return to_string(std::get<uri>(lazy->server).authority());
+  }
+
   config_pointer cfg_;
 };
 
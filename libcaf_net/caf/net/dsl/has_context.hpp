@@ -8,6 +8,8 @@
 
 #include "caf/expected.hpp"
 
+#include <memory>
+
 namespace caf::net::dsl {
 
 /// DSL entry point for creating a server.
@@ -18,10 +20,17 @@ public:
   /// @param ctx The SSL context for encryption.
   /// @returns a reference to `*this`.
   Subtype& context(ssl::context ctx) {
+    return context(std::make_shared<ssl::context>(std::move(ctx)));
+  }
+
+  /// Sets the optional SSL context. Sharing a context between multiple clients
+  /// allows them to resume SSL sessions of each other.
+  /// @param ctx_ptr The SSL context for encryption.
+  /// @returns a reference to `*this`.
+  Subtype& context(std::shared_ptr<ssl::context> ctx_ptr) {
     auto& dref = static_cast<Subtype&>(*this);
     auto& cfg = dref.config();
     if (auto* ptr = cfg.as_has_make_ctx()) {
-      auto ctx_ptr = std::make_shared<ssl::context>(std::move(ctx));
       ptr->make_ctx = [ctx_ptr]() -> expected<std::shared_ptr<ssl::context>> {
         return ctx_ptr;
       };
@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <optional>
 #include <string>
 
 namespace caf::net::dsl {
@@ -47,6 +48,9 @@ public:
 
     /// Whether to set `SO_REUSEADDR` on the socket.
     bool reuse_addr = true;
+
+    /// Whether to open one socket with `SO_REUSEPORT` per multiplexer.
+    bool reuse_port = false;
   };
 
   using lazy_t = server_config_tag<lazy>;
@@ -79,7 +83,7 @@ public:
     }
   };
 
-  using socket_t = server_config_tag<error>;
+  using socket_t = server_config_tag<socket>;
 
   static constexpr auto socket_v = socket_t{};
 
@@ -100,6 +104,17 @@ public:
 
     /// Configures how many concurrent connections the server allows.
     size_t max_connections = defaults::net::max_connections.fallback;
+
+    /// Configures the maximum number of sessions in the SSL session cache. A
+    /// value of 0 leaves the session cache of the SSL context unchanged.
+    size_t session_cache_size = 0;
+
+    /// Configures how long clients may resume a cached SSL session.
+    timespan session_lifetime = defaults::net::ssl_session_lifetime;
+
+    /// Configures whether the server issues SSL session tickets. Leaves the
+    /// setting of the SSL context unchanged if not set.
+    std::optional<bool> session_tickets;
   };
 };
 
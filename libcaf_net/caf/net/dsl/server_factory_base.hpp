@@ -7,13 +7,20 @@
 #include "caf/net/dsl/base.hpp"
 #include "caf/net/dsl/server_config.hpp"
 #include "caf/net/fwd.hpp"
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/socket_manager.hpp"
 #include "caf/net/tcp_accept_socket.hpp"
 
 #include "caf/config_value.hpp"
+#include "caf/detail/accept_handler.hpp"
+#include "caf/disposable.hpp"
 #include "caf/make_counted.hpp"
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace caf::net::dsl {
 
@@ -63,6 +70,39 @@ public:
     return dref();
   }
 
+  /// Configures whether the server opens one socket with `SO_REUSEPORT` per
+  /// multiplexer of the middleman. All sockets listen on the same port and
+  /// the OS distributes incoming connections across them. Each multiplexer
+  /// then runs its own accept handler and keeps the connections it accepts.
+  /// @note The limit set via `max_connections` applies to each socket.
+  Derived& reuse_port(bool value) {
+    if (auto* lazy = get_if<server_config::lazy>(&cfg_->data))
+      lazy->reuse_port = value;
+    return dref();
+  }
+
+  /// Configures the SSL session cache of the server. Clients that connect
+  /// again within `lifetime` may resume their previous session instead of
+  /// performing a full handshake. Has no effect without SSL.
+  /// @param max_size The maximum number of cached sessions.
+  /// @param lifetime How long clients may resume a session. Also limits the
+  ///                 lifetime of session tickets.
+  Derived& session_cache(size_t max_size,
+                         timespan lifetime
+                         = defaults::net::ssl_session_lifetime) {
+    cfg_->session_cache_size = max_size;
+    cfg_->session_lifetime = lifetime;
+    return dref();
+  }
+
+  /// Configures whether the server issues SSL session tickets. With tickets,
+  /// clients store the encrypted session state instead of the server. Has no
+  /// effect without SSL.
+  Derived& session_tickets(bool value) {
+    cfg_->session_tickets = value;
+    return dref();
+  }
+
   config_type& config() {
     return *cfg_;
   }
@@ -72,6 +112,58 @@ protected:
     return static_cast<Derived&>(*this);
   }
 
+  /// Starts an accept handler for `acc` on the configured multiplexer. When
+  /// using `reuse_port`, also starts an accept handler on each additional
+  /// multiplexer of the middleman.
+  template <class Acceptor, class Factory>
+  expected<disposable>
+  start_accept_handlers(Acceptor acc, std::shared_ptr<Factory> factory,
+                        std::vector<strong_actor_ptr> monitored_actors = {}) {
+    auto* mpx = cfg_->mpx;
+    std::vector<multiplexer*> shard_mpx;
+    auto* lazy = get_if<server_config::lazy>(&cfg_->data);
+    if (lazy != nullptr && lazy->reuse_port) {
+      for (auto* ptr : mpx->pool())
+        if (ptr != mpx)
+          shard_mpx.push_back(ptr);
+    }
+    if (shard_mpx.empty())
+      return start_accept_handler(mpx, std::move(acc), std::move(factory),
+                                  std::move(monitored_actors), true);
+    // Open all sockets before starting any handler to fail atomically.
+    auto port = local_port(accept_socket_of(acc));
+    if (!port) {
+      close(acc);
+      return expected<disposable>{std::move(port.error())};
+    }
+    std::vector<tcp_accept_socket> shards;
+    for (size_t i = 0; i < shard_mpx.size(); ++i) {
+      auto fd = make_tcp_accept_socket(*port, lazy->bind_address,
+                                       lazy->reuse_addr, true);
+      if (!fd) {
+        for (auto shard : shards)
+          close(shard);
+        close(acc);
+        return expected<disposable>{std::move(fd.error())};
+      }
+      shards.push_back(*fd);
+    }
+    std::vector<disposable> handlers;
+    handlers.reserve(shards.size() + 1);
+    for (size_t i = 0; i < shards.size(); ++i) {
+      auto shard_acc = make_shard(acc, shards[i]);
+      handlers.push_back(start_accept_handler(shard_mpx[i],
+                                              std::move(shard_acc), factory,
+                                              monitored_actors, false));
+    }
+    handlers.push_back(start_accept_handler(mpx, std::move(acc),
+                                            std::move(factory),
+                                            std::move(monitored_actors),
+                                            false));
+    auto result = disposable::make_composite(std::move(handlers));
+    return expected<disposable>{std::move(result)};
+  }
+
   template <class Fn>
   auto with_ssl_acceptor_or_socket(Fn&& fn) {
     return [this, fn = std::forward<Fn>(fn)](auto&& fd) mutable {
@@ -82,7 +174,16 @@ protected:
         if (!maybe_ctx)
           return res_t{maybe_ctx.error()};
         auto& ctx = *maybe_ctx;
-        auto acc = ssl::tcp_acceptor{std::forward<fd_t>(fd), std::move(*ctx)};
+        if (cfg_->session_cache_size > 0
+            && !ctx->enable_session_cache(cfg_->session_cache_size,
+                                          cfg_->session_lifetime)) {
+          auto err = ssl::context::last_error_or_unexpected(
+            "enable_session_cache failed");
+          return res_t{std::move(err)};
+        }
+        if (cfg_->session_tickets)
+          ctx->enable_session_tickets(*cfg_->session_tickets);
+        auto acc = ssl::tcp_acceptor{std::forward<fd_t>(fd), ctx};
         return fn(std::move(acc));
       }
       return fn(std::forward<fd_t>(fd));
@@ -90,6 +191,42 @@ protected:
   }
 
   config_pointer cfg_;
+
+private:
+  template <class Acceptor, class Factory>
+  disposable
+  start_accept_handler(multiplexer* mpx, Acceptor acc,
+                       std::shared_ptr<Factory> factory,
+                       std::vector<strong_actor_ptr> monitored_actors,
+                       bool distribute_connections) {
+    using impl_t = detail::accept_handler<Acceptor>;
+    auto impl = impl_t::make(std::move(acc), std::move(factory),
+                             cfg_->max_connections,
+                             std::move(monitored_actors));
+    auto impl_ptr = impl.get();
+    impl_ptr->distribute_connections(distribute_connections);
+    auto ptr = socket_manager::make(mpx, std::move(impl));
+    impl_ptr->self_ref(ptr->as_disposable());
+    mpx->start(ptr);
+    return disposable{std::move(ptr)};
+  }
+
+  template <class Acceptor>
+  static tcp_accept_socket accept_socket_of(const Acceptor& acc) {
+    if constexpr (std::is_same_v<Acceptor, tcp_accept_socket>)
+      return acc;
+    else
+      return acc.fd();
+  }
+
+  /// Creates an acceptor for `fd` with the same settings as `acc`.
+  template <class Acceptor>
+  static Acceptor make_shard(Acceptor& acc, tcp_accept_socket fd) {
+    if constexpr (std::is_same_v<Acceptor, tcp_accept_socket>)
+      return fd;
+    else
+      return Acceptor{fd, acc.ctx_ptr()};
+  }
 };
 
 } // namespace caf::net::dsl
@@ -108,6 +108,15 @@ using frame = caf::chunk;
 
 } // namespace caf::net::lp
 
+namespace caf::net::udp {
+
+class datagram;
+class lower_layer;
+class transport;
+class upper_layer;
+
+} // namespace caf::net::udp
+
 namespace caf::net::web_socket {
 
 class client;
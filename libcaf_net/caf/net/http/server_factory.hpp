@@ -203,17 +203,11 @@ private:
     }
     using transport_t = typename Acceptor::transport_type;
     using factory_t = detail::http_conn_factory<transport_t>;
-    using impl_t = detail::accept_handler<Acceptor>;
-    auto factory = std::make_unique<factory_t>(cfg.routes,
+    auto factory = std::make_shared<factory_t>(cfg.routes,
                                                cfg.max_consecutive_reads,
                                                cfg.max_request_size);
-    auto impl = impl_t::make(std::move(acc), std::move(factory),
-                             cfg.max_connections, cfg.monitored_actors);
-    auto impl_ptr = impl.get();
-    auto ptr = net::socket_manager::make(cfg.mpx, std::move(impl));
-    impl_ptr->self_ref(ptr->as_disposable());
-    cfg.mpx->start(ptr);
-    return expected<disposable>{disposable{std::move(ptr)}};
+    return this->start_accept_handlers(std::move(acc), std::move(factory),
+                                       cfg.monitored_actors);
   }
 
   template <class Acceptor, class OnStart>
@@ -221,7 +215,6 @@ private:
   do_start_impl(config_type& cfg, Acceptor acc, OnStart& on_start) {
     using transport_t = typename Acceptor::transport_type;
     using factory_t = detail::http_conn_factory<transport_t>;
-    using impl_t = detail::accept_handler<Acceptor>;
     auto routes = cfg.routes;
     auto [pull, push] = async::make_spsc_buffer_resource<request>();
     auto producer = detail::http_request_producer::make(cfg.mpx,
@@ -232,16 +225,13 @@ private:
         res.router()->shutdown(err);
       }
     }));
-    auto factory = std::make_unique<factory_t>(std::move(routes),
+    auto factory = std::make_shared<factory_t>(std::move(routes),
                                                cfg.max_consecutive_reads);
-    auto impl = impl_t::make(std::move(acc), std::move(factory),
-                             cfg.max_connections, cfg.monitored_actors);
-    auto impl_ptr = impl.get();
-    auto ptr = net::socket_manager::make(cfg.mpx, std::move(impl));
-    impl_ptr->self_ref(ptr->as_disposable());
-    cfg.mpx->start(ptr);
-    on_start(std::move(pull));
-    return expected<disposable>{disposable{std::move(ptr)}};
+    auto res = this->start_accept_handlers(std::move(acc), std::move(factory),
+                                           cfg.monitored_actors);
+    if (res)
+      on_start(std::move(pull));
+    return res;
   }
 
   template <class OnStart>
@@ -260,7 +250,8 @@ private:
   expected<disposable> do_start(config_type& cfg,
                                 dsl::server_config::lazy& data,
                                 OnStart& on_start) {
-    return make_tcp_accept_socket(data.port, data.bind_address, data.reuse_addr)
+    return make_tcp_accept_socket(data.port, data.bind_address, data.reuse_addr,
+                                  data.reuse_port)
       .and_then(
         this->with_ssl_acceptor_or_socket([this, &cfg, &on_start](auto&& acc) {
           using acc_t = std::decay_t<decltype(acc)>;
@@ -3,11 +3,14 @@
 #include "caf/net/octet_stream/lower_layer.hpp"
 #include "caf/net/receive_policy.hpp"
 
+#include "caf/chunk.hpp"
 #include "caf/detail/network_order.hpp"
 #include "caf/error.hpp"
 #include "caf/log/net.hpp"
 #include "caf/sec.hpp"
 
+#include <algorithm>
+
 namespace caf::net::lp {
 
 // -- factories ----------------------------------------------------------------
@@ -29,15 +32,12 @@ void framing::abort(const error& reason) {
 
 ptrdiff_t framing::consume(byte_span input, byte_span) {
   auto lg = log::net::trace("got {} bytes\n", input.size());
-  if (input.size() < sizeof(uint32_t)) {
-    log::net::error("received too few bytes from underlying transport");
-    up_->abort(make_error(sec::logic_error,
-                          "received too few bytes from underlying transport"));
-    return -1;
-  } else if (input.size() == hdr_size) {
-    auto u32_size = uint32_t{0};
-    memcpy(&u32_size, input.data(), sizeof(uint32_t));
-    auto msg_size = static_cast<size_t>(detail::from_network_order(u32_size));
+  // Dispatch all complete messages in the buffer in one pass and leave a
+  // trailing partial message in the transport until the remaining bytes
+  // arrive.
+  size_t consumed = 0;
+  while (input.size() - consumed >= hdr_size) {
+    auto [msg_size, msg] = split(input.subspan(consumed));
     if (msg_size == 0) {
       // Ignore empty messages.
       log::net::error("received empty message");
@@ -49,28 +49,23 @@ ptrdiff_t framing::consume(byte_span input, byte_span) {
       up_->abort(
         make_error(sec::protocol_error, "exceeded maximum message size"));
       return -1;
-    } else {
+    } else if (msg.size() < msg_size) {
       log::net::debug("wait for payload of size {}", msg_size);
-      down_->configure_read(receive_policy::exactly(hdr_size + msg_size));
-      return 0;
+      auto frame_size = static_cast<uint32_t>(hdr_size + msg_size);
+      auto max_size = std::max(frame_size, default_receive_policy.max_size);
+      down_->configure_read(receive_policy::between(frame_size, max_size));
+      return static_cast<ptrdiff_t>(consumed);
     }
-  } else {
-    auto [msg_size, msg] = split(input);
-    if (msg_size == msg.size() && msg_size + hdr_size == input.size()) {
-      log::net::debug("got message of size {}", msg_size);
-      if (up_->consume(msg) >= 0) {
-        if (down_->is_reading())
-          down_->configure_read(receive_policy::exactly(hdr_size));
-        return static_cast<ptrdiff_t>(input.size());
-      } else {
-        return -1;
-      }
-    } else {
-      log::net::debug("received malformed message");
-      up_->abort(make_error(sec::protocol_error, "received malformed message"));
+    log::net::debug("got message of size {}", msg_size);
+    if (up_->consume(msg.subspan(0, msg_size)) < 0)
       return -1;
-    }
+    consumed += hdr_size + msg_size;
+    // Stop early if the upper layer suspended reading.
+    if (!down_->is_reading())
+      return static_cast<ptrdiff_t>(consumed);
   }
+  down_->configure_read(default_receive_policy);
+  return static_cast<ptrdiff_t>(consumed);
 }
 
 void framing::prepare_send() {
@@ -105,7 +100,7 @@ void framing::write_later() {
 
 void framing::request_messages() {
   if (!down_->is_reading())
-    down_->configure_read(receive_policy::exactly(hdr_size));
+    down_->configure_read(default_receive_policy);
 }
 
 void framing::begin_message() {
@@ -139,6 +134,27 @@ bool framing::end_message() {
   }
 }
 
+bool framing::send_message(const chunk& payload) {
+  using detail::to_network_order;
+  auto msg_size = payload.size();
+  if (msg_size < octet_stream::lower_layer::min_enqueue_size)
+    return lower_layer::send_message(payload);
+  if (msg_size >= max_message_length) {
+    log::net::debug("maximum message size exceeded");
+    return false;
+  }
+  // Write the header to the output buffer and let the transport send the
+  // payload directly from the chunk.
+  down_->begin_output();
+  auto& buf = down_->output_buffer();
+  auto u32_size = to_network_order(static_cast<uint32_t>(msg_size));
+  auto* first = reinterpret_cast<const std::byte*>(&u32_size);
+  buf.insert(buf.end(), first, first + sizeof(uint32_t));
+  down_->enqueue_output(payload);
+  down_->end_output();
+  return true;
+}
+
 void framing::shutdown() {
   down_->shutdown();
 }
@@ -10,6 +10,7 @@
 #include "caf/net/lp/upper_layer.hpp"
 #include "caf/net/middleman.hpp"
 #include "caf/net/octet_stream/upper_layer.hpp"
+#include "caf/net/receive_policy.hpp"
 
 #include "caf/actor_system.hpp"
 #include "caf/async/spsc_buffer.hpp"
@@ -43,6 +44,11 @@ public:
 
   static constexpr size_t max_message_length = INT32_MAX - sizeof(uint32_t);
 
+  /// Reads up to 8 KB at once to process multiple small messages per read
+  /// operation.
+  static constexpr auto default_receive_policy
+    = receive_policy::between(hdr_size, 8192);
+
   // -- constructors, destructors, and assignment operators --------------------
 
   explicit framing(upper_layer_ptr up) : up_(std::move(up)) {
@@ -85,6 +91,8 @@ public:
 
   bool end_message() override;
 
+  bool send_message(const chunk& payload) override;
+
   void shutdown() override;
 
   // -- utility functions ------------------------------------------------------
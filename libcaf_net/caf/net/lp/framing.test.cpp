@@ -200,6 +200,57 @@ SCENARIO("length-prefix framing reads data with 32-bit size headers") {
   }
 }
 
+SCENARIO("length-prefix framing dispatches all buffered messages") {
+  GIVEN("a framing object with an app that consumes strings") {
+    WHEN("writing many messages with a single write operation") {
+      auto buf = std::make_shared<buffer>();
+      run_app([](net::lp::lower_layer*) {}, buf);
+      byte_buffer bytes;
+      for (int i = 0; i < 1000; ++i) {
+        auto msg = encode(std::to_string(i));
+        bytes.insert(bytes.end(), msg.begin(), msg.end());
+      }
+      // Split the last message to have a partial message in the buffer.
+      auto tail = std::min(bytes.size(), size_t{2});
+      net::write(fd1, make_span(bytes.data(), bytes.size() - tail));
+      std::this_thread::sleep_for(10ms);
+      net::write(fd1, make_span(bytes.data() + bytes.size() - tail, tail));
+      THEN("the app receives all strings as individual messages") {
+        require(buf->wait_for_entries(1000, 1s));
+        auto [entries, err] = buf->get();
+        if (err) {
+          fail("unexpected error: {}", err);
+        }
+        if (check_eq(entries.size(), 1000u)) {
+          for (size_t i = 0; i < 1000; ++i)
+            check_eq(entries[i], std::to_string(i));
+        }
+      }
+    }
+    WHEN("writing messages that exceed the default read size") {
+      auto buf = std::make_shared<buffer>();
+      run_app([](net::lp::lower_layer*) {}, buf);
+      auto large = std::string(20'000, 'x');
+      byte_buffer bytes;
+      for (auto msg : {encode("a"), encode(large), encode("b")})
+        bytes.insert(bytes.end(), msg.begin(), msg.end());
+      net::write(fd1, bytes);
+      THEN("the app receives all strings as individual messages") {
+        require(buf->wait_for_entries(3, 1s));
+        auto [entries, err] = buf->get();
+        if (err) {
+          fail("unexpected error: {}", err);
+        }
+        if (check_eq(entries.size(), 3u)) {
+          check_eq(entries[0], "a");
+          check_eq(entries[1], large);
+          check_eq(entries[2], "b");
+        }
+      }
+    }
+  }
+}
+
 } // WITH_FIXTURE(fixture)
 
 void run_writer(net::stream_socket fd) {
@@ -40,6 +40,13 @@ public:
   /// @note When returning `false`, clients must also call
   ///       `down.set_read_error(...)` with an appropriate error code.
   virtual bool end_message() = 0;
+
+  /// Sends `payload` as a single message. Unlike writing to the message
+  /// buffer, this allows lower layers to send large payloads without copying
+  /// them. The default implementation copies `payload` into the message
+  /// buffer.
+  /// @returns the result of `end_message()`.
+  virtual bool send_message(const chunk& payload);
 };
 
 } // namespace caf::net::lp
@@ -43,9 +43,9 @@ public:
 
   using producer_type = async::blocking_producer<accept_event>;
 
-  // Note: this is shared with the connection factory. In general, this is
-  //       *unsafe*. However, we exploit the fact that there is currently only
-  //       one thread running in the multiplexer (which makes this safe).
+  // Note: this is shared with the connection factory and all connections of
+  //       the server. Connections may run on different multiplexers, which is
+  //       safe because the producer synchronizes all calls to `push`.
   using shared_producer_type = std::shared_ptr<producer_type>;
 
   lp_server_flow_bridge(shared_producer_type producer)
@@ -148,20 +148,15 @@ private:
   do_start_impl(config_type& cfg, Acceptor acc, OnStart& on_start) {
     using transport_t = typename Acceptor::transport_type;
     using factory_t = detail::lp_connection_factory<transport_t, Trait>;
-    using impl_t = detail::accept_handler<Acceptor>;
     using accept_event = typename Trait::accept_event;
     auto [pull, push] = async::make_spsc_buffer_resource<accept_event>();
     auto producer = async::make_blocking_producer(push.try_open());
-    auto factory = std::make_unique<factory_t>(std::move(producer),
+    auto factory = std::make_shared<factory_t>(std::move(producer),
                                                cfg.max_consecutive_reads);
-    auto impl = impl_t::make(std::move(acc), std::move(factory),
-                             cfg.max_connections);
-    auto impl_ptr = impl.get();
-    auto ptr = net::socket_manager::make(cfg.mpx, std::move(impl));
-    impl_ptr->self_ref(ptr->as_disposable());
-    cfg.mpx->start(ptr);
-    on_start(std::move(pull));
-    return expected<disposable>{disposable{std::move(ptr)}};
+    auto res = this->start_accept_handlers(std::move(acc), std::move(factory));
+    if (res)
+      on_start(std::move(pull));
+    return res;
   }
 
   template <class OnStart>
@@ -180,7 +175,8 @@ private:
   expected<disposable> do_start(config_type& cfg,
                                 dsl::server_config::lazy& data,
                                 OnStart& on_start) {
-    return make_tcp_accept_socket(data.port, data.bind_address, data.reuse_addr)
+    return make_tcp_accept_socket(data.port, data.bind_address, data.reuse_addr,
+                                  data.reuse_port)
       .and_then(
         this->with_ssl_acceptor_or_socket([this, &cfg, &on_start](auto&& acc) {
           using acc_t = decltype(acc);
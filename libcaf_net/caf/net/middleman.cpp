@@ -10,12 +10,18 @@
 #include "caf/net/this_host.hpp"
 
 #include "caf/actor_system_config.hpp"
+#include "caf/defaults.hpp"
 #include "caf/expected.hpp"
 #include "caf/log/net.hpp"
 #include "caf/log/system.hpp"
 #include "caf/raise_error.hpp"
+#include "caf/telemetry/counter.hpp"
+#include "caf/telemetry/metric_family_impl.hpp"
+#include "caf/telemetry/metric_registry.hpp"
 #include "caf/thread_owner.hpp"
 
+#include <cstdio>
+
 namespace caf::net {
 
 namespace {
@@ -99,9 +105,35 @@ actor_system::global_state_guard middleman::init_host_system() {
   }};
 }
 
-middleman::middleman(actor_system& sys)
-  : sys_(sys), mpx_(multiplexer::make(this)) {
-  // nop
+middleman::middleman(actor_system& sys) : sys_(sys) {
+  auto backend = get_or(sys.config(), "caf.net.multiplexer",
+                        defaults::net::multiplexer);
+  mpx_ = multiplexer::make(this, backend);
+  auto num_threads = get_or(sys.config(), "caf.net.multiplexer-threads",
+                            defaults::net::multiplexer_threads);
+  for (size_t i = 1; i < num_threads; ++i)
+    pool_.emplace_back(multiplexer::make(this, backend));
+  auto distribution = get_or(sys.config(), "caf.net.connection-distribution",
+                             defaults::net::connection_distribution);
+  if (distribution == "least-connections") {
+    least_connections_ = true;
+  } else if (distribution != "round-robin") {
+    fprintf(stderr,
+            "[WARNING] '%s' is an unrecognized connection distribution, "
+            "falling back to 'round-robin'\n",
+            distribution.c_str());
+  }
+  auto* handshakes = sys.metrics().counter_family(
+    "caf.net", "ssl-handshakes", {"role", "type"},
+    "Number of completed SSL handshakes.", "1", true);
+  for (auto is_server : {false, true}) {
+    auto role = is_server ? "server" : "client";
+    for (auto resumed : {false, true}) {
+      auto type = resumed ? "resumed" : "full";
+      ssl_handshakes_[is_server][resumed]
+        = handshakes->get_or_add({{"role", role}, {"type", type}});
+    }
+  }
 }
 
 middleman::~middleman() {
@@ -115,14 +147,34 @@ void middleman::start() {
     mpx_->run();
   };
   mpx_thread_ = sys_.launch_thread("caf.net.mpx", thread_owner::system, fn);
+  for (auto& mpx : pool_) {
+    auto pool_fn = [mpx] {
+      mpx->set_thread_id();
+      mpx->run();
+    };
+    pool_threads_.emplace_back(
+      sys_.launch_thread("caf.net.mpx", thread_owner::system, pool_fn));
+  }
 }
 
 void middleman::stop() {
+  // Shut down the primary multiplexer first. It runs all acceptors, which in
+  // turn dispose the connections on the other multiplexers.
   mpx_->shutdown();
   if (mpx_thread_.joinable())
     mpx_thread_.join();
   else
     mpx_->run();
+  for (auto& mpx : pool_)
+    mpx->shutdown();
+  if (pool_threads_.empty()) {
+    for (auto& mpx : pool_)
+      mpx->run();
+  } else {
+    for (auto& thread : pool_threads_)
+      thread.join();
+    pool_threads_.clear();
+  }
 }
 
 void middleman::init(actor_system_config&) {
@@ -130,6 +182,39 @@ void middleman::init(actor_system_config&) {
     log::system::error("failed to initialize multiplexer: {}", err);
     CAF_RAISE_ERROR("mpx_->init() failed");
   }
+  for (auto& mpx : pool_) {
+    if (auto err = mpx->init()) {
+      log::system::error("failed to initialize multiplexer: {}", err);
+      CAF_RAISE_ERROR("mpx->init() failed");
+    }
+  }
+}
+
+std::vector<multiplexer*> middleman::mpx_pool() const {
+  std::vector<multiplexer*> result;
+  result.reserve(num_mpx());
+  result.push_back(mpx_.get());
+  for (auto& mpx : pool_)
+    result.push_back(mpx.get());
+  return result;
+}
+
+multiplexer* middleman::select_mpx() noexcept {
+  if (pool_.empty())
+    return mpx_.get();
+  if (least_connections_) {
+    auto* result = mpx_.get();
+    auto min_load = result->load();
+    for (auto& mpx : pool_) {
+      if (auto load = mpx->load(); load < min_load) {
+        result = mpx.get();
+        min_load = load;
+      }
+    }
+    return result;
+  }
+  auto index = next_mpx_.fetch_add(1, std::memory_order_relaxed) % num_mpx();
+  return index == 0 ? mpx_.get() : pool_[index - 1].get();
 }
 
 middleman::module::id_t middleman::id() const {
@@ -145,6 +230,13 @@ actor_system::module* middleman::make(actor_system& sys, type_list<>) {
 }
 
 void middleman::add_module_options(actor_system_config& cfg) {
+  config_option_adder{cfg.custom_options(), "caf.net"}
+    .add<std::string>("multiplexer",
+                      "either 'poll' (default) or 'epoll' (Linux only)")
+    .add<size_t>("multiplexer-threads",
+                 "number of multiplexers for handling connections")
+    .add<std::string>("connection-distribution",
+                      "either 'round-robin' (default) or 'least-connections'");
   config_option_adder{cfg.custom_options(), "caf.net.prometheus-http"}
     .add<uint16_t>("port", "listening port for incoming scrapes")
     .add<std::string>("address", "bind address for the HTTP server socket");
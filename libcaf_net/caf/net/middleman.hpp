@@ -13,7 +13,9 @@
 #include "caf/fwd.hpp"
 #include "caf/type_list.hpp"
 
+#include <atomic>
 #include <thread>
+#include <vector>
 
 namespace caf::net {
 
@@ -89,6 +91,30 @@ public:
     return mpx_.get();
   }
 
+  /// Returns the number of multiplexers, i.e., the number of threads for
+  /// socket I/O.
+  size_t num_mpx() const noexcept {
+    return pool_.size() + 1;
+  }
+
+  /// Selects a multiplexer for a new connection according to the configured
+  /// distribution strategy (see `caf.net.connection-distribution`). Always
+  /// returns `mpx_ptr()` unless `caf.net.multiplexer-threads` is greater than
+  /// one.
+  /// @thread-safe
+  multiplexer* select_mpx() noexcept;
+
+  /// Returns all multiplexers, starting with `mpx_ptr()`.
+  std::vector<multiplexer*> mpx_pool() const;
+
+  /// Returns the counter for completed SSL handshakes with the given role and
+  /// type (see `caf.net.ssl-handshakes`).
+  /// @thread-safe
+  telemetry::int_counter* ssl_handshakes(bool is_server,
+                                         bool resumed) const noexcept {
+    return ssl_handshakes_[is_server ? 1 : 0][resumed ? 1 : 0];
+  }
+
 private:
   // -- member variables -------------------------------------------------------
 
@@ -100,6 +126,24 @@ private:
 
   /// Runs the multiplexer's event loop
   std::thread mpx_thread_;
+
+  /// Stores additional multiplexers for accepted connections. Each
+  /// multiplexer runs in its own thread.
+  std::vector<multiplexer_ptr> pool_;
+
+  /// Runs the event loops of the multiplexers in `pool_`.
+  std::vector<std::thread> pool_threads_;
+
+  /// Configures whether `select_mpx` picks the multiplexer with the fewest
+  /// socket managers instead of using round-robin.
+  bool least_connections_ = false;
+
+  /// Selects the next multiplexer for round-robin distribution.
+  std::atomic<size_t> next_mpx_ = 0;
+
+  /// Counts completed SSL handshakes, indexed by role (client, server) and
+  /// type (full, resumed).
+  telemetry::int_counter* ssl_handshakes_[2][2];
 };
 
 } // namespace caf::net
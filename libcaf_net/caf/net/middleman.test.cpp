@@ -0,0 +1,230 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/middleman.hpp"
+
+#include "caf/test/test.hpp"
+
+#include "caf/net/lp/with.hpp"
+#include "caf/net/socket_event_layer.hpp"
+#include "caf/net/stream_socket.hpp"
+#include "caf/net/tcp_accept_socket.hpp"
+#include "caf/net/tcp_stream_socket.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/detail/socket_sys_includes.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/scheduled_actor/flow.hpp"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+/// Keeps a socket registered for reading without ever receiving any data.
+class idle_layer : public net::socket_event_layer {
+public:
+  explicit idle_layer(net::stream_socket fd) : fd_(fd) {
+    // nop
+  }
+
+  error start(net::socket_manager* mgr) override {
+    mgr->register_reading();
+    return none;
+  }
+
+  net::socket handle() const override {
+    return fd_;
+  }
+
+  void handle_read_event() override {
+    // nop
+  }
+
+  void handle_write_event() override {
+    // nop
+  }
+
+  void abort(const error&) override {
+    // nop
+  }
+
+private:
+  net::stream_socket fd_;
+};
+
+struct fixture {
+  fixture() {
+    cfg.load<net::middleman>();
+  }
+
+  /// Connects `num_clients` clients to an echo server for length-prefixed
+  /// frames and checks that each client receives its frame back.
+  void run_echo_clients(uint16_t port, size_t num_clients) {
+    std::vector<net::tcp_stream_socket> clients;
+    for (size_t i = 0; i < num_clients; ++i) {
+      auto fd = net::make_connected_tcp_stream_socket("127.0.0.1", port);
+      test::runnable::current().require(fd.has_value());
+      clients.push_back(*fd);
+    }
+    // Each frame consists of a 32-bit length in network byte order and the
+    // payload.
+    auto frame = std::array<std::byte, 6>{std::byte{0}, std::byte{0},
+                                          std::byte{0}, std::byte{2},
+                                          std::byte{'o'}, std::byte{'k'}};
+    for (auto fd : clients) {
+      auto& rt = test::runnable::current();
+      rt.check_eq(net::write(fd, frame), 6);
+      auto buf = std::array<std::byte, 6>{};
+      size_t received = 0;
+      while (received < buf.size()) {
+        auto res = net::read(fd, make_span(buf).subspan(received));
+        if (res <= 0)
+          break;
+        received += static_cast<size_t>(res);
+      }
+      rt.check_eq(received, 6u);
+      rt.check(buf == frame);
+    }
+    for (auto fd : clients)
+      net::close(fd);
+  }
+
+  void start_idle_manager(net::multiplexer* mpx) {
+    auto sockets = net::make_stream_socket_pair();
+    if (!sockets)
+      CAF_RAISE_ERROR("failed to create socket pair");
+    idle_sockets.push_back(sockets->first);
+    auto layer = std::make_unique<idle_layer>(sockets->second);
+    mpx->start(net::socket_manager::make(mpx, std::move(layer)));
+  }
+
+  ~fixture() {
+    for (auto fd : idle_sockets)
+      net::close(fd);
+  }
+
+  actor_system_config cfg;
+  std::vector<net::stream_socket> idle_sockets;
+};
+
+WITH_FIXTURE(fixture) {
+
+TEST("the middleman runs a single multiplexer by default") {
+  actor_system sys{cfg};
+  auto& mm = sys.network_manager();
+  check_eq(mm.num_mpx(), 1u);
+  check_eq(mm.select_mpx(), mm.mpx_ptr());
+  check_eq(mm.select_mpx(), mm.mpx_ptr());
+}
+
+TEST("round-robin distribution selects each multiplexer in turn") {
+  cfg.set("caf.net.multiplexer-threads", 3);
+  actor_system sys{cfg};
+  auto& mm = sys.network_manager();
+  check_eq(mm.num_mpx(), 3u);
+  std::map<net::multiplexer*, size_t> counts;
+  for (int i = 0; i < 9; ++i)
+    ++counts[mm.select_mpx()];
+  check_eq(counts.size(), 3u);
+  for (auto& kvp : counts)
+    check_eq(kvp.second, 3u);
+}
+
+TEST("least-connections distribution selects the least loaded multiplexer") {
+  cfg.set("caf.net.multiplexer-threads", 3);
+  cfg.set("caf.net.connection-distribution", "least-connections");
+  actor_system sys{cfg};
+  auto& mm = sys.network_manager();
+  std::vector<net::multiplexer*> pool;
+  pool.push_back(mm.mpx_ptr());
+  for (int i = 0; i < 3 && pool.size() < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      auto* mpx = mm.select_mpx();
+      if (std::find(pool.begin(), pool.end(), mpx) == pool.end()) {
+        pool.push_back(mpx);
+        break;
+      }
+      start_idle_manager(mpx);
+      start_idle_manager(mpx);
+    }
+  }
+  require_eq(pool.size(), 3u);
+  // Add two managers to all but the last multiplexer.
+  for (size_t i = 0; i < pool.size() - 1; ++i) {
+    start_idle_manager(pool[i]);
+    start_idle_manager(pool[i]);
+  }
+  auto* least_loaded = pool.back();
+  for (auto* mpx : pool)
+    if (mpx->load() < least_loaded->load())
+      least_loaded = mpx;
+  check_eq(mm.select_mpx(), least_loaded);
+}
+
+TEST("acceptors distribute connections across all multiplexers") {
+  cfg.set("caf.net.multiplexer-threads", 3);
+  cfg.set("caf.scheduler.max-threads", 2);
+  actor_system sys{cfg};
+  auto acceptor = net::make_tcp_accept_socket(0, "127.0.0.1");
+  require(acceptor.has_value());
+  auto port = net::local_port(*acceptor);
+  require(port.has_value());
+  // Run an echo server for length-prefixed frames.
+  auto server
+    = net::lp::with(sys)
+        .accept(*acceptor)
+        .start([&sys](net::lp::default_trait::acceptor_resource events) {
+          sys.spawn([events](event_based_actor* self) {
+            events.observe_on(self).for_each([self](const auto& event) {
+              auto& [pull, push] = event.data();
+              pull.observe_on(self).subscribe(push);
+            });
+          });
+        });
+  require(server.has_value());
+  run_echo_clients(*port, 6);
+  server->dispose();
+}
+
+#ifdef SO_REUSEPORT
+
+TEST("servers with reuse_port run one acceptor per multiplexer") {
+  cfg.set("caf.net.multiplexer-threads", 3);
+  cfg.set("caf.scheduler.max-threads", 2);
+  actor_system sys{cfg};
+  // Reserve a port for the server. The probe also uses SO_REUSEPORT, so the
+  // server may bind to the same port before we close the probe.
+  auto probe = net::make_tcp_accept_socket(0, "127.0.0.1", true, true);
+  require(probe.has_value());
+  auto port = net::local_port(*probe);
+  require(port.has_value());
+  auto server
+    = net::lp::with(sys)
+        .accept(*port, "127.0.0.1")
+        .reuse_port(true)
+        .start([&sys](net::lp::default_trait::acceptor_resource events) {
+          sys.spawn([events](event_based_actor* self) {
+            events.observe_on(self).for_each([self](const auto& event) {
+              auto& [pull, push] = event.data();
+              pull.observe_on(self).subscribe(push);
+            });
+          });
+        });
+  net::close(*probe);
+  require(server.has_value());
+  run_echo_clients(*port, 12);
+  server->dispose();
+}
+
+#endif // SO_REUSEPORT
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
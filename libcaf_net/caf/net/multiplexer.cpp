@@ -30,14 +30,22 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <cerrno>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 #ifndef CAF_WINDOWS
 #  include <poll.h>
@@ -46,6 +54,11 @@
 #  include "caf/detail/socket_sys_includes.hpp"
 #endif // CAF_WINDOWS
 
+#ifdef CAF_LINUX
+#  include <sys/epoll.h>
+#  include <unistd.h>
+#endif // CAF_LINUX
+
 namespace caf::net {
 
 namespace {
@@ -72,6 +85,296 @@ const short error_mask = POLLRDHUP | POLLERR | POLLHUP | POLLNVAL;
 
 const short output_mask = POLLOUT;
 
+/// Stores the event masks and managers of all registered sockets and waits for
+/// I/O events on them.
+class pollset {
+public:
+  // -- member types -----------------------------------------------------------
+
+  struct entry {
+    short events = 0;
+    socket_manager_ptr mgr;
+  };
+
+  struct ready_event {
+    socket fd;
+    short revents;
+  };
+
+  using entry_map = std::unordered_map<socket_id, entry>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  virtual ~pollset() {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of registered sockets.
+  size_t size() const noexcept {
+    return entries_.size();
+  }
+
+  /// Returns the entry for `fd` or `nullptr`.
+  const entry* find(socket fd) const noexcept {
+    if (auto i = entries_.find(fd.id); i != entries_.end())
+      return &i->second;
+    return nullptr;
+  }
+
+  /// Returns all registered sockets.
+  const entry_map& entries() const noexcept {
+    return entries_;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Sets the event mask of `fd` and registers or deregisters the socket if
+  /// necessary. Setting the event mask to 0 removes the socket.
+  /// @returns `false` if the operating system refused to add the socket.
+  bool update(socket fd, short events, socket_manager_ptr& mgr) {
+    auto i = entries_.find(fd.id);
+    if (i == entries_.end()) {
+      if (events == 0)
+        return true;
+      if (!add(fd, events))
+        return false;
+      entries_.emplace(fd.id, entry{events, std::move(mgr)});
+      return true;
+    }
+    if (events == 0) {
+      remove(fd);
+      entries_.erase(i);
+      return true;
+    }
+    if (i->second.events != events)
+      modify(fd, events);
+    i->second.events = events;
+    i->second.mgr.swap(mgr);
+    return true;
+  }
+
+  // -- I/O --------------------------------------------------------------------
+
+  /// Waits up to `timeout` milliseconds for I/O events and stores them in
+  /// `result`. A negative timeout blocks indefinitely.
+  /// @returns the number of ready sockets or `-1` on error.
+  virtual int wait(int timeout, std::vector<ready_event>& result) = 0;
+
+  /// Returns a human-readable name of the implementation.
+  virtual std::string_view name() const noexcept = 0;
+
+protected:
+  virtual bool add(socket fd, short events) = 0;
+
+  virtual void modify(socket fd, short events) = 0;
+
+  virtual void remove(socket fd) = 0;
+
+  entry_map entries_;
+};
+
+/// Waits for I/O events by calling `poll()` on a list of `pollfd` entries.
+class poll_pollset : public pollset {
+public:
+  int wait(int timeout, std::vector<ready_event>& result) override {
+    result.clear();
+#ifdef CAF_WINDOWS
+    auto presult = ::WSAPoll(fds_.data(), static_cast<ULONG>(fds_.size()),
+                             timeout);
+#else
+    auto presult = ::poll(fds_.data(), static_cast<nfds_t>(fds_.size()),
+                          timeout);
+#endif
+    if (presult <= 0)
+      return presult;
+    for (auto& x : fds_)
+      if (x.revents != 0)
+        result.emplace_back(ready_event{socket{x.fd}, x.revents});
+    return presult;
+  }
+
+  std::string_view name() const noexcept override {
+    return "poll";
+  }
+
+protected:
+  bool add(socket fd, short events) override {
+    indexes_.emplace(fd.id, fds_.size());
+    fds_.emplace_back(pollfd{fd.id, events, 0});
+    return true;
+  }
+
+  void modify(socket fd, short events) override {
+    fds_[indexes_[fd.id]].events = events;
+  }
+
+  void remove(socket fd) override {
+    // Swap the last entry into the free slot to avoid shifting the list.
+    auto i = indexes_.find(fd.id);
+    auto index = i->second;
+    indexes_.erase(i);
+    if (index != fds_.size() - 1) {
+      fds_[index] = fds_.back();
+      indexes_[fds_[index].fd] = index;
+    }
+    fds_.pop_back();
+  }
+
+private:
+  /// Bookkeeping data for `poll()`.
+  std::vector<pollfd> fds_;
+
+  /// Maps sockets to their position in `fds_`.
+  std::unordered_map<socket_id, size_t> indexes_;
+};
+
+#ifdef CAF_LINUX
+
+/// Waits for I/O events via `epoll`. Unlike `poll()`, the kernel keeps the
+/// interest list, i.e., each call to `wait` only returns ready sockets instead
+/// of scanning all registered sockets. Uses level-triggered notifications,
+/// because socket managers may stop reading before draining their socket (see
+/// `caf.middleman.max-consecutive-reads`).
+class epoll_pollset : public pollset {
+public:
+  ~epoll_pollset() override {
+    if (epfd_ != -1)
+      ::close(epfd_);
+  }
+
+  /// Creates the `epoll` instance.
+  /// @returns `false` if the kernel refused to create the instance.
+  bool init() {
+    epfd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epfd_ == -1)
+      return false;
+    events_.resize(64);
+    return true;
+  }
+
+  int wait(int timeout, std::vector<ready_event>& result) override {
+    result.clear();
+    auto eresult = ::epoll_wait(epfd_, events_.data(),
+                                static_cast<int>(events_.size()), timeout);
+    if (eresult <= 0)
+      return eresult;
+    for (int i = 0; i < eresult; ++i) {
+      auto& x = events_[i];
+      result.emplace_back(ready_event{socket{x.data.fd}, to_poll(x.events)});
+    }
+    // Grow the buffer if it was too small to hold all events at once.
+    if (static_cast<size_t>(eresult) == events_.size())
+      events_.resize(events_.size() * 2);
+    return eresult;
+  }
+
+  std::string_view name() const noexcept override {
+    return "epoll";
+  }
+
+protected:
+  bool add(socket fd, short events) override {
+    if (ctl(EPOLL_CTL_ADD, fd, events) == 0)
+      return true;
+    // The socket may still be in the interest list if the previous owner of
+    // the file descriptor did not deregister before closing it.
+    if (errno == EEXIST && ctl(EPOLL_CTL_MOD, fd, events) == 0)
+      return true;
+    log::system::error("epoll_ctl failed to add socket {}: {}", fd.id,
+                       last_socket_error_as_string());
+    return false;
+  }
+
+  void modify(socket fd, short events) override {
+    if (ctl(EPOLL_CTL_MOD, fd, events) == 0)
+      return;
+    // The kernel removes closed file descriptors automatically. Hence, a new
+    // socket with the same file descriptor requires a new registration.
+    if (errno == ENOENT && ctl(EPOLL_CTL_ADD, fd, events) == 0)
+      return;
+    log::system::error("epoll_ctl failed to modify socket {}: {}", fd.id,
+                       last_socket_error_as_string());
+  }
+
+  void remove(socket fd) override {
+    // Errors are expected if the socket has been closed already.
+    ctl(EPOLL_CTL_DEL, fd, 0);
+  }
+
+private:
+  int ctl(int op, socket fd, short events) {
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = to_epoll(events);
+    ev.data.fd = fd.id;
+    return ::epoll_ctl(epfd_, op, fd.id, &ev);
+  }
+
+  static uint32_t to_epoll(short events) noexcept {
+    uint32_t result = 0;
+    if ((events & POLLIN) != 0)
+      result |= EPOLLIN;
+    if ((events & POLLPRI) != 0)
+      result |= EPOLLPRI;
+    if ((events & POLLOUT) != 0)
+      result |= EPOLLOUT;
+    return result;
+  }
+
+  static short to_poll(uint32_t events) noexcept {
+    short result = 0;
+    if ((events & EPOLLIN) != 0)
+      result |= POLLIN;
+    if ((events & EPOLLPRI) != 0)
+      result |= POLLPRI;
+    if ((events & EPOLLOUT) != 0)
+      result |= POLLOUT;
+    if ((events & EPOLLERR) != 0)
+      result |= POLLERR;
+    if ((events & EPOLLHUP) != 0)
+      result |= POLLHUP;
+    if ((events & EPOLLRDHUP) != 0)
+      result |= POLLRDHUP;
+    return result;
+  }
+
+  /// The file descriptor of the epoll instance.
+  int epfd_ = -1;
+
+  /// Receives the ready events from the kernel.
+  std::vector<epoll_event> events_;
+};
+
+#endif // CAF_LINUX
+
+/// Creates a new pollset for `backend`. Falls back to `poll` if the backend is
+/// unknown or not available on this platform.
+std::unique_ptr<pollset> make_pollset(std::string_view backend) {
+  if (backend == "epoll") {
+#ifdef CAF_LINUX
+    auto result = std::make_unique<epoll_pollset>();
+    if (result->init())
+      return result;
+    fprintf(stderr,
+            "[WARNING] failed to create an epoll instance, falling back to "
+            "'poll'\n");
+#else
+    fprintf(stderr,
+            "[WARNING] 'epoll' is not available on this platform, falling "
+            "back to 'poll'\n");
+#endif
+    return std::make_unique<poll_pollset>();
+  }
+  if (backend != "poll")
+    fprintf(stderr,
+            "[WARNING] '%s' is an unrecognized multiplexer backend, falling "
+            "back to 'poll'\n",
+            std::string{backend}.c_str());
+  return std::make_unique<poll_pollset>();
+}
+
 class pollset_updater : public socket_event_layer {
 public:
   // -- member types -----------------------------------------------------------
@@ -140,9 +443,7 @@ public:
 
   using poll_update_map = unordered_flat_map<socket, poll_update>;
 
-  using pollfd_list = std::vector<pollfd>;
-
-  using manager_list = std::vector<socket_manager_ptr>;
+  using ready_event_list = std::vector<pollset::ready_event>;
 
   // -- friends ----------------------------------------------------------------
 
@@ -150,7 +451,8 @@ public:
 
   // -- constructors, destructors, and assignment operators --------------------
 
-  explicit default_multiplexer(middleman* parent) : owner_(parent) {
+  default_multiplexer(middleman* parent, std::unique_ptr<pollset> fds)
+    : pollset_(std::move(fds)), owner_(parent) {
     // nop
   }
 
@@ -167,13 +469,35 @@ public:
       return err;
     }
     write_handle_ = pipe_handles->second;
-    pollset_.emplace_back(pollfd{pipe_handles->first.id, input_mask, 0});
-    managers_.emplace_back(mgr);
+    updater_fd_ = pipe_handles->first;
+    if (!pollset_->update(updater_fd_, input_mask, mgr)) {
+      close(write_handle_);
+      write_handle_ = pipe_socket{};
+      return make_error(sec::runtime_error,
+                        "failed to add the pollset updater to the pollset");
+    }
+    log::net::debug("initialized multiplexer with backend {}",
+                    pollset_->name());
     return none;
   }
 
   size_t num_socket_managers() const noexcept override {
-    return managers_.size();
+    return pollset_->size();
+  }
+
+  size_t load() const noexcept override {
+    return num_registered_.load(std::memory_order_relaxed)
+           + num_pending_.load(std::memory_order_relaxed);
+  }
+
+  multiplexer* select_for_connection() noexcept override {
+    return owner_ != nullptr ? owner_->select_mpx() : this;
+  }
+
+  std::vector<multiplexer*> pool() override {
+    if (owner_ != nullptr)
+      return owner_->mpx_pool();
+    return {this};
   }
 
   middleman& owner() override {
@@ -184,6 +508,10 @@ public:
     return owner().system();
   }
 
+  middleman* owner_ptr() noexcept override {
+    return owner_;
+  }
+
   // -- implementation of execution_context ------------------------------------
 
   void ref_execution_context() const noexcept override {
@@ -215,7 +543,14 @@ public:
   }
 
   void watch(disposable what) override {
-    watched_.emplace_back(what);
+    if (std::this_thread::get_id() == tid_) {
+      watched_.emplace_back(std::move(what));
+    } else {
+      // Acceptors may create connections for other multiplexers.
+      schedule_fn([this, what = std::move(what)]() mutable {
+        watched_.emplace_back(std::move(what));
+      });
+    }
   }
 
   // -- thread-safe signaling --------------------------------------------------
@@ -225,6 +560,7 @@ public:
     if (std::this_thread::get_id() == tid_) {
       do_start(mgr);
     } else {
+      num_pending_.fetch_add(1, std::memory_order_relaxed);
       write_to_pipe(pollset_updater::code::start_manager, mgr.release());
     }
   }
@@ -278,9 +614,9 @@ public:
 
   bool poll_once(bool blocking) override {
     auto lg = log::net::trace("blocking = {}", blocking);
-    if (pollset_.empty())
+    if (pollset_->size() == 0)
       return false;
-    // We'll call poll() until poll() succeeds or fails.
+    // We'll call wait() until it succeeds or fails.
     for (;;) {
       int timeout = 0;
       if (!blocking) {
@@ -296,33 +632,35 @@ public:
           timeout = std::max(1, static_cast<int>(ms));
         }
       }
-      int presult =
-#ifdef CAF_WINDOWS
-        ::WSAPoll(pollset_.data(), static_cast<ULONG>(pollset_.size()),
-                  timeout);
-#else
-        ::poll(pollset_.data(), static_cast<nfds_t>(pollset_.size()), timeout);
-#endif
+      auto presult = pollset_->wait(timeout, ready_);
       if (presult > 0) {
-        log::net::debug("poll() on {} sockets reported event(s) {}",
-                        pollset_.size(), presult);
-        // Scan pollset for events.
-        if (auto revents = pollset_[0].revents; revents != 0) {
-          // Index 0 is always the pollset updater. This is the only handler
-          // that is allowed to modify pollset_ and managers_. Since this may
-          // very well mess with the for loop below, we process this handler
-          // first.
-          auto mgr = managers_[0];
-          handle(mgr, pollset_[0].events, revents);
-          --presult;
+        log::net::debug("{}() on {} sockets reported event(s) {}",
+                        pollset_->name(), pollset_->size(), presult);
+        // The pollset updater is the only handler that is allowed to modify
+        // the pollset. Since this may very well mess with the loop below, we
+        // process this handler first.
+        for (auto& ev : ready_) {
+          if (ev.fd == updater_fd_) {
+            if (auto* ptr = pollset_->find(updater_fd_)) {
+              auto mgr = ptr->mgr;
+              handle(mgr, ptr->events, ev.revents);
+            }
+            ev.revents = 0;
+            break;
+          }
         }
         apply_updates();
-        for (size_t i = 1; i < pollset_.size() && presult > 0; ++i) {
-          if (auto revents = pollset_[i].revents; revents != 0) {
-            handle(managers_[i], pollset_[i].events, revents);
-            --presult;
+        for (auto& ev : ready_) {
+          if (ev.revents == 0)
+            continue;
+          // Skip sockets that have been removed from the pollset in the
+          // meantime.
+          if (auto* ptr = pollset_->find(ev.fd)) {
+            auto mgr = ptr->mgr;
+            handle(mgr, ptr->events, ev.revents);
           }
         }
+        ready_.clear();
         run_timeouts();
         return true;
       }
@@ -373,30 +711,27 @@ public:
     log::net::debug("apply {} updates", updates_.size());
     for (;;) {
       if (!updates_.empty()) {
-        for (auto& [fd, update] : updates_) {
-          if (auto index = index_of(fd); index == -1) {
-            if (update.events != 0) {
-              pollfd new_entry{socket_cast<socket_id>(fd), update.events, 0};
-              pollset_.emplace_back(new_entry);
-              managers_.emplace_back(std::move(update.mgr));
-            }
-          } else if (update.events != 0) {
-            pollset_[index].events = update.events;
-            managers_[index].swap(update.mgr);
-          } else {
-            pollset_.erase(pollset_.begin() + index);
-            managers_.erase(managers_.begin() + index);
-          }
-        }
+        for (auto& [fd, update] : updates_)
+          if (!pollset_->update(fd, update.events, update.mgr))
+            failed_.emplace_back(std::move(update.mgr));
         updates_.clear();
       }
+      // Report errors only after applying all updates, because the managers
+      // may deregister in their error handler.
+      while (!failed_.empty()) {
+        auto mgr = std::move(failed_.back());
+        failed_.pop_back();
+        mgr->handle_error(sec::socket_operation_failed);
+      }
       while (!pending_actions.empty()) {
         auto next = std::move(pending_actions.front());
         pending_actions.pop_front();
         next.run();
       }
-      if (updates_.empty())
+      if (updates_.empty()) {
+        num_registered_.store(pollset_->size(), std::memory_order_relaxed);
         return;
+      }
     }
   }
 
@@ -414,7 +749,7 @@ public:
     // need to block the signal at thread level since some APIs (such as
     // OpenSSL) are unsafe to call otherwise.
     block_sigpipe();
-    while (!shutting_down_ || pollset_.size() > 1 || !watched_.empty()) {
+    while (!shutting_down_ || pollset_->size() > 1 || !watched_.empty()) {
       poll_once(true);
       disposable::erase_disposed(watched_);
     }
@@ -434,9 +769,14 @@ public:
     log::net::debug("initiate shutdown");
     shutting_down_ = true;
     apply_updates();
-    // Skip the first manager (the pollset updater).
-    for (size_t i = 1; i < managers_.size(); ++i)
-      managers_[i]->dispose();
+    // Skip the pollset updater.
+    std::vector<socket_manager_ptr> managers;
+    managers.reserve(pollset_->size());
+    for (auto& [fd, entry] : pollset_->entries())
+      if (fd != updater_fd_.id)
+        managers.emplace_back(entry.mgr);
+    for (auto& mgr : managers)
+      mgr->dispose();
     apply_updates();
   }
 
@@ -456,23 +796,6 @@ public:
 
   // -- utility functions ------------------------------------------------------
 
-  /// Returns the index of `mgr` in the pollset or `-1`.
-  ptrdiff_t index_of(const socket_manager_ptr& mgr) const noexcept {
-    auto first = managers_.begin();
-    auto last = managers_.end();
-    auto i = std::find(first, last, mgr);
-    return i == last ? -1 : std::distance(first, i);
-  }
-
-  /// Returns the index of `fd` in the pollset or `-1`.
-  ptrdiff_t index_of(socket fd) const noexcept {
-    auto first = pollset_.begin();
-    auto last = pollset_.end();
-    auto i = std::find_if(first, last,
-                          [fd](const pollfd& x) { return x.fd == fd.id; });
-    return i == last ? -1 : std::distance(first, i);
-  }
-
   /// Handles an I/O event on given manager.
   void handle(const socket_manager_ptr& mgr, [[maybe_unused]] short events,
               short revents) {
@@ -505,27 +828,14 @@ public:
     }
   }
 
-  /// Returns a change entry for the socket at given index. Lazily creates a new
-  /// entry before returning if necessary.
-  poll_update& update_for(ptrdiff_t index) {
-    auto fd = socket{pollset_[index].fd};
-    if (auto i = updates_.find(fd); i != updates_.end()) {
-      return i->second;
-    } else {
-      updates_.container().emplace_back(fd, poll_update{pollset_[index].events,
-                                                        managers_[index]});
-      return updates_.container().back().second;
-    }
-  }
-
   /// Returns a change entry for the socket of the manager.
   poll_update& update_for(socket_manager* mgr) {
     auto fd = mgr->handle();
     if (auto i = updates_.find(fd); i != updates_.end()) {
       return i->second;
-    } else if (auto index = index_of(fd); index != -1) {
+    } else if (auto* ptr = pollset_->find(fd)) {
       updates_.container().emplace_back(
-        fd, poll_update{pollset_[index].events, socket_manager_ptr{mgr}});
+        fd, poll_update{ptr->events, socket_manager_ptr{mgr}});
       return updates_.container().back().second;
     } else {
       updates_.container().emplace_back(fd, poll_update{0, mgr});
@@ -549,7 +859,10 @@ public:
       if (write_handle_ != invalid_socket)
         res = write(write_handle_, buf);
     }
-    if constexpr (std::is_base_of_v<detail::atomic_ref_counted, T>) {
+    if constexpr (std::is_base_of_v<detail::atomic_ref_counted, T>
+                  || std::is_base_of_v<disposable::impl, T>) {
+      // Actions may have other owners, e.g., when scheduling an action on a
+      // multiplexer that already shut down.
       if (res <= 0 && ptr)
         intrusive_ptr_release(ptr);
     } else {
@@ -569,8 +882,8 @@ public:
     auto fd = mgr->handle();
     if (auto i = updates_.find(fd); i != updates_.end()) {
       return i->second.events;
-    } else if (auto index = index_of(fd); index != -1) {
-      return pollset_[index].events;
+    } else if (auto* ptr = pollset_->find(fd)) {
+      return ptr->events;
     } else {
       return 0;
     }
@@ -589,11 +902,23 @@ private:
   // -- member variables -------------------------------------------------------
 
   /// Bookkeeping data for managed sockets.
-  pollfd_list pollset_;
+  std::unique_ptr<pollset> pollset_;
+
+  /// The read handle of the pipe for the pollset updater.
+  socket updater_fd_;
+
+  /// Stores the ready sockets of the current iteration.
+  ready_event_list ready_;
 
-  /// Maps sockets to their owning managers by storing the managers in the same
-  /// order as their sockets appear in `pollset_`.
-  manager_list managers_;
+  /// Stores managers that the pollset failed to register.
+  std::vector<socket_manager_ptr> failed_;
+
+  /// Mirrors the size of the pollset for other threads.
+  std::atomic<size_t> num_registered_ = 0;
+
+  /// Counts managers that other threads have passed to `start` but that the
+  /// multiplexer did not start yet.
+  std::atomic<size_t> num_pending_ = 0;
 
   /// Caches changes to the events mask of managed sockets until they can safely
   /// take place.
@@ -653,6 +978,7 @@ void pollset_updater::handle_read_event() {
         memcpy(&ptr, buf_.data() + 1, sizeof(intptr_t));
         switch (static_cast<code>(opcode)) {
           case code::start_manager:
+            mpx_->num_pending_.fetch_sub(1, std::memory_order_relaxed);
             mpx_->do_start(as_mgr(ptr));
             break;
           case code::run_action:
@@ -704,7 +1030,11 @@ void multiplexer::block_sigpipe() {
 }
 
 multiplexer_ptr multiplexer::make(middleman* parent) {
-  return make_counted<default_multiplexer>(parent);
+  return make(parent, "poll");
+}
+
+multiplexer_ptr multiplexer::make(middleman* parent, std::string_view backend) {
+  return make_counted<default_multiplexer>(parent, make_pollset(backend));
 }
 
 multiplexer* multiplexer::from(actor_system& sys) {
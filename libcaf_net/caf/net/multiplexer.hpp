@@ -13,7 +13,9 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 namespace caf::net {
 
@@ -49,6 +51,13 @@ public:
   ///               @ref actor_system.
   static multiplexer_ptr make(middleman* parent);
 
+  /// Creates a new multiplexer instance that waits for I/O events via
+  /// `backend`. Currently supported backends are `poll` (all platforms) and
+  /// `epoll` (Linux only). Falls back to `poll` if `backend` is not available.
+  /// @param parent Points to the owning middleman instance.
+  /// @param backend The name of the I/O event notification mechanism.
+  static multiplexer_ptr make(middleman* parent, std::string_view backend);
+
   // -- initialization ---------------------------------------------------------
 
   virtual error init() = 0;
@@ -72,12 +81,30 @@ public:
   /// Returns the number of currently active socket managers.
   virtual size_t num_socket_managers() const noexcept = 0;
 
+  /// Returns the approximate number of socket managers of this multiplexer,
+  /// including managers that are about to start.
+  /// @thread-safe
+  virtual size_t load() const noexcept = 0;
+
+  /// Returns the multiplexer for a new connection. Unless the owning
+  /// @ref middleman runs a pool of multiplexers, this function returns `this`.
+  /// @thread-safe
+  virtual multiplexer* select_for_connection() noexcept = 0;
+
+  /// Returns all multiplexers of the owning @ref middleman, starting with its
+  /// primary multiplexer. Returns only `this` if there is no owner.
+  virtual std::vector<multiplexer*> pool() = 0;
+
   /// Returns the owning @ref middleman instance.
   virtual middleman& owner() = 0;
 
   /// Returns the enclosing @ref actor_system.
   virtual actor_system& system() = 0;
 
+  /// Returns a pointer to the owning @ref middleman or `nullptr` if the
+  /// multiplexer has no owner.
+  virtual middleman* owner_ptr() noexcept = 0;
+
   // -- thread-safe signaling --------------------------------------------------
 
   /// Registers `mgr` for initialization in the multiplexer's thread.
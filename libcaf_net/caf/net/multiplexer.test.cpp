@@ -0,0 +1,183 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/multiplexer.hpp"
+
+#include "caf/test/outline.hpp"
+#include "caf/test/test.hpp"
+
+#include "caf/net/socket_event_layer.hpp"
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/stream_socket.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/raise_error.hpp"
+#include "caf/span.hpp"
+
+#include <string_view>
+#include <vector>
+
+using namespace caf;
+
+namespace {
+
+/// Reads all incoming bytes into a buffer.
+class reader : public net::socket_event_layer {
+public:
+  explicit reader(net::stream_socket fd) : fd_(fd) {
+    // nop
+  }
+
+  error start(net::socket_manager* mgr) override {
+    mgr_ = mgr;
+    mgr_->register_reading();
+    return none;
+  }
+
+  net::socket handle() const override {
+    return fd_;
+  }
+
+  void handle_read_event() override {
+    std::byte tmp[512];
+    auto res = read(fd_, make_span(tmp));
+    if (res > 0)
+      received.insert(received.end(), tmp, tmp + res);
+    else if (res == 0 || !net::last_socket_error_is_temporary())
+      mgr_->deregister();
+  }
+
+  void handle_write_event() override {
+    mgr_->deregister_writing();
+  }
+
+  void abort(const error&) override {
+    // nop
+  }
+
+  byte_buffer received;
+
+private:
+  net::stream_socket fd_;
+  net::socket_manager* mgr_ = nullptr;
+};
+
+struct connection {
+  net::socket_guard<net::stream_socket> writer;
+  net::socket_manager_ptr mgr;
+  reader* impl;
+};
+
+struct fixture {
+  void init(std::string_view backend) {
+    mpx = net::multiplexer::make(nullptr, backend);
+    mpx->set_thread_id();
+    if (auto err = mpx->init())
+      CAF_RAISE_ERROR("mpx->init failed");
+  }
+
+  connection& add_connection() {
+    auto maybe_sockets = net::make_stream_socket_pair();
+    if (!maybe_sockets)
+      CAF_RAISE_ERROR("failed to create socket pair");
+    auto [fd1, fd2] = *maybe_sockets;
+    if (auto err = nonblocking(fd2, true))
+      CAF_RAISE_ERROR("failed to set socket to nonblocking");
+    auto impl = std::make_unique<reader>(fd2);
+    auto impl_ptr = impl.get();
+    auto mgr = net::socket_manager::make(mpx.get(), std::move(impl));
+    if (auto err = mgr->start())
+      CAF_RAISE_ERROR("failed to start socket manager");
+    connections.emplace_back(
+      connection{net::make_socket_guard(fd1), std::move(mgr), impl_ptr});
+    return connections.back();
+  }
+
+  void send(connection& conn, std::string_view str) {
+    if (write(conn.writer.socket(), as_bytes(make_span(str)))
+        != static_cast<ptrdiff_t>(str.size()))
+      CAF_RAISE_ERROR("failed to write to socket");
+  }
+
+  static std::string received(const connection& conn) {
+    auto& buf = conn.impl->received;
+    return std::string{reinterpret_cast<const char*>(buf.data()), buf.size()};
+  }
+
+  void exhaust() {
+    mpx->apply_updates();
+    while (mpx->poll_once(false))
+      ; // Repeat.
+  }
+
+  ~fixture() {
+    if (mpx) {
+      mpx->shutdown();
+      exhaust();
+    }
+  }
+
+  net::multiplexer_ptr mpx;
+  std::vector<connection> connections;
+};
+
+WITH_FIXTURE(fixture) {
+
+OUTLINE("the multiplexer dispatches I/O events") {
+  GIVEN("a multiplexer with the <backend> backend and 100 sockets") {
+    init(block_parameters<std::string>());
+    connections.reserve(100);
+    for (int i = 0; i < 100; ++i)
+      add_connection();
+    mpx->apply_updates();
+    check_eq(mpx->num_socket_managers(), 101u);
+    WHEN("sending data to all sockets") {
+      for (auto& conn : connections)
+        send(conn, "hello");
+      THEN("the multiplexer calls the socket managers on incoming data") {
+        exhaust();
+        for (auto& conn : connections)
+          check_eq(received(conn), "hello");
+      }
+    }
+    // TODO: Change to WHEN block after fixing issue #1776.
+    AND_WHEN("removing every other socket before sending data") {
+      for (auto& conn : connections)
+        conn.impl->received.clear();
+      for (size_t i = 0; i < connections.size(); i += 2)
+        connections[i].mgr->deregister();
+      mpx->apply_updates();
+      for (auto& conn : connections)
+        send(conn, "world");
+      THEN("the multiplexer only calls the remaining socket managers") {
+        check_eq(mpx->num_socket_managers(), 51u);
+        exhaust();
+        for (size_t i = 0; i < connections.size(); ++i) {
+          if (i % 2 == 0)
+            check_eq(received(connections[i]), "");
+          else
+            check_eq(received(connections[i]), "world");
+        }
+      }
+    }
+  }
+  EXAMPLES = R"(
+    | backend |
+    | poll    |
+    | epoll   |
+  )";
+}
+
+TEST("the multiplexer falls back to poll for unknown backends") {
+  init("foobar");
+  auto& conn = add_connection();
+  send(conn, "hello");
+  exhaust();
+  check_eq(received(conn), "hello");
+}
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
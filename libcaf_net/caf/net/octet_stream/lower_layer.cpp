@@ -4,10 +4,23 @@
 
 #include "caf/net/octet_stream/lower_layer.hpp"
 
+#include "caf/chunk.hpp"
+
 namespace caf::net::octet_stream {
 
 lower_layer::~lower_layer() {
   // nop
 }
 
+void lower_layer::enqueue_output(byte_buffer buf) {
+  auto& out = output_buffer();
+  out.insert(out.end(), buf.begin(), buf.end());
+}
+
+void lower_layer::enqueue_output(chunk buf) {
+  auto& out = output_buffer();
+  auto bytes = buf.bytes();
+  out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
 } // namespace caf::net::octet_stream
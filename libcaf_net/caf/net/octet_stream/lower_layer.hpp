@@ -7,15 +7,22 @@
 #include "caf/net/fwd.hpp"
 #include "caf/net/generic_lower_layer.hpp"
 
+#include "caf/byte_buffer.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
 
+#include <cstddef>
+
 namespace caf::net::octet_stream {
 
 /// Provides access to a resource that operates on a byte stream, e.g., a TCP
 /// socket.
 class CAF_NET_EXPORT lower_layer : public generic_lower_layer {
 public:
+  /// Payloads below this size are cheaper to copy into the output buffer than
+  /// to send from a separate buffer.
+  static constexpr size_t min_enqueue_size = 1024;
+
   virtual ~lower_layer();
 
   /// Queries whether the transport is currently configured to read from its
@@ -40,6 +47,16 @@ public:
   /// registering sockets for write events.
   virtual bool end_output() = 0;
 
+  /// Adds `buf` to the output without copying it. The layer sends `buf` after
+  /// all bytes that are currently in the output buffer and before any bytes
+  /// that users add to the output buffer afterwards. Users may only call this
+  /// function between calling `begin_output()` and `end_output()`. The default
+  /// implementation copies `buf` into the output buffer.
+  virtual void enqueue_output(byte_buffer buf);
+
+  /// @copydoc enqueue_output
+  virtual void enqueue_output(chunk buf);
+
   /// Asks the stream to swap the current upper layer with `next` after
   /// returning from `consume()`.
   /// @note may only be called from the upper layer in `consume`.
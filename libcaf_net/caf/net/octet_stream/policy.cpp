@@ -3,10 +3,25 @@
 #include "caf/net/octet_stream/errc.hpp"
 #include "caf/net/stream_socket.hpp"
 
+#include "caf/span.hpp"
+
 namespace caf::net::octet_stream {
 
 policy::~policy() {
   // nop
 }
 
+ptrdiff_t policy::writev(span<const const_byte_span> bufs) {
+  ptrdiff_t total = 0;
+  for (auto buf : bufs) {
+    auto res = write(buf);
+    if (res <= 0)
+      return total > 0 ? total : res;
+    total += res;
+    if (static_cast<size_t>(res) < buf.size())
+      break;
+  }
+  return total;
+}
+
 } // namespace caf::net::octet_stream
@@ -28,6 +28,12 @@ public:
   /// Writes data from the buffer to the socket.
   virtual ptrdiff_t write(const_byte_span buf) = 0;
 
+  /// Writes data from multiple buffers to the socket. The default
+  /// implementation calls `write` for each buffer until the socket stops
+  /// accepting data.
+  /// @pre `bufs` contains no empty buffers.
+  virtual ptrdiff_t writev(span<const const_byte_span> bufs);
+
   /// Returns the last socket error on this thread.
   virtual errc last_error(ptrdiff_t) = 0;
 
@@ -11,6 +11,7 @@
 #include "caf/defaults.hpp"
 #include "caf/log/net.hpp"
 
+#include <algorithm>
 #include <new>
 
 namespace caf::net::octet_stream {
@@ -29,6 +30,10 @@ ptrdiff_t transport::policy_impl::write(const_byte_span buf) {
   return net::write(fd, buf);
 }
 
+ptrdiff_t transport::policy_impl::writev(span<const const_byte_span> bufs) {
+  return net::write(fd, bufs);
+}
+
 errc transport::policy_impl::last_error(ptrdiff_t) {
   return last_socket_error_is_temporary() ? errc::temporary : errc::permanent;
 }
@@ -80,7 +85,7 @@ multiplexer& transport::mpx() noexcept {
 }
 
 bool transport::can_send_more() const noexcept {
-  return write_buf_.size() < max_write_buf_size_;
+  return pending_output() < max_write_buf_size_;
 }
 
 void transport::configure_read(receive_policy rd) {
@@ -107,7 +112,7 @@ void transport::configure_read(receive_policy rd) {
 }
 
 void transport::begin_output() {
-  if (write_buf_.empty())
+  if (pending_output() == 0)
     parent_->register_writing();
 }
 
@@ -119,6 +124,29 @@ bool transport::end_output() {
   return true;
 }
 
+void transport::enqueue_output(byte_buffer buf) {
+  if (buf.size() < min_enqueue_size) {
+    write_buf_.insert(write_buf_.end(), buf.begin(), buf.end());
+    return;
+  }
+  // Note: moving a vector leaves its data pointer intact.
+  auto bytes = const_byte_span{buf};
+  enqueued_bytes_ += bytes.size();
+  enqueued_.push_back(
+    enqueued_buffer{write_buf_.size(), std::move(buf), bytes});
+}
+
+void transport::enqueue_output(chunk buf) {
+  auto bytes = buf.bytes();
+  if (bytes.size() < min_enqueue_size) {
+    write_buf_.insert(write_buf_.end(), bytes.begin(), bytes.end());
+    return;
+  }
+  enqueued_bytes_ += bytes.size();
+  enqueued_.push_back(
+    enqueued_buffer{write_buf_.size(), std::move(buf), bytes});
+}
+
 bool transport::is_reading() const noexcept {
   return max_read_size_ > 0;
 }
@@ -128,7 +156,7 @@ void transport::write_later() {
 }
 
 void transport::shutdown() {
-  if (write_buf_.empty()) {
+  if (pending_output() == 0) {
     parent_->shutdown();
   } else {
     configure_read(receive_policy::stop());
@@ -293,6 +321,52 @@ void transport::handle_buffered_data() {
   }
 }
 
+ptrdiff_t transport::flush_output() {
+  if (enqueued_.empty())
+    return policy_->write(write_buf_);
+  // Interleave the slices of write_buf_ with the enqueued buffers.
+  write_bufs_.clear();
+  auto add = [this](const_byte_span bytes) {
+    if (!bytes.empty())
+      write_bufs_.push_back(bytes);
+  };
+  size_t pos = 0;
+  for (auto& entry : enqueued_) {
+    if (write_bufs_.size() + 2 > max_write_buffers)
+      return policy_->writev(write_bufs_);
+    add(make_span(write_buf_.data() + pos, entry.offset - pos));
+    add(entry.bytes);
+    pos = entry.offset;
+  }
+  add(make_span(write_buf_.data() + pos, write_buf_.size() - pos));
+  return policy_->writev(write_bufs_);
+}
+
+void transport::drop_output(size_t num_bytes) {
+  // Counts how many bytes we drop from the front of write_buf_.
+  size_t pos = 0;
+  while (num_bytes > 0 && !enqueued_.empty()) {
+    auto& front = enqueued_.front();
+    auto n = std::min(num_bytes, front.offset - pos);
+    pos += n;
+    num_bytes -= n;
+    if (num_bytes == 0)
+      break;
+    auto m = std::min(num_bytes, front.bytes.size());
+    front.bytes = front.bytes.subspan(m);
+    enqueued_bytes_ -= m;
+    num_bytes -= m;
+    if (front.bytes.empty())
+      enqueued_.pop_front();
+  }
+  pos += num_bytes;
+  CAF_ASSERT(pos <= write_buf_.size());
+  write_buf_.erase(write_buf_.begin(),
+                   write_buf_.begin() + static_cast<ptrdiff_t>(pos));
+  for (auto& entry : enqueued_)
+    entry.offset -= pos;
+}
+
 void transport::fail(const error& reason) {
   auto lg = log::net::trace("reason = {}", reason);
   up_->abort(reason);
@@ -318,7 +392,7 @@ void transport::handle_write_event() {
   }
   // When shutting down, we flush our buffer and then shut down the manager.
   if (flags_.shutting_down) {
-    if (write_buf_.empty()) {
+    if (pending_output() == 0) {
       parent_->shutdown();
       return;
     }
@@ -326,11 +400,11 @@ void transport::handle_write_event() {
     // Allow the upper layer to add extra data to the write buffer.
     up_->prepare_send();
   }
-  auto write_res = policy_->write(write_buf_);
+  auto write_res = flush_output();
   if (write_res > 0) {
-    write_buf_.erase(write_buf_.begin(), write_buf_.begin() + write_res);
+    drop_output(static_cast<size_t>(write_res));
     up_->written(static_cast<size_t>(write_res));
-    if (write_buf_.empty() && up_->done_sending()) {
+    if (pending_output() == 0 && up_->done_sending()) {
       if (!flags_.shutting_down) {
         parent_->deregister_writing();
       } else {
@@ -365,7 +439,7 @@ void transport::abort(const error& reason) {
 }
 
 bool transport::finalized() const noexcept {
-  return write_buf_.empty();
+  return pending_output() == 0;
 }
 
 } // namespace caf::net::octet_stream
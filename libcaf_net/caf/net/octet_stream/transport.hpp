@@ -12,11 +12,14 @@
 #include "caf/net/stream_socket.hpp"
 
 #include "caf/byte_buffer.hpp"
+#include "caf/chunk.hpp"
 #include "caf/defaults.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
 
 #include <deque>
+#include <variant>
+#include <vector>
 
 namespace caf::net::octet_stream {
 
@@ -54,6 +57,8 @@ public:
 
     ptrdiff_t write(const_byte_span) override;
 
+    ptrdiff_t writev(span<const const_byte_span>) override;
+
     octet_stream::errc last_error(ptrdiff_t) override;
 
     ptrdiff_t connect() override;
@@ -99,6 +104,10 @@ public:
 
   bool end_output() override;
 
+  void enqueue_output(byte_buffer buf) override;
+
+  void enqueue_output(chunk buf) override;
+
   bool is_reading() const noexcept override;
 
   void write_later() override;
@@ -127,6 +136,12 @@ public:
     return write_buf_;
   }
 
+  /// Returns the number of bytes that wait for transfer, including bytes in
+  /// enqueued buffers.
+  size_t pending_output() const noexcept {
+    return write_buf_.size() + enqueued_bytes_;
+  }
+
   auto& upper_layer() noexcept {
     return *up_;
   }
@@ -170,6 +185,27 @@ protected:
   /// Calls abort on the upper layer and deregisters the transport from events.
   void fail(const error& reason);
 
+  /// Writes pending output to the socket, using a single vectored write if the
+  /// upper layer has enqueued buffers.
+  ptrdiff_t flush_output();
+
+  /// Drops the first `num_bytes` bytes of pending output.
+  void drop_output(size_t num_bytes);
+
+  // -- member types -----------------------------------------------------------
+
+  /// A buffer that the upper layer has passed to `enqueue_output`.
+  struct enqueued_buffer {
+    /// Number of bytes in `write_buf_` that precede this buffer.
+    size_t offset;
+
+    /// Owns the bytes.
+    std::variant<byte_buffer, chunk> storage;
+
+    /// Points to the bytes in `storage` that still wait for transfer.
+    const_byte_span bytes;
+  };
+
   // -- member variables -------------------------------------------------------
 
   /// Stores temporary flags.
@@ -201,6 +237,16 @@ protected:
   /// Caches outgoing data.
   byte_buffer write_buf_;
 
+  /// Stores buffers that the upper layer enqueued for sending without copying
+  /// them into `write_buf_`.
+  std::deque<enqueued_buffer> enqueued_;
+
+  /// Stores how many bytes in `enqueued_` wait for transfer.
+  size_t enqueued_bytes_ = 0;
+
+  /// Caches the buffer list for vectored writes.
+  std::vector<const_byte_span> write_bufs_;
+
   /// Processes incoming data and generates outgoing data.
   upper_layer_ptr up_;
 
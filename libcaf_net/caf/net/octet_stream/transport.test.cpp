@@ -15,12 +15,14 @@
 #include "caf/binary_deserializer.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/byte_buffer.hpp"
+#include "caf/chunk.hpp"
 #include "caf/detail/scope_guard.hpp"
 #include "caf/log/test.hpp"
 #include "caf/make_actor.hpp"
 #include "caf/span.hpp"
 
 #include <algorithm>
+#include <functional>
 
 using namespace caf;
 
@@ -115,6 +117,50 @@ private:
   consume_impl_t consume_impl_;
 };
 
+/// Writes to the transport once by calling a user-defined function.
+class mock_sender : public os::upper_layer {
+public:
+  using send_impl_t = std::function<void(os::lower_layer*)>;
+
+  explicit mock_sender(send_impl_t send_impl)
+    : send_impl_(std::move(send_impl)) {
+    // nop
+  }
+
+  static auto make(send_impl_t send_impl) {
+    return std::make_unique<mock_sender>(std::move(send_impl));
+  }
+
+  error start(os::lower_layer* down_ptr) override {
+    down_ = down_ptr;
+    return none;
+  }
+
+  void abort(const error&) override {
+    CAF_RAISE_ERROR("abort called");
+  }
+
+  ptrdiff_t consume(byte_span, byte_span) override {
+    return -1;
+  }
+
+  void prepare_send() override {
+    if (send_impl_) {
+      auto fn = std::move(send_impl_);
+      send_impl_ = nullptr;
+      fn(down_);
+    }
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+private:
+  os::lower_layer* down_ = nullptr;
+  send_impl_t send_impl_;
+};
+
 WITH_FIXTURE(fixture) {
 
 TEST("receive") {
@@ -218,6 +264,55 @@ TEST("switching the protocol resets the delta") {
   }
 }
 
+TEST("the transport sends enqueued buffers in order") {
+  byte_buffer expected;
+  auto add_bytes = [&expected](byte_buffer& out, size_t n, char c) {
+    out.insert(out.end(), n, static_cast<std::byte>(c));
+    expected.insert(expected.end(), n, static_cast<std::byte>(c));
+  };
+  auto sender = mock_sender::make([&](os::lower_layer* down) {
+    down->begin_output();
+    auto& out = down->output_buffer();
+    add_bytes(out, 4, 'a');
+    // Exceeds the buffer of the socket, forcing partial writes.
+    byte_buffer large;
+    add_bytes(large, 512 * 1024, 'b');
+    down->enqueue_output(std::move(large));
+    add_bytes(out, 4, 'c');
+    byte_buffer medium;
+    add_bytes(medium, 64 * 1024, 'd');
+    down->enqueue_output(chunk{medium});
+    // Small buffers end up in the output buffer.
+    byte_buffer small;
+    add_bytes(small, 8, 'e');
+    down->enqueue_output(std::move(small));
+    add_bytes(out, 4, 'f');
+    down->end_output();
+  });
+  auto transport = os::transport::make(recv_socket_guard.release(),
+                                       std::move(sender));
+  auto* transport_ptr = transport.get();
+  auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+  check_eq(mgr->start(), none);
+  mgr->register_writing();
+  mpx->apply_updates();
+  require(nonblocking(send_socket_guard.socket(), true).empty());
+  byte_buffer received;
+  received.resize(expected.size());
+  size_t offset = 0;
+  for (size_t round = 0; round < 10'000 && offset < received.size();
+       ++round) {
+    handle_io_event();
+    auto res = read(send_socket_guard.socket(),
+                    make_span(received).subspan(offset));
+    if (res > 0)
+      offset += static_cast<size_t>(res);
+  }
+  check_eq(offset, expected.size());
+  check(received == expected);
+  check_eq(transport_ptr->pending_output(), 0u);
+}
+
 } // WITH_FIXTURE(fixture)
 
 } // namespace
@@ -7,6 +7,7 @@
 #include "caf/net/ssl/context.hpp"
 
 #include "caf/config.hpp"
+#include "caf/detail/ssl_session_cache.hpp"
 
 CAF_PUSH_WARNINGS
 #include <openssl/err.h>
@@ -87,6 +88,16 @@ ptrdiff_t connection::close() {
   return SSL_shutdown(native(pimpl_));
 }
 
+// -- session resumption -------------------------------------------------------
+
+void connection::resume_session(std::string key) {
+  detail::ssl_session_cache_attach(pimpl_, std::move(key));
+}
+
+bool connection::session_reused() const noexcept {
+  return SSL_session_reused(native(pimpl_)) == 1;
+}
+
 // -- reading and writing ------------------------------------------------------
 
 ptrdiff_t connection::read(byte_span buf) {
@@ -105,6 +116,22 @@ size_t connection::buffered() const noexcept {
   return static_cast<size_t>(SSL_pending(native(pimpl_)));
 }
 
+bool connection::ktls_send() const noexcept {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  return BIO_get_ktls_send(SSL_get_wbio(native(pimpl_)));
+#else
+  return false;
+#endif
+}
+
+bool connection::ktls_recv() const noexcept {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  return BIO_get_ktls_recv(SSL_get_rbio(native(pimpl_)));
+#else
+  return false;
+#endif
+}
+
 stream_socket connection::fd() const noexcept {
   if (auto id = SSL_get_fd(native(pimpl_)); id != -1)
     return stream_socket{static_cast<socket_id>(id)};
@@ -12,6 +12,7 @@
 #include "caf/detail/net_export.hpp"
 
 #include <cstddef>
+#include <string>
 
 namespace caf::net::ssl {
 
@@ -73,6 +74,20 @@ public:
   /// Gracefully closes the SSL connection without closing the socket.
   ptrdiff_t close();
 
+  // -- session resumption -----------------------------------------------------
+
+  /// Associates this connection with `key` in the client-side session cache
+  /// of its context, usually the host and port of the server. If the cache
+  /// has a session for `key`, the handshake tries to resume it. New sessions
+  /// from the server replace the cached session for `key`. Has no effect
+  /// unless the context enables session reuse.
+  /// @pre must be called before `connect`
+  void resume_session(std::string key);
+
+  /// Checks whether the handshake resumed a previous session instead of
+  /// performing a full handshake.
+  bool session_reused() const noexcept;
+
   // -- reading and writing ----------------------------------------------------
 
   /// Tries to fill @p buf with data from the managed socket.
@@ -87,6 +102,16 @@ public:
   /// managed socket.
   size_t buffered() const noexcept;
 
+  /// Checks whether the kernel encrypts outgoing application data for this
+  /// connection, i.e., whether kernel TLS offload is active for sending.
+  /// Returns `false` before completing the handshake.
+  bool ktls_send() const noexcept;
+
+  /// Checks whether the kernel decrypts incoming application data for this
+  /// connection, i.e., whether kernel TLS offload is active for receiving.
+  /// Returns `false` before completing the handshake.
+  bool ktls_recv() const noexcept;
+
   /// Returns the file descriptor for this connection.
   stream_socket fd() const noexcept;
 
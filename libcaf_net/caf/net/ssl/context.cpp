@@ -7,8 +7,12 @@
 #include "caf/net/ssl/connection.hpp"
 
 #include "caf/config.hpp"
+#include "caf/detail/ssl_session_cache.hpp"
 #include "caf/expected.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 CAF_PUSH_WARNINGS
 #include <openssl/err.h>
 #include <openssl/ssl.h>
@@ -177,6 +181,26 @@ void context::verify_mode(verify_t flags) {
   SSL_CTX_set_verify(ptr, to_integer(flags), SSL_CTX_get_verify_callback(ptr));
 }
 
+void context::enable_ktls(bool flag) {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  auto ptr = native(pimpl_);
+  if (flag)
+    SSL_CTX_set_options(ptr, SSL_OP_ENABLE_KTLS);
+  else
+    SSL_CTX_clear_options(ptr, SSL_OP_ENABLE_KTLS);
+#else
+  CAF_IGNORE_UNUSED(flag);
+#endif
+}
+
+bool context::ktls_available() noexcept {
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+  return true;
+#else
+  return false;
+#endif
+}
+
 namespace {
 
 int c_password_callback(char* buf, int size, int rwflag, void* ptr) {
@@ -198,6 +222,47 @@ void context::password_callback_impl(password::callback_ptr callback) {
   SSL_CTX_set_default_passwd_cb_userdata(ptr, data_->pw_callback.get());
 }
 
+// -- session resumption -------------------------------------------------------
+
+bool context::enable_session_cache(size_t max_size, timespan lifetime) {
+  // Sessions only resume if the server uses the same session ID context.
+  static constexpr unsigned char sid_ctx[] = "caf.net.ssl";
+  ERR_clear_error();
+  auto ptr = native(pimpl_);
+  auto mode = SSL_CTX_get_session_cache_mode(ptr);
+  mode = (mode | SSL_SESS_CACHE_SERVER) & ~SSL_SESS_CACHE_NO_INTERNAL;
+  SSL_CTX_set_session_cache_mode(ptr, mode);
+  SSL_CTX_sess_set_cache_size(ptr, static_cast<long>(max_size));
+  // OpenSSL measures the timeout in whole seconds.
+  using secs_t = std::chrono::seconds;
+  auto secs = std::max(std::chrono::duration_cast<secs_t>(lifetime).count(),
+                       secs_t::rep{1});
+  SSL_CTX_set_timeout(ptr, static_cast<long>(secs));
+  return SSL_CTX_set_session_id_context(ptr, sid_ctx, sizeof(sid_ctx) - 1)
+         == 1;
+}
+
+void context::disable_session_cache() {
+  // Note: OpenSSL still looks up sessions in its cache unless we also set
+  //       SSL_SESS_CACHE_NO_INTERNAL_LOOKUP.
+  auto ptr = native(pimpl_);
+  auto mode = SSL_CTX_get_session_cache_mode(ptr);
+  mode = (mode & ~SSL_SESS_CACHE_SERVER) | SSL_SESS_CACHE_NO_INTERNAL;
+  SSL_CTX_set_session_cache_mode(ptr, mode);
+}
+
+void context::enable_session_tickets(bool flag) {
+  auto ptr = native(pimpl_);
+  if (flag)
+    SSL_CTX_clear_options(ptr, SSL_OP_NO_TICKET);
+  else
+    SSL_CTX_set_options(ptr, SSL_OP_NO_TICKET);
+}
+
+void context::enable_session_reuse(size_t max_size) {
+  detail::ssl_session_cache_install(pimpl_, max_size);
+}
+
 // -- native handles -----------------------------------------------------------
 
 context context::from_native(void* native_handle) {
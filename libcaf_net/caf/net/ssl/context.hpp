@@ -15,8 +15,10 @@
 #include "caf/net/ssl/verify.hpp"
 #include "caf/net/stream_socket.hpp"
 
+#include "caf/defaults.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/expected.hpp"
+#include "caf/timespan.hpp"
 
 #include <cstring>
 #include <string>
@@ -92,6 +94,18 @@ public:
   /// @note calls @c SSL_CTX_set_verify
   void verify_mode(verify_t flags);
 
+  /// Enables or disables kernel TLS offload for connections created from this
+  /// context. With kTLS, OpenSSL hands the session keys to the kernel after
+  /// the handshake and the kernel encrypts and decrypts application data.
+  /// Connections silently fall back to encryption in user space if the kernel
+  /// or the negotiated cipher does not support kTLS.
+  /// @note sets or clears @c SSL_OP_ENABLE_KTLS. Has no effect if OpenSSL was
+  ///       built without kTLS support.
+  void enable_ktls(bool flag);
+
+  /// Checks whether OpenSSL supports kernel TLS offload on this platform.
+  static bool ktls_available() noexcept;
+
   /// Overrides the callback to obtain the password for encrypted PEM files.
   /// @note calls @c SSL_CTX_set_default_passwd_cb
   template <typename PasswordCallback>
@@ -112,6 +126,44 @@ public:
     password_callback(std::move(cb));
   }
 
+  // -- session resumption -----------------------------------------------------
+
+  /// Configures the server-side session cache. Clients that connect again
+  /// within `lifetime` may resume their previous session with an abbreviated
+  /// handshake instead of a full handshake.
+  /// @param max_size The maximum number of cached sessions. When reaching this
+  ///                 limit, OpenSSL drops the oldest sessions. A value of 0
+  ///                 removes the limit.
+  /// @param lifetime How long clients may resume a session. Also limits the
+  ///                 lifetime of session tickets.
+  /// @returns `true` on success, `false` otherwise and `last_error` can be used
+  ///          to retrieve a human-readable error representation.
+  /// @note calls @c SSL_CTX_set_session_cache_mode,
+  ///       @c SSL_CTX_sess_set_cache_size, @c SSL_CTX_set_timeout and
+  ///       @c SSL_CTX_set_session_id_context
+  [[nodiscard]] bool
+  enable_session_cache(size_t max_size = defaults::net::ssl_session_cache_size,
+                       timespan lifetime = defaults::net::ssl_session_lifetime);
+
+  /// Disables the server-side session cache.
+  void disable_session_cache();
+
+  /// Enables or disables session tickets. With tickets, the server sends the
+  /// encrypted session state to the client instead of storing it in its
+  /// session cache. OpenSSL enables tickets by default.
+  /// @note sets or clears @c SSL_OP_NO_TICKET
+  void enable_session_tickets(bool flag);
+
+  /// Enables client-side session reuse. The context then stores the sessions
+  /// of connections with a session key (see @ref connection::resume_session)
+  /// and resumes them when connecting with the same key again.
+  /// @param max_size The maximum number of stored sessions. When reaching this
+  ///                 limit, the context drops the least recently used session.
+  /// @note If the context also enables a server-side session cache, OpenSSL
+  ///       additionally stores client sessions in that cache.
+  void enable_session_reuse(
+    size_t max_size = defaults::net::ssl_client_session_cache_size);
+
   // -- native handles ---------------------------------------------------------
 
   /// Reinterprets `native_handle` as the native implementation type and takes
@@ -343,6 +395,49 @@ inline auto new_connection(stream_socket fd, close_on_shutdown_t) {
   };
 }
 
+/// Enables or disables kernel TLS offload for connections created from the
+/// context.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_ktls(bool flag) {
+  return [flag](context ctx) {
+    ctx.enable_ktls(flag);
+    return expected<context>{std::move(ctx)};
+  };
+}
+
+/// Configures the server-side session cache.
+/// @param max_size The maximum number of cached sessions.
+/// @param lifetime How long clients may resume a session.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto
+enable_session_cache(size_t max_size = defaults::net::ssl_session_cache_size,
+                     timespan lifetime = defaults::net::ssl_session_lifetime) {
+  return [max_size, lifetime](context ctx) {
+    return detail::ssl_ctx_chain(ctx, "enable_session_cache failed",
+                                 ctx.enable_session_cache(max_size, lifetime));
+  };
+}
+
+/// Enables or disables session tickets.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_session_tickets(bool flag) {
+  return [flag](context ctx) {
+    ctx.enable_session_tickets(flag);
+    return expected<context>{std::move(ctx)};
+  };
+}
+
+/// Enables client-side session reuse.
+/// @param max_size The maximum number of stored sessions.
+/// @returns a function object for chaining `expected<T>::and_then()`.
+inline auto enable_session_reuse(
+  size_t max_size = defaults::net::ssl_client_session_cache_size) {
+  return [max_size](context ctx) {
+    ctx.enable_session_reuse(max_size);
+    return expected<context>{std::move(ctx)};
+  };
+}
+
 /// Configure a context to use the default locations for loading CA
 /// certificates.
 /// @returns a function object for chaining `expected<T>::and_then()`.
@@ -88,6 +88,11 @@ public:
     return *ctx_;
   }
 
+  /// Returns the shared SSL context.
+  std::shared_ptr<context> ctx_ptr() const noexcept {
+    return ctx_;
+  }
+
 private:
   tcp_accept_socket fd_;
   std::shared_ptr<context> ctx_;
@@ -4,11 +4,14 @@
 
 #include "caf/net/ssl/transport.hpp"
 
+#include "caf/net/middleman.hpp"
+#include "caf/net/multiplexer.hpp"
 #include "caf/net/octet_stream/errc.hpp"
 #include "caf/net/socket_manager.hpp"
 #include "caf/net/ssl/connection.hpp"
 
 #include "caf/settings.hpp"
+#include "caf/telemetry/counter.hpp"
 
 CAF_PUSH_WARNINGS
 #include <openssl/err.h>
@@ -48,8 +51,7 @@ public:
 
   void handle_read_event() override {
     if (auto res = advance_handshake(); res > 0) {
-      owner_->deregister();
-      owner_->schedule_handover();
+      complete_handshake();
     } else if (res == 0) {
       up_->abort(make_error(sec::connection_closed));
       owner_->deregister();
@@ -75,8 +77,7 @@ public:
 
   void handle_write_event() override {
     if (auto res = advance_handshake(); res > 0) {
-      owner_->deregister();
-      owner_->schedule_handover();
+      complete_handshake();
       return;
     } else if (res == 0) {
       up_->abort(make_error(sec::connection_closed));
@@ -120,6 +121,14 @@ private:
       return policy_.conn.connect();
   }
 
+  void complete_handshake() {
+    // Count full and resumed handshakes if running in an actor system.
+    if (auto* mm = owner_->mpx().owner_ptr())
+      mm->ssl_handshakes(is_server_, policy_.conn.session_reused())->inc();
+    owner_->deregister();
+    owner_->schedule_handover();
+  }
+
   bool is_server_ = false;
   socket_manager* owner_ = nullptr;
   transport::policy_impl policy_;
@@ -131,7 +140,14 @@ private:
 // -- member types -------------------------------------------------------------
 
 transport::policy_impl::policy_impl(connection conn) : conn(std::move(conn)) {
-  // nop
+  // After SSL_write fails with SSL_ERROR_WANT_WRITE, OpenSSL expects the retry
+  // to pass the same buffer again. However, `writev` calls SSL_write once per
+  // buffer and the transport drops written bytes from the front of its write
+  // buffer before retrying, which moves the remaining bytes. The transport
+  // always retries with the same bytes (plus maybe more) at the front, which
+  // satisfies the length constraint of OpenSSL for moving write buffers.
+  if (auto* ssl = static_cast<SSL*>(this->conn.native_handle()))
+    SSL_set_mode(ssl, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 }
 
 stream_socket transport::policy_impl::handle() const {
@@ -139,14 +155,33 @@ stream_socket transport::policy_impl::handle() const {
 }
 
 ptrdiff_t transport::policy_impl::read(byte_span buf) {
+  // Even with kTLS, we read via OpenSSL: the kernel reports non-data records
+  // such as alerts or session tickets as errors on plain reads.
+  last_io_raw = false;
   return conn.read(buf);
 }
 
 ptrdiff_t transport::policy_impl::write(const_byte_span buf) {
+  if (ktls_send) {
+    last_io_raw = true;
+    return net::write(conn.fd(), buf);
+  }
+  last_io_raw = false;
   return conn.write(buf);
 }
 
+ptrdiff_t transport::policy_impl::writev(span<const const_byte_span> bufs) {
+  if (ktls_send) {
+    last_io_raw = true;
+    return net::write(conn.fd(), bufs);
+  }
+  // Falls back to calling `write` for each buffer.
+  return octet_stream::policy::writev(bufs);
+}
+
 octet_stream::errc transport::policy_impl::last_error(ptrdiff_t ret) {
+  if (last_io_raw)
+    return super::policy_impl{conn.fd()}.last_error(ret);
   switch (conn.last_error(ret)) {
     case errc::none:
     case errc::want_accept:
@@ -204,7 +239,7 @@ transport::worker_ptr transport::make_client(connection conn,
 
 transport::transport(connection conn, upper_layer_ptr up)
   : super(&policy_impl_, std::move(up)), policy_impl_(std::move(conn)) {
-  // nop
+  policy_impl_.ktls_send = policy_impl_.conn.ktls_send();
 }
 
 } // namespace caf::net::ssl
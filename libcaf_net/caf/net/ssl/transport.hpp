@@ -33,6 +33,8 @@ public:
 
     ptrdiff_t write(const_byte_span) override;
 
+    ptrdiff_t writev(span<const const_byte_span> bufs) override;
+
     octet_stream::errc last_error(ptrdiff_t) override;
 
     ptrdiff_t connect() override;
@@ -42,12 +44,21 @@ public:
     size_t buffered() const noexcept override;
 
     connection conn;
+
+    /// Stores whether the kernel encrypts outgoing data for `conn`. If `true`,
+    /// the policy writes to the socket directly instead of calling OpenSSL.
+    bool ktls_send = false;
+
+    /// Stores whether the last read or write bypassed OpenSSL.
+    bool last_io_raw = false;
   };
 
   // -- factories --------------------------------------------------------------
 
   /// Creates a new instance of the SSL transport for a socket that has already
-  /// performed the SSL handshake.
+  /// performed the SSL handshake. If kernel TLS offload is active for sending
+  /// (see @ref context::enable_ktls), the transport writes to the socket
+  /// directly and lets the kernel encrypt the data.
   /// @param conn The connection object for managing @p fd.
   /// @param up The layer operating on top of this transport.
   static std::unique_ptr<transport> make(connection conn, upper_layer_ptr up);
@@ -14,7 +14,9 @@
 #include "caf/log/net.hpp"
 #include "caf/span.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 #ifdef CAF_POSIX
 #  include <sys/uio.h>
@@ -183,6 +185,20 @@ ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
   return (res == 0) ? bytes_sent : -1;
 }
 
+ptrdiff_t write(stream_socket x, span<const const_byte_span> bufs) {
+  WSABUF buf_array[max_write_buffers];
+  auto n = std::min(bufs.size(), max_write_buffers);
+  for (size_t i = 0; i < n; ++i) {
+    auto data = const_cast<std::byte*>(bufs[i].data());
+    buf_array[i] = WSABUF{static_cast<ULONG>(bufs[i].size()),
+                          reinterpret_cast<CHAR*>(data)};
+  }
+  DWORD bytes_sent = 0;
+  auto res = WSASend(x.id, buf_array, static_cast<DWORD>(n), &bytes_sent, 0,
+                     nullptr, nullptr);
+  return (res == 0) ? static_cast<ptrdiff_t>(bytes_sent) : -1;
+}
+
 #else // CAF_WINDOWS
 
 ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
@@ -195,6 +211,21 @@ ptrdiff_t write(stream_socket x, std::initializer_list<const_byte_span> bufs) {
   return writev(x.id, buf_array, static_cast<int>(bufs.size()));
 }
 
+ptrdiff_t write(stream_socket x, span<const const_byte_span> bufs) {
+  auto lg = log::net::trace("socket = {}, buffers = {}", x.id, bufs.size());
+  iovec buf_array[max_write_buffers];
+  auto n = std::min(bufs.size(), max_write_buffers);
+  for (size_t i = 0; i < n; ++i)
+    buf_array[i] = iovec{const_cast<std::byte*>(bufs[i].data()),
+                         bufs[i].size()};
+  // Unlike writev, sendmsg accepts flags for suppressing SIGPIPE.
+  msghdr msg;
+  memset(&msg, 0, sizeof(msghdr));
+  msg.msg_iov = buf_array;
+  msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(n);
+  return sendmsg(x.id, &msg, no_sigpipe_io_flag);
+}
+
 #endif // CAF_WINDOWS
 
 } // namespace caf::net
@@ -79,4 +79,18 @@ ptrdiff_t CAF_NET_EXPORT write(stream_socket x, const_byte_span buf);
 ptrdiff_t CAF_NET_EXPORT write(stream_socket x,
                                std::initializer_list<const_byte_span> bufs);
 
+/// Maximum number of buffers that a single call to `write` with a span of
+/// buffers passes to the OS.
+constexpr size_t max_write_buffers = 64;
+
+/// Transmits data from `x` to its peer with a single system call.
+/// @param x A connected endpoint.
+/// @param bufs Points to the message to send, scattered across multiple
+///             buffers. Sends at most the first `max_write_buffers` buffers.
+/// @returns The number of written bytes on success, 0 if the socket is closed,
+///          or -1 in case of an error.
+/// @relates stream_socket
+ptrdiff_t CAF_NET_EXPORT write(stream_socket x,
+                               span<const const_byte_span> bufs);
+
 } // namespace caf::net
@@ -41,7 +41,8 @@ error set_inaddr_any(socket x, sockaddr_in6& sa) {
 template <int Family>
 expected<tcp_accept_socket> new_tcp_acceptor_impl(uint16_t port,
                                                   const char* addr,
-                                                  bool reuse_addr, bool any) {
+                                                  bool reuse_addr,
+                                                  bool reuse_port, bool any) {
   static_assert(Family == AF_INET || Family == AF_INET6, "invalid family");
   auto lg = log::net::trace("port = {}, addr = {}", port,
                             (addr ? addr : "nullptr"));
@@ -62,6 +63,18 @@ expected<tcp_accept_socket> new_tcp_acceptor_impl(uint16_t port,
                                reinterpret_cast<setsockopt_ptr>(&on),
                                static_cast<socket_size_type>(sizeof(on))));
   }
+  if (reuse_port) {
+#ifdef SO_REUSEPORT
+    int on = 1;
+    CAF_NET_SYSCALL("setsockopt", tmp2, !=, 0,
+                    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT,
+                               reinterpret_cast<setsockopt_ptr>(&on),
+                               static_cast<socket_size_type>(sizeof(on))));
+#else
+    return make_error(sec::unsupported_operation,
+                      "SO_REUSEPORT is not available on this platform");
+#endif
+  }
   using sockaddr_type
     = std::conditional_t<Family == AF_INET, sockaddr_in, sockaddr_in6>;
   sockaddr_type sa;
@@ -83,15 +96,18 @@ expected<tcp_accept_socket> new_tcp_acceptor_impl(uint16_t port,
 } // namespace
 
 expected<tcp_accept_socket> make_tcp_accept_socket(ip_endpoint node,
-                                                   bool reuse_addr) {
-  auto lg = log::net::trace("node = {}, reuse_addr = {}", node, reuse_addr);
+                                                   bool reuse_addr,
+                                                   bool reuse_port) {
+  auto lg = log::net::trace("node = {}, reuse_addr = {}, reuse_port = {}",
+                            node, reuse_addr, reuse_port);
   auto addr = to_string(node.address());
   bool is_v4 = node.address().embeds_v4();
   bool is_zero = is_v4 ? node.address().embedded_v4().bits() == 0
                        : node.address().zero();
   auto make_acceptor = is_v4 ? new_tcp_acceptor_impl<AF_INET>
                              : new_tcp_acceptor_impl<AF_INET6>;
-  if (auto p = make_acceptor(node.port(), addr.c_str(), reuse_addr, is_zero)) {
+  if (auto p = make_acceptor(node.port(), addr.c_str(), reuse_addr,
+                             reuse_port, is_zero)) {
     auto sock = socket_cast<tcp_accept_socket>(*p);
     auto sguard = make_socket_guard(sock);
     CAF_NET_SYSCALL("listen", tmp, !=, 0, listen(sock.id, SOMAXCONN));
@@ -106,19 +122,23 @@ expected<tcp_accept_socket> make_tcp_accept_socket(ip_endpoint node,
 }
 
 expected<tcp_accept_socket>
-make_tcp_accept_socket(const uri::authority_type& node, bool reuse_addr) {
-  auto lg = log::net::trace("node = {}, reuse_addr = {}", node, reuse_addr);
+make_tcp_accept_socket(const uri::authority_type& node, bool reuse_addr,
+                       bool reuse_port) {
+  auto lg = log::net::trace("node = {}, reuse_addr = {}, reuse_port = {}",
+                            node, reuse_addr, reuse_port);
   if (auto ip = std::get_if<ip_address>(&node.host))
-    return make_tcp_accept_socket(ip_endpoint{*ip, node.port}, reuse_addr);
+    return make_tcp_accept_socket(ip_endpoint{*ip, node.port}, reuse_addr,
+                                  reuse_port);
   const auto& host = std::get<std::string>(node.host);
   if (host.empty()) {
     // For empty strings, try IPv6::any and use IPv4::any as fallback.
     auto v6_any = ip_address{{0}, {0}};
     auto v4_any = ip_address{make_ipv4_address(0, 0, 0, 0)};
     if (auto sock = make_tcp_accept_socket(ip_endpoint{v6_any, node.port},
-                                           reuse_addr))
+                                           reuse_addr, reuse_port))
       return *sock;
-    return make_tcp_accept_socket(ip_endpoint{v4_any, node.port}, reuse_addr);
+    return make_tcp_accept_socket(ip_endpoint{v4_any, node.port}, reuse_addr,
+                                  reuse_port);
   }
   auto addrs = ip::local_addresses(host);
   if (addrs.empty())
@@ -129,7 +149,7 @@ make_tcp_accept_socket(const uri::authority_type& node, bool reuse_addr) {
                         [](const ip_address& ip) { return !ip.embeds_v4(); });
   for (auto& addr : addrs) {
     if (auto sock = make_tcp_accept_socket(ip_endpoint{addr, node.port},
-                                           reuse_addr))
+                                           reuse_addr, reuse_port))
       return *sock;
   }
   return make_error(sec::cannot_open_port, "tcp socket creation failed",
@@ -137,13 +157,15 @@ make_tcp_accept_socket(const uri::authority_type& node, bool reuse_addr) {
 }
 
 expected<tcp_accept_socket>
-make_tcp_accept_socket(uint16_t port, std::string addr, bool reuse_addr) {
-  auto lg = log::net::trace("port = {}, addr = {}, reuse_addr = {}", port, addr,
-                            reuse_addr);
+make_tcp_accept_socket(uint16_t port, std::string addr, bool reuse_addr,
+                       bool reuse_port) {
+  auto lg = log::net::trace("port = {}, addr = {}, reuse_addr = {}, "
+                            "reuse_port = {}",
+                            port, addr, reuse_addr, reuse_port);
   uri::authority_type auth;
   auth.port = port;
   auth.host = std::move(addr);
-  return make_tcp_accept_socket(auth, reuse_addr);
+  return make_tcp_accept_socket(auth, reuse_addr, reuse_port);
 }
 
 expected<tcp_stream_socket> accept(tcp_accept_socket x) {
@@ -29,20 +29,25 @@ struct CAF_NET_EXPORT tcp_accept_socket : network_socket {
 /// @param node The endpoint to listen on and the filter for incoming addresses.
 ///             Passing the address `0.0.0.0` will accept incoming connection
 ///             from any host. Passing port 0 lets the OS choose the port.
+/// @param reuse_addr Optionally sets the SO_REUSEADDR option on the socket.
+/// @param reuse_port Optionally sets the SO_REUSEPORT option on the socket.
 /// @relates tcp_accept_socket
 expected<tcp_accept_socket>
   CAF_NET_EXPORT make_tcp_accept_socket(ip_endpoint node,
-                                        bool reuse_addr = true);
+                                        bool reuse_addr = true,
+                                        bool reuse_port = false);
 
 /// Creates a new TCP socket to accept connections on a given port.
 /// @param node The endpoint to listen on and the filter for incoming addresses.
 ///             Passing the address `0.0.0.0` will accept incoming connection
 ///             from any host. Passing port 0 lets the OS choose the port.
 /// @param reuse_addr Optionally sets the SO_REUSEADDR option on the socket.
+/// @param reuse_port Optionally sets the SO_REUSEPORT option on the socket.
 /// @relates tcp_accept_socket
 expected<tcp_accept_socket>
   CAF_NET_EXPORT make_tcp_accept_socket(const uri::authority_type& node,
-                                        bool reuse_addr = true);
+                                        bool reuse_addr = true,
+                                        bool reuse_port = false);
 
 /// Creates a new TCP socket to accept connections on a given port.
 /// @param port The port for listening to incoming connection. Passing 0 lets
@@ -50,9 +55,14 @@ expected<tcp_accept_socket>
 /// @param addr The filter for incoming addresses. Passing the address `0.0.0.0`
 ///             will accept incoming connection from any host.
 /// @param reuse_addr Optionally sets the SO_REUSEADDR option on the socket.
+/// @param reuse_port Optionally sets the SO_REUSEPORT option on the socket.
+///                   Multiple sockets with this option may listen on the same
+///                   port and the OS distributes incoming connections across
+///                   them.
 /// @relates tcp_accept_socket
-expected<tcp_accept_socket> CAF_NET_EXPORT make_tcp_accept_socket(
-  uint16_t port, std::string addr = "0.0.0.0", bool reuse_addr = true);
+expected<tcp_accept_socket> CAF_NET_EXPORT
+make_tcp_accept_socket(uint16_t port, std::string addr = "0.0.0.0",
+                       bool reuse_addr = true, bool reuse_port = false);
 
 /// Accepts a connection on `x`.
 /// @param x Listening endpoint.
@@ -10,6 +10,7 @@
 #include "caf/net/socket_guard.hpp"
 #include "caf/net/tcp_stream_socket.hpp"
 
+#include "caf/detail/socket_sys_includes.hpp"
 #include "caf/log/test.hpp"
 
 using namespace caf;
@@ -64,6 +65,28 @@ TEST("opening and accepting tcp on a socket") {
   }
 }
 
+#ifdef SO_REUSEPORT
+
+TEST("multiple sockets may listen on the same port with reuse_port") {
+  auto first = make_tcp_accept_socket(0, "127.0.0.1", true, true);
+  require(first.has_value());
+  auto first_guard = make_socket_guard(*first);
+  auto port = local_port(*first);
+  require(port.has_value());
+  SECTION("opening another socket with reuse_port succeeds") {
+    auto second = make_tcp_accept_socket(*port, "127.0.0.1", true, true);
+    require(second.has_value());
+    auto second_guard = make_socket_guard(*second);
+    check_eq(local_port(*second), port);
+  }
+  SECTION("opening another socket without reuse_port fails") {
+    auto second = make_tcp_accept_socket(*port, "127.0.0.1", true, false);
+    check(!second.has_value());
+  }
+}
+
+#endif // SO_REUSEPORT
+
 TEST("calling accepting") {
   SECTION("on an invalid socket") {
     tcp_accept_socket x;
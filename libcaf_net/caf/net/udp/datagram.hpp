@@ -0,0 +1,51 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/byte_span.hpp"
+#include "caf/chunk.hpp"
+#include "caf/ip_endpoint.hpp"
+
+#include <utility>
+
+namespace caf::net::udp {
+
+/// An implicitly shared datagram. Stores the address of the sender for
+/// received datagrams and the address of the receiver for outgoing datagrams.
+class datagram {
+public:
+  datagram() = default;
+
+  datagram(ip_endpoint endpoint, chunk payload)
+    : endpoint_(endpoint), payload_(std::move(payload)) {
+    // nop
+  }
+
+  datagram(ip_endpoint endpoint, const_byte_span payload)
+    : endpoint_(endpoint), payload_(payload) {
+    // nop
+  }
+
+  /// Returns the address of the sender or receiver.
+  const ip_endpoint& endpoint() const noexcept {
+    return endpoint_;
+  }
+
+  /// Returns the payload of the datagram.
+  const chunk& payload() const noexcept {
+    return payload_;
+  }
+
+  /// Returns the payload of the datagram as bytes.
+  const_byte_span bytes() const noexcept {
+    return payload_.bytes();
+  }
+
+private:
+  ip_endpoint endpoint_;
+  chunk payload_;
+};
+
+} // namespace caf::net::udp
@@ -0,0 +1,13 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/udp/lower_layer.hpp"
+
+namespace caf::net::udp {
+
+lower_layer::~lower_layer() {
+  // nop
+}
+
+} // namespace caf::net::udp
@@ -0,0 +1,35 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+#include "caf/net/generic_lower_layer.hpp"
+
+#include "caf/byte_span.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/fwd.hpp"
+
+namespace caf::net::udp {
+
+/// Provides access to a datagram-oriented transport.
+class CAF_NET_EXPORT lower_layer : public generic_lower_layer {
+public:
+  virtual ~lower_layer();
+
+  /// Pulls datagrams from the transport until calling `suspend_reading`.
+  virtual void request_messages() = 0;
+
+  /// Stops reading datagrams until calling `request_messages`.
+  virtual void suspend_reading() = 0;
+
+  /// Enqueues `payload` for sending it as a single datagram to `destination`.
+  /// @returns `false` if `payload` exceeds the maximum size of a datagram,
+  ///          `true` otherwise.
+  virtual bool send_datagram(const ip_endpoint& destination,
+                             const_byte_span payload)
+    = 0;
+};
+
+} // namespace caf::net::udp
@@ -0,0 +1,247 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/udp/transport.hpp"
+
+#include "caf/net/network_socket.hpp"
+#include "caf/net/socket_manager.hpp"
+
+#include "caf/log/net.hpp"
+#include "caf/sec.hpp"
+#include "caf/span.hpp"
+
+#include <algorithm>
+
+namespace caf::net::udp {
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+transport::transport(udp_datagram_socket fd, upper_layer_ptr up)
+  : fd_(fd), up_(std::move(up)) {
+  // nop
+}
+
+// -- factories ----------------------------------------------------------------
+
+std::unique_ptr<transport> transport::make(udp_datagram_socket fd,
+                                           upper_layer_ptr up) {
+  return std::make_unique<transport>(fd, std::move(up));
+}
+
+// -- properties ---------------------------------------------------------------
+
+void transport::max_datagram_size(size_t new_value) noexcept {
+  max_datagram_size_ = std::clamp(new_value, size_t{1}, max_payload_size);
+}
+
+void transport::batch_size(size_t new_value) noexcept {
+  batch_size_ = std::clamp(new_value, size_t{1}, max_datagram_batch_size);
+}
+
+// -- implementation of udp::lower_layer ---------------------------------------
+
+multiplexer& transport::mpx() noexcept {
+  return parent_->mpx();
+}
+
+bool transport::can_send_more() const noexcept {
+  return pending_output() < max_write_buf_size_;
+}
+
+bool transport::is_reading() const noexcept {
+  return parent_->is_reading();
+}
+
+void transport::write_later() {
+  parent_->register_writing();
+}
+
+void transport::shutdown() {
+  if (pending_output() == 0) {
+    parent_->shutdown();
+  } else {
+    parent_->deregister_reading();
+    shutting_down_ = true;
+  }
+}
+
+void transport::request_messages() {
+  if (parent_->is_reading())
+    return;
+  parent_->register_reading();
+  // Datagrams from the last read operation are already in our buffer. Hence,
+  // we may not wait for the next read event before delivering them.
+  if (delivered_ < received_)
+    parent_->schedule_fn([this] {
+      if (parent_->is_reading())
+        deliver_received();
+    });
+}
+
+void transport::suspend_reading() {
+  parent_->deregister_reading();
+}
+
+bool transport::send_datagram(const ip_endpoint& destination,
+                              const_byte_span payload) {
+  if (payload.size() > max_payload_size) {
+    log::net::debug("maximum datagram size exceeded");
+    return false;
+  }
+  if (sent_ == outbox_.size())
+    parent_->register_writing();
+  outbox_.push_back(
+    outgoing_datagram{destination, write_buf_.size(), payload.size()});
+  write_buf_.insert(write_buf_.end(), payload.begin(), payload.end());
+  return true;
+}
+
+// -- implementation of socket_event_layer -------------------------------------
+
+error transport::start(socket_manager* owner) {
+  parent_ = owner;
+  if (auto socket_buf_size = send_buffer_size(fd_)) {
+    max_write_buf_size_ = *socket_buf_size;
+  } else {
+    log::net::error("send_buffer_size: {}", socket_buf_size.error());
+    return std::move(socket_buf_size.error());
+  }
+  read_buf_.resize(max_datagram_size_ * batch_size_);
+  read_bufs_.resize(batch_size_);
+  for (size_t i = 0; i < batch_size_; ++i)
+    read_bufs_[i] = make_span(read_buf_.data() + i * max_datagram_size_,
+                              max_datagram_size_);
+  read_infos_.resize(batch_size_);
+  write_bufs_.reserve(batch_size_);
+  write_eps_.reserve(batch_size_);
+  return up_->start(this);
+}
+
+socket transport::handle() const {
+  return fd_;
+}
+
+void transport::handle_read_event() {
+  auto lg = log::net::trace("socket = {}", fd_.id);
+  // Datagrams from the last read operation take precedence.
+  if (delivered_ < received_) {
+    deliver_received();
+    if (delivered_ < received_ || !parent_->is_reading())
+      return;
+  }
+  auto res = read(fd_, make_span(read_bufs_), make_span(read_infos_));
+  if (res < 0) {
+    if (!last_socket_error_is_temporary())
+      fail(make_error(sec::socket_operation_failed));
+    return;
+  }
+  received_ = static_cast<size_t>(res);
+  delivered_ = 0;
+  deliver_received();
+}
+
+void transport::handle_write_event() {
+  auto lg = log::net::trace("socket = {}", fd_.id);
+  if (!shutting_down_ && can_send_more()) {
+    // Allow the upper layer to add extra datagrams to the outbox.
+    up_->prepare_send();
+  }
+  while (sent_ < outbox_.size()) {
+    auto n = std::min(outbox_.size() - sent_, batch_size_);
+    write_bufs_.clear();
+    write_eps_.clear();
+    for (auto i = sent_; i < sent_ + n; ++i) {
+      auto& dgram = outbox_[i];
+      write_bufs_.emplace_back(write_buf_.data() + dgram.offset, dgram.size);
+      write_eps_.emplace_back(dgram.destination);
+    }
+    auto res = write(fd_, make_span(write_bufs_), make_span(write_eps_));
+    if (res > 0) {
+      sent_ += static_cast<size_t>(res);
+    } else if (res < 0 && last_socket_error_is_temporary()) {
+      // Try again on the next write event.
+      drop_sent();
+      return;
+    } else {
+      // UDP reports errors such as an unreachable destination per datagram.
+      // Hence, we drop the datagram and carry on instead of closing the socket.
+      log::net::warning("failed to send a datagram to {}: {}",
+                        outbox_[sent_].destination,
+                        last_socket_error_as_string());
+      ++sent_;
+    }
+  }
+  drop_sent();
+  if (shutting_down_)
+    parent_->shutdown();
+  else if (up_->done_sending())
+    parent_->deregister_writing();
+}
+
+void transport::abort(const error& reason) {
+  up_->abort(reason);
+  shutting_down_ = true;
+}
+
+bool transport::finalized() const noexcept {
+  return pending_output() == 0;
+}
+
+// -- utility functions --------------------------------------------------------
+
+void transport::deliver_received() {
+  while (delivered_ < received_ && parent_->is_reading()) {
+    auto index = delivered_++;
+    auto& info = read_infos_[index];
+    if (info.truncated) {
+      log::net::warning("dropped a datagram from {}: exceeds the maximum size "
+                        "of {} bytes",
+                        info.source, max_datagram_size_);
+      continue;
+    }
+    auto payload = read_bufs_[index].subspan(0, info.size);
+    if (up_->consume(info.source, payload) < 0) {
+      // Negative values indicate that the application wants to close the
+      // socket. We still make sure to send any pending data before closing.
+      up_->abort(make_error(caf::sec::runtime_error, "consumed < 0"));
+      parent_->deregister_reading();
+      return;
+    }
+  }
+}
+
+size_t transport::pending_output() const noexcept {
+  if (sent_ == outbox_.size())
+    return 0;
+  return write_buf_.size() - outbox_[sent_].offset;
+}
+
+void transport::drop_sent() {
+  if (sent_ == 0)
+    return;
+  if (sent_ == outbox_.size()) {
+    write_buf_.clear();
+    outbox_.clear();
+    sent_ = 0;
+    return;
+  }
+  auto offset = outbox_[sent_].offset;
+  write_buf_.erase(write_buf_.begin(),
+                   write_buf_.begin() + static_cast<ptrdiff_t>(offset));
+  outbox_.erase(outbox_.begin(),
+                outbox_.begin() + static_cast<ptrdiff_t>(sent_));
+  for (auto& dgram : outbox_)
+    dgram.offset -= offset;
+  sent_ = 0;
+}
+
+void transport::fail(const error& reason) {
+  auto lg = log::net::trace("reason = {}", reason);
+  up_->abort(reason);
+  up_.reset();
+  parent_->deregister();
+  parent_->shutdown();
+}
+
+} // namespace caf::net::udp
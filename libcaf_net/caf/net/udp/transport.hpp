@@ -0,0 +1,191 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/fwd.hpp"
+#include "caf/net/socket_event_layer.hpp"
+#include "caf/net/udp/lower_layer.hpp"
+#include "caf/net/udp/upper_layer.hpp"
+#include "caf/net/udp_datagram_socket.hpp"
+
+#include "caf/byte_buffer.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/net_export.hpp"
+#include "caf/fwd.hpp"
+#include "caf/ip_endpoint.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace caf::net::udp {
+
+/// Implements a datagram-oriented transport for UDP sockets. Receives and
+/// sends multiple datagrams per system call on platforms that support
+/// `recvmmsg` and `sendmmsg`.
+class CAF_NET_EXPORT transport : public socket_event_layer,
+                                 public udp::lower_layer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using connection_handle = udp_datagram_socket;
+
+  /// An owning smart pointer type for storing an upper layer object.
+  using upper_layer_ptr = std::unique_ptr<udp::upper_layer>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// The maximum payload of a UDP datagram over IPv4.
+  static constexpr size_t max_payload_size = 65'507;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  transport(udp_datagram_socket fd, upper_layer_ptr up);
+
+  transport(const transport&) = delete;
+
+  transport& operator=(const transport&) = delete;
+
+  // -- factories --------------------------------------------------------------
+
+  static std::unique_ptr<transport> make(udp_datagram_socket fd,
+                                         upper_layer_ptr up);
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the maximum size for incoming datagrams.
+  size_t max_datagram_size() const noexcept {
+    return max_datagram_size_;
+  }
+
+  /// Sets the maximum size for incoming datagrams. The transport drops larger
+  /// datagrams.
+  /// @pre `start` has not been called yet.
+  void max_datagram_size(size_t new_value) noexcept;
+
+  /// Returns how many datagrams the transport receives or sends at once.
+  size_t batch_size() const noexcept {
+    return batch_size_;
+  }
+
+  /// Sets how many datagrams the transport receives or sends at once.
+  /// @pre `start` has not been called yet.
+  void batch_size(size_t new_value) noexcept;
+
+  // -- implementation of udp::lower_layer -------------------------------------
+
+  multiplexer& mpx() noexcept override;
+
+  bool can_send_more() const noexcept override;
+
+  bool is_reading() const noexcept override;
+
+  void write_later() override;
+
+  void shutdown() override;
+
+  void request_messages() override;
+
+  void suspend_reading() override;
+
+  bool send_datagram(const ip_endpoint& destination,
+                     const_byte_span payload) override;
+
+  // -- implementation of socket_event_layer -----------------------------------
+
+  error start(socket_manager* owner) override;
+
+  socket handle() const override;
+
+  void handle_read_event() override;
+
+  void handle_write_event() override;
+
+  void abort(const error& reason) override;
+
+  bool finalized() const noexcept override;
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  /// Refers to an outgoing datagram in the write buffer.
+  struct outgoing_datagram {
+    ip_endpoint destination;
+    size_t offset;
+    size_t size;
+  };
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Passes received datagrams to the upper layer until either all datagrams
+  /// from the last read operation are consumed or the upper layer suspends
+  /// reading.
+  void deliver_received();
+
+  /// Returns the number of bytes in the write buffer that wait for sending.
+  size_t pending_output() const noexcept;
+
+  /// Removes all sent datagrams from the write buffer.
+  void drop_sent();
+
+  /// Calls abort on the upper layer and shuts down the socket manager.
+  void fail(const error& reason);
+
+  // -- member variables -------------------------------------------------------
+
+  /// The socket for sending and receiving datagrams.
+  udp_datagram_socket fd_;
+
+  /// Points to the socket manager that owns this transport.
+  socket_manager* parent_ = nullptr;
+
+  /// The next layer up the protocol stack.
+  upper_layer_ptr up_;
+
+  /// Configures the maximum size for incoming datagrams.
+  size_t max_datagram_size_ = defaults::net::udp_max_datagram_size;
+
+  /// Configures how many datagrams we receive or send at once.
+  size_t batch_size_ = defaults::net::udp_batch_size;
+
+  /// Stores incoming datagrams, reserving `max_datagram_size_` bytes for each.
+  byte_buffer read_buf_;
+
+  /// Splits `read_buf_` into one buffer per datagram.
+  std::vector<byte_span> read_bufs_;
+
+  /// Stores the size and the sender of each received datagram.
+  std::vector<udp_datagram_info> read_infos_;
+
+  /// Stores how many datagrams we have received in the last read operation.
+  size_t received_ = 0;
+
+  /// Stores how many datagrams from the last read operation we have passed to
+  /// the upper layer.
+  size_t delivered_ = 0;
+
+  /// Stores the payload of all outgoing datagrams.
+  byte_buffer write_buf_;
+
+  /// Stores the destination and the position in `write_buf_` of each outgoing
+  /// datagram.
+  std::vector<outgoing_datagram> outbox_;
+
+  /// Stores how many datagrams in `outbox_` we have sent.
+  size_t sent_ = 0;
+
+  /// Caches the arguments for the batched write operation.
+  std::vector<const_byte_span> write_bufs_;
+
+  /// Caches the arguments for the batched write operation.
+  std::vector<ip_endpoint> write_eps_;
+
+  /// Caps the number of bytes in `write_buf_`.
+  size_t max_write_buf_size_ = 0;
+
+  /// Stores whether the application has asked to shut down.
+  bool shutting_down_ = false;
+};
+
+} // namespace caf::net::udp
@@ -0,0 +1,184 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#include "caf/net/udp/transport.hpp"
+
+#include "caf/test/scenario.hpp"
+
+#include "caf/net/middleman.hpp"
+#include "caf/net/network_socket.hpp"
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/udp/with.hpp"
+#include "caf/net/udp_datagram_socket.hpp"
+
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+#include "caf/config.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/ip_address.hpp"
+#include "caf/ip_endpoint.hpp"
+#include "caf/ipv4_address.hpp"
+#include "caf/scheduled_actor/flow.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace caf;
+using namespace std::literals;
+
+namespace {
+
+using string_list = std::vector<std::string>;
+
+struct fixture {
+  fixture() : sys(init(cfg)) {
+    localhost = ip_endpoint{make_ipv4_address(127, 0, 0, 1), 0};
+  }
+
+  static actor_system_config& init(actor_system_config& cfg) {
+    cfg.set("caf.scheduler.max-threads", 2);
+    cfg.set("caf.scheduler.policy", "sharing");
+    cfg.load<net::middleman>();
+    return cfg;
+  }
+
+  /// Creates a UDP socket on localhost and returns it with its endpoint.
+  std::pair<net::udp_datagram_socket, ip_endpoint> make_socket() {
+    auto& rt = test::runnable::current();
+    auto fd = net::make_udp_datagram_socket(localhost);
+    rt.require(fd.has_value());
+    auto port = net::local_port(*fd);
+    rt.require(port.has_value());
+    rt.require(!net::nonblocking(*fd, true));
+    return {*fd, ip_endpoint{localhost.address(), *port}};
+  }
+
+  /// Starts a server that echoes all datagrams with an "ok " prefix.
+  disposable start_echo_server(net::udp_datagram_socket fd,
+                               size_t max_datagram_size
+                               = defaults::net::udp_max_datagram_size) {
+    auto res = net::udp::with(sys)
+                 .bind(fd)
+                 .max_datagram_size(max_datagram_size)
+                 .start([this](auto pull, auto push) {
+                   sys.spawn([pull, push](event_based_actor* self) {
+                     pull.observe_on(self)
+                       .map([](const net::udp::datagram& x) {
+                         std::string response = "ok ";
+                         for (auto val : x.bytes())
+                           response.push_back(static_cast<char>(val));
+                         return net::udp::datagram{
+                           x.endpoint(), as_bytes(make_span(response))};
+                       })
+                       .subscribe(push);
+                   });
+                 });
+    test::runnable::current().require(res.has_value());
+    return *res;
+  }
+
+  /// Sends all `msgs` to `dst`.
+  static void send_all(net::udp_datagram_socket fd, const string_list& msgs,
+                       ip_endpoint dst) {
+    std::vector<const_byte_span> bufs;
+    for (auto& msg : msgs)
+      bufs.emplace_back(as_bytes(make_span(msg)));
+    std::vector<ip_endpoint> eps(bufs.size(), dst);
+    size_t pos = 0;
+    while (pos < bufs.size()) {
+      auto n = std::min(bufs.size() - pos, net::max_datagram_batch_size);
+      auto res = net::write(fd, make_span(bufs.data() + pos, n),
+                            make_span(eps.data() + pos, n));
+      if (res > 0)
+        pos += static_cast<size_t>(res);
+      else if (!net::last_socket_error_is_temporary())
+        test::runnable::current().fail("failed to send datagrams");
+    }
+  }
+
+  /// Receives up to `num` datagrams or until reaching the timeout.
+  static string_list receive(net::udp_datagram_socket fd, size_t num) {
+    constexpr size_t batch_size = 16;
+    byte_buffer storage(batch_size * 1024);
+    std::vector<byte_span> bufs;
+    for (size_t i = 0; i < batch_size; ++i)
+      bufs.emplace_back(storage.data() + i * 1024, 1024);
+    std::vector<net::udp_datagram_info> infos(batch_size);
+    string_list result;
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (result.size() < num && std::chrono::steady_clock::now() < deadline) {
+      auto res = net::read(fd, make_span(bufs), make_span(infos));
+      if (res <= 0) {
+        std::this_thread::sleep_for(1ms);
+        continue;
+      }
+      for (size_t i = 0; i < static_cast<size_t>(res); ++i) {
+        auto str = reinterpret_cast<const char*>(bufs[i].data());
+        result.emplace_back(str, infos[i].size);
+      }
+    }
+    return result;
+  }
+
+  actor_system_config cfg;
+  actor_system sys;
+  ip_endpoint localhost;
+};
+
+WITH_FIXTURE(fixture) {
+
+SCENARIO("udp::with(...).bind(...) translates between flows and datagrams") {
+  GIVEN("a UDP server that echoes all datagrams") {
+    auto [server_fd, server_ep] = make_socket();
+    auto server = start_echo_server(server_fd);
+    WHEN("sending many datagrams to the server at once") {
+      auto [fd, ep] = make_socket();
+      auto guard = net::make_socket_guard(fd);
+      string_list msgs;
+      for (int i = 0; i < 100; ++i)
+        msgs.emplace_back("msg " + std::to_string(i));
+      send_all(fd, msgs, server_ep);
+      THEN("the server responds to each datagram") {
+        auto responses = receive(fd, msgs.size());
+        string_list expected;
+        for (auto& msg : msgs)
+          expected.emplace_back("ok " + msg);
+        std::sort(responses.begin(), responses.end());
+        std::sort(expected.begin(), expected.end());
+        check_eq(responses, expected);
+      }
+    }
+    server.dispose();
+  }
+}
+
+#ifdef CAF_LINUX
+
+SCENARIO("the UDP transport drops datagrams that exceed the maximum size") {
+  GIVEN("a UDP server with a maximum datagram size of 16 bytes") {
+    auto [server_fd, server_ep] = make_socket();
+    auto server = start_echo_server(server_fd, 16);
+    WHEN("sending datagrams that exceed the maximum size") {
+      auto [fd, ep] = make_socket();
+      auto guard = net::make_socket_guard(fd);
+      send_all(fd, string_list{"small", std::string(100, 'x'), "tiny"},
+               server_ep);
+      THEN("the server only receives the datagrams that fit") {
+        auto responses = receive(fd, 2);
+        std::sort(responses.begin(), responses.end());
+        check_eq(responses, string_list{"ok small", "ok tiny"});
+      }
+    }
+    server.dispose();
+  }
+}
+
+#endif // CAF_LINUX
+
+} // WITH_FIXTURE(fixture)
+
+} // namespace
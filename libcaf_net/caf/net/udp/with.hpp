@@ -0,0 +1,152 @@
+// This file is part of CAF, the C++ Actor Framework. See the file LICENSE in
+// the main distribution directory for license terms and copyright or visit
+// https://github.com/actor-framework/actor-framework/blob/master/LICENSE.
+
+#pragma once
+
+#include "caf/net/multiplexer.hpp"
+#include "caf/net/socket_guard.hpp"
+#include "caf/net/socket_manager.hpp"
+#include "caf/net/udp/datagram.hpp"
+#include "caf/net/udp/transport.hpp"
+#include "caf/net/udp_datagram_socket.hpp"
+
+#include "caf/async/spsc_buffer.hpp"
+#include "caf/callback.hpp"
+#include "caf/defaults.hpp"
+#include "caf/detail/udp_flow_bridge.hpp"
+#include "caf/disposable.hpp"
+#include "caf/error.hpp"
+#include "caf/expected.hpp"
+#include "caf/fwd.hpp"
+#include "caf/ip_endpoint.hpp"
+#include "caf/sec.hpp"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace caf::net::udp {
+
+/// Factory for the `with(...).bind(...).start(...)` DSL.
+class bind_factory {
+public:
+  /// A resource for consuming received datagrams.
+  using input_resource = async::consumer_resource<datagram>;
+
+  /// A resource for producing outgoing datagrams.
+  using output_resource = async::producer_resource<datagram>;
+
+  bind_factory(multiplexer* mpx, udp_datagram_socket fd)
+    : mpx_(mpx), fd_(fd) {
+    // nop
+  }
+
+  bind_factory(multiplexer* mpx, error err)
+    : mpx_(mpx), err_(std::move(err)) {
+    // nop
+  }
+
+  bind_factory(bind_factory&&) noexcept = default;
+
+  bind_factory& operator=(bind_factory&&) noexcept = default;
+
+  /// Sets the callback for errors.
+  template <class F>
+  bind_factory& do_on_error(F callback) {
+    static_assert(std::is_invocable_v<F, const error&>);
+    on_error_ = make_shared_type_erased_callback(std::move(callback));
+    return *this;
+  }
+
+  /// Sets the maximum size for incoming datagrams. The transport drops larger
+  /// datagrams.
+  bind_factory& max_datagram_size(size_t value) {
+    max_datagram_size_ = value;
+    return *this;
+  }
+
+  /// Sets how many datagrams the transport receives or sends with a single
+  /// system call.
+  bind_factory& batch_size(size_t value) {
+    batch_size_ = value;
+    return *this;
+  }
+
+  /// Starts reading and writing datagrams on the socket.
+  /// @param on_start A function that takes an `input_resource` for consuming
+  ///                 received datagrams and an `output_resource` for sending
+  ///                 datagrams.
+  template <class OnStart>
+  [[nodiscard]] expected<disposable> start(OnStart on_start) {
+    static_assert(
+      std::is_invocable_v<OnStart, input_resource, output_resource>);
+    if (err_) {
+      if (on_error_)
+        (*on_error_)(err_);
+      return expected<disposable>{std::move(err_)};
+    }
+    // s2a: socket-to-application (and a2s is the inverse).
+    auto [s2a_pull, s2a_push] = async::make_spsc_buffer_resource<datagram>();
+    auto [a2s_pull, a2s_push] = async::make_spsc_buffer_resource<datagram>();
+    auto bridge = detail::udp_flow_bridge::make(std::move(a2s_pull),
+                                                std::move(s2a_push));
+    auto bridge_ptr = bridge.get();
+    auto impl = transport::make(fd_.release(), std::move(bridge));
+    impl->max_datagram_size(max_datagram_size_);
+    impl->batch_size(batch_size_);
+    auto ptr = socket_manager::make(mpx_, std::move(impl));
+    bridge_ptr->self_ref(ptr->as_disposable());
+    mpx_->start(ptr);
+    on_start(std::move(s2a_pull), std::move(a2s_push));
+    return expected<disposable>{disposable{std::move(ptr)}};
+  }
+
+private:
+  multiplexer* mpx_;
+  socket_guard<udp_datagram_socket> fd_;
+  error err_;
+  size_t max_datagram_size_ = defaults::net::udp_max_datagram_size;
+  size_t batch_size_ = defaults::net::udp_batch_size;
+  shared_callback_ptr<void(const error&)> on_error_;
+};
+
+/// Entry point for the `with(...)` DSL.
+class with_t {
+public:
+  explicit with_t(multiplexer* mpx) : mpx_(mpx) {
+    // nop
+  }
+
+  /// Creates a `bind_factory` for a new UDP socket that binds to `port` and
+  /// `bind_address`.
+  /// @param port Port number to bind to. Pass 0 to bind to any unused port.
+  /// @param bind_address IP address or host name of the interface to bind
+  ///                     to. Binds to all interfaces if empty.
+  bind_factory bind(uint16_t port, const std::string& bind_address = "") {
+    auto fd = make_udp_datagram_socket(port, bind_address);
+    if (!fd)
+      return {mpx_, std::move(fd.error())};
+    return {mpx_, *fd};
+  }
+
+  /// Creates a `bind_factory` for an existing UDP socket. The factory takes
+  /// ownership of the socket.
+  bind_factory bind(udp_datagram_socket fd) {
+    return {mpx_, fd};
+  }
+
+private:
+  multiplexer* mpx_;
+};
+
+inline with_t with(actor_system& sys) {
+  return with_t{multiplexer::from(sys)};
+}
+
+inline with_t with(multiplexer* mpx) {
+  return with_t{mpx};
+}
+
+} // namespace caf::net::udp
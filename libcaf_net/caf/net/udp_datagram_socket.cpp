@@ -4,6 +4,7 @@
 
 #include "caf/net/udp_datagram_socket.hpp"
 
+#include "caf/net/ip.hpp"
 #include "caf/net/socket_guard.hpp"
 
 #include "caf/byte_buffer.hpp"
@@ -12,10 +13,16 @@
 #include "caf/detail/socket_sys_aliases.hpp"
 #include "caf/detail/socket_sys_includes.hpp"
 #include "caf/expected.hpp"
+#include "caf/ip_address.hpp"
 #include "caf/ip_endpoint.hpp"
+#include "caf/ipv4_address.hpp"
 #include "caf/log/net.hpp"
+#include "caf/sec.hpp"
 #include "caf/span.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace {
 
 #if defined(CAF_WINDOWS) || defined(CAF_MACOS) || defined(CAF_IOS)             \
@@ -53,6 +60,35 @@ expected<udp_datagram_socket> make_udp_datagram_socket(ip_endpoint ep,
   return sguard.release();
 }
 
+expected<udp_datagram_socket>
+make_udp_datagram_socket(uint16_t port, const std::string& addr,
+                         bool reuse_addr) {
+  auto lg = log::net::trace("port = {}, addr = {}", port, addr);
+  if (addr.empty()) {
+    // For empty strings, try IPv6::any and use IPv4::any as fallback.
+    auto v6_any = ip_address{{0}, {0}};
+    auto v4_any = ip_address{make_ipv4_address(0, 0, 0, 0)};
+    if (auto sock = make_udp_datagram_socket(ip_endpoint{v6_any, port},
+                                             reuse_addr))
+      return *sock;
+    return make_udp_datagram_socket(ip_endpoint{v4_any, port}, reuse_addr);
+  }
+  auto addrs = ip::local_addresses(addr);
+  if (addrs.empty())
+    return make_error(sec::cannot_open_port, "no local interface available",
+                      addr);
+  // Prefer ipv6 addresses.
+  std::stable_partition(std::begin(addrs), std::end(addrs),
+                        [](const ip_address& ip) { return !ip.embeds_v4(); });
+  for (auto& ip : addrs) {
+    if (auto sock = make_udp_datagram_socket(ip_endpoint{ip, port},
+                                             reuse_addr))
+      return *sock;
+  }
+  return make_error(sec::cannot_open_port, "udp socket creation failed",
+                    addr);
+}
+
 ptrdiff_t read(udp_datagram_socket x, byte_span buf, ip_endpoint* src) {
   sockaddr_storage addr = {};
   socklen_t len = sizeof(sockaddr_storage);
@@ -74,4 +110,96 @@ ptrdiff_t write(udp_datagram_socket x, const_byte_span buf, ip_endpoint ep) {
                   static_cast<socklen_t>(len));
 }
 
+#ifdef CAF_LINUX
+
+ptrdiff_t read(udp_datagram_socket x, span<byte_span> bufs,
+               span<udp_datagram_info> infos) {
+  CAF_ASSERT(infos.size() >= bufs.size());
+  auto n = std::min(bufs.size(), max_datagram_batch_size);
+  if (n == 0)
+    return 0;
+  mmsghdr msgs[max_datagram_batch_size];
+  iovec iovs[max_datagram_batch_size];
+  sockaddr_storage addrs[max_datagram_batch_size];
+  memset(msgs, 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    iovs[i].iov_base = bufs[i].data();
+    iovs[i].iov_len = bufs[i].size();
+    auto& hdr = msgs[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen = sizeof(sockaddr_storage);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  auto res = ::recvmmsg(x.id, msgs, static_cast<unsigned>(n), 0, nullptr);
+  for (int i = 0; i < res; ++i) {
+    auto& info = infos[static_cast<size_t>(i)];
+    info.size = msgs[i].msg_len;
+    info.truncated = (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    std::ignore = detail::convert(addrs[i], info.source);
+  }
+  return res;
+}
+
+ptrdiff_t write(udp_datagram_socket x, span<const const_byte_span> bufs,
+                span<const ip_endpoint> eps) {
+  CAF_ASSERT(eps.size() >= bufs.size());
+  auto n = std::min(bufs.size(), max_datagram_batch_size);
+  if (n == 0)
+    return 0;
+  mmsghdr msgs[max_datagram_batch_size];
+  iovec iovs[max_datagram_batch_size];
+  sockaddr_storage addrs[max_datagram_batch_size];
+  memset(msgs, 0, n * sizeof(mmsghdr));
+  for (size_t i = 0; i < n; ++i) {
+    // sendmmsg never writes to the buffers.
+    iovs[i].iov_base = const_cast<std::byte*>(bufs[i].data());
+    iovs[i].iov_len = bufs[i].size();
+    addrs[i] = sockaddr_storage{};
+    detail::convert(eps[i], addrs[i]);
+    auto& hdr = msgs[i].msg_hdr;
+    hdr.msg_name = &addrs[i];
+    hdr.msg_namelen = eps[i].address().embeds_v4() ? sizeof(sockaddr_in)
+                                                   : sizeof(sockaddr_in6);
+    hdr.msg_iov = &iovs[i];
+    hdr.msg_iovlen = 1;
+  }
+  return ::sendmmsg(x.id, msgs, static_cast<unsigned>(n), 0);
+}
+
+#else // CAF_LINUX
+
+ptrdiff_t read(udp_datagram_socket x, span<byte_span> bufs,
+               span<udp_datagram_info> infos) {
+  CAF_ASSERT(infos.size() >= bufs.size());
+  // Fall back to one system call per datagram and stop at the first error.
+  ptrdiff_t count = 0;
+  for (size_t i = 0; i < bufs.size(); ++i) {
+    auto& info = infos[i];
+    auto res = read(x, bufs[i], &info.source);
+    if (res < 0)
+      return count > 0 ? count : res;
+    info.size = std::min(static_cast<size_t>(res), bufs[i].size());
+    info.truncated = false;
+    ++count;
+  }
+  return count;
+}
+
+ptrdiff_t write(udp_datagram_socket x, span<const const_byte_span> bufs,
+                span<const ip_endpoint> eps) {
+  CAF_ASSERT(eps.size() >= bufs.size());
+  // Fall back to one system call per datagram and stop at the first error.
+  ptrdiff_t count = 0;
+  for (size_t i = 0; i < bufs.size(); ++i) {
+    auto res = write(x, bufs[i], eps[i]);
+    if (res < 0)
+      return count > 0 ? count : res;
+    ++count;
+  }
+  return count;
+}
+
+#endif // CAF_LINUX
+
 } // namespace caf::net
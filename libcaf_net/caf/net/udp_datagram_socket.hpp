@@ -10,7 +10,11 @@
 #include "caf/byte_span.hpp"
 #include "caf/detail/net_export.hpp"
 #include "caf/fwd.hpp"
+#include "caf/ip_endpoint.hpp"
+#include "caf/span.hpp"
 
+#include <cstdint>
+#include <string>
 #include <vector>
 
 namespace caf::net {
@@ -23,6 +27,24 @@ struct CAF_NET_EXPORT udp_datagram_socket : datagram_socket {
   using super::super;
 };
 
+/// Maximum number of datagrams that a single call to the batched `read` and
+/// `write` functions transfers.
+constexpr size_t max_datagram_batch_size = 64;
+
+/// Stores the size and the sender of a datagram received with the batched
+/// `read` function.
+struct udp_datagram_info {
+  /// The number of bytes written to the buffer of the datagram.
+  size_t size = 0;
+
+  /// The address of the sender.
+  ip_endpoint source;
+
+  /// Stores whether the datagram was larger than its buffer. Only detected on
+  /// platforms that support `recvmmsg`.
+  bool truncated = false;
+};
+
 /// Creates a `udp_datagram_socket` bound to given port.
 /// @param ep ip_endpoint that contains the port to bind to. Pass port '0' to
 ///           bind to any unused port - The endpoint will be updated with the
@@ -33,6 +55,18 @@ expected<udp_datagram_socket>
   CAF_NET_EXPORT make_udp_datagram_socket(ip_endpoint ep,
                                           bool reuse_addr = true);
 
+/// Creates a `udp_datagram_socket` bound to `port` on the interface for `addr`.
+/// @param port The port to bind to. Pass '0' to bind to any unused port.
+/// @param addr The address or host name of the interface to bind to. Binds to
+///             all interfaces if empty, preferring IPv6 over IPv4.
+/// @param reuse_addr Configures whether to set the `SO_REUSEADDR` option.
+/// @returns The bound socket or an error.
+/// @relates udp_datagram_socket
+expected<udp_datagram_socket>
+  CAF_NET_EXPORT make_udp_datagram_socket(uint16_t port,
+                                          const std::string& addr,
+                                          bool reuse_addr = true);
+
 /// Receives the next datagram on socket `x`.
 /// @param x The UDP socket for receiving datagrams.
 /// @param buf Writable output buffer.
@@ -55,4 +89,29 @@ ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x, byte_span buf,
 ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x, const_byte_span buf,
                                ip_endpoint ep);
 
+/// Receives up to `bufs.size()` datagrams on socket `x`, one per buffer. Uses a
+/// single system call on platforms that support `recvmmsg`.
+/// @param x The UDP socket for receiving datagrams.
+/// @param bufs Writable output buffers, one for each datagram.
+/// @param infos Receives the size and the sender of each datagram.
+/// @returns The number of received datagrams on success or -1 in case of an
+///          error.
+/// @pre `infos.size() >= bufs.size()`
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT read(udp_datagram_socket x, span<byte_span> bufs,
+                              span<udp_datagram_info> infos);
+
+/// Sends each buffer in `bufs` as a datagram to the endpoint at the same
+/// position in `eps`. Uses a single system call on platforms that support
+/// `sendmmsg`.
+/// @param x The UDP socket for sending datagrams.
+/// @param bufs The buffers to send.
+/// @param eps The endpoints to send the datagrams to.
+/// @returns The number of sent datagrams on success or -1 in case of an error.
+/// @pre `eps.size() >= bufs.size()`
+/// @relates udp_datagram_socket
+ptrdiff_t CAF_NET_EXPORT write(udp_datagram_socket x,
+                               span<const const_byte_span> bufs,
+                               span<const ip_endpoint> eps);
+
 } // namespace caf::net
@@ -9,6 +9,8 @@
 #include "caf/detail/rfc3629.hpp"
 #include "caf/log/net.hpp"
 
+#include <type_traits>
+
 namespace caf::net::web_socket {
 
 namespace {
@@ -342,6 +344,17 @@ void framing::ship_frame(std::vector<T>& buf) {
     detail::rfc6455::mask_data(mask_key, buf);
   }
   down_->begin_output();
+  if constexpr (std::is_same_v<T, std::byte>) {
+    // Large binary payloads go to the transport without copying them.
+    if (buf.size() >= octet_stream::lower_layer::min_enqueue_size) {
+      detail::rfc6455::assemble_header(detail::rfc6455::binary_frame, mask_key,
+                                       buf.size(), down_->output_buffer());
+      down_->enqueue_output(std::move(buf));
+      down_->end_output();
+      buf = std::vector<T>{};
+      return;
+    }
+  }
   detail::rfc6455::assemble_frame(mask_key, buf, down_->output_buffer());
   down_->end_output();
   buf.clear();
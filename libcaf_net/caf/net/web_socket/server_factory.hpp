@@ -245,20 +245,15 @@ private:
                                      OnStart& on_start, flow_impl_token) {
     using transport_t = typename Acceptor::transport_type;
     using factory_t = detail::ws_flow_conn_factory<transport_t, Trait, Ts...>;
-    using impl_t = detail::accept_handler<Acceptor>;
     using producer_t = async::blocking_producer<accept_event>;
     auto [pull, push] = async::make_spsc_buffer_resource<accept_event>();
     auto producer = std::make_shared<producer_t>(producer_t{push.try_open()});
-    auto factory = std::make_unique<factory_t>(on_request_, std::move(producer),
+    auto factory = std::make_shared<factory_t>(on_request_, std::move(producer),
                                                cfg.max_consecutive_reads);
-    auto impl = impl_t::make(std::move(acc), std::move(factory),
-                             cfg.max_connections);
-    auto impl_ptr = impl.get();
-    auto ptr = net::socket_manager::make(cfg.mpx, std::move(impl));
-    impl_ptr->self_ref(ptr->as_disposable());
-    cfg.mpx->start(ptr);
-    on_start(std::move(pull));
-    return expected<disposable>{disposable{std::move(ptr)}};
+    auto res = this->start_accept_handlers(std::move(acc), std::move(factory));
+    if (res)
+      on_start(std::move(pull));
+    return res;
   }
 
   template <class Acceptor, class MakeApp>
@@ -266,16 +261,9 @@ private:
                                      MakeApp& make_app, custom_impl_token) {
     using transport_t = typename Acceptor::transport_type;
     using factory_t = detail::ws_simple_conn_factory<transport_t, MakeApp>;
-    using impl_t = detail::accept_handler<Acceptor>;
-    auto factory = std::make_unique<factory_t>(std::move(make_app),
+    auto factory = std::make_shared<factory_t>(std::move(make_app),
                                                cfg.max_consecutive_reads);
-    auto impl = impl_t::make(std::move(acc), std::move(factory),
-                             cfg.max_connections);
-    auto impl_ptr = impl.get();
-    auto ptr = net::socket_manager::make(cfg.mpx, std::move(impl));
-    impl_ptr->self_ref(ptr->as_disposable());
-    cfg.mpx->start(ptr);
-    return expected<disposable>{disposable{std::move(ptr)}};
+    return this->start_accept_handlers(std::move(acc), std::move(factory));
   }
 
   template <class OnStart, class Token>
@@ -295,7 +283,8 @@ private:
   expected<disposable> do_start(config_type& cfg,
                                 dsl::server_config::lazy& data,
                                 OnStart& on_start, Token) {
-    return make_tcp_accept_socket(data.port, data.bind_address, data.reuse_addr)
+    return make_tcp_accept_socket(data.port, data.bind_address, data.reuse_addr,
+                                  data.reuse_port)
       .and_then(
         this->with_ssl_acceptor_or_socket([this, &cfg, &on_start](auto&& acc) {
           using acc_t = decltype(acc);
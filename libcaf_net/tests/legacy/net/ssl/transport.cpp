@@ -7,6 +7,7 @@
 #include "caf/net/ssl/transport.hpp"
 
 #include "caf/net/multiplexer.hpp"
+#include "caf/net/network_socket.hpp"
 #include "caf/net/socket_manager.hpp"
 #include "caf/net/ssl/context.hpp"
 #include "caf/net/stream_socket.hpp"
@@ -103,6 +104,109 @@ private:
   byte_buffer_ptr recv_buf_;
 };
 
+// Fills the output of the transport with interleaved slices of the output
+// buffer and enqueued buffers.
+class mock_bulk_sender : public net::octet_stream::upper_layer {
+public:
+  static constexpr size_t num_rounds = 8;
+
+  static constexpr size_t slice_size = 48 * 1024;
+
+  static constexpr size_t chunk_size = 1024;
+
+  static constexpr size_t total_size = num_rounds * (slice_size + chunk_size);
+
+  explicit mock_bulk_sender(std::shared_ptr<bool> done)
+    : done_(std::move(done)) {
+    // nop
+  }
+
+  ~mock_bulk_sender() {
+    *done_ = true;
+  }
+
+  // Returns the byte at position `pos` of the output.
+  static std::byte byte_at(size_t pos) {
+    return static_cast<std::byte>(pos % 251);
+  }
+
+  error start(net::octet_stream::lower_layer* down) override {
+    down->configure_read(receive_policy::exactly(4));
+    down->begin_output();
+    auto& out = down->output_buffer();
+    size_t pos = 0;
+    for (size_t round = 0; round < num_rounds; ++round) {
+      for (size_t i = 0; i < slice_size; ++i)
+        out.push_back(byte_at(pos++));
+      byte_buffer buf;
+      buf.reserve(chunk_size);
+      for (size_t i = 0; i < chunk_size; ++i)
+        buf.push_back(byte_at(pos++));
+      down->enqueue_output(std::move(buf));
+    }
+    down->end_output();
+    return none;
+  }
+
+  void prepare_send() override {
+    // nop
+  }
+
+  bool done_sending() override {
+    return true;
+  }
+
+  ptrdiff_t consume(byte_span data, byte_span) override {
+    // The client acknowledges receiving all bytes.
+    *done_ = true;
+    return static_cast<ptrdiff_t>(data.size());
+  }
+
+  void abort(const error& reason) override {
+    MESSAGE("mock_bulk_sender::abort called: " << reason);
+    *done_ = true;
+  }
+
+private:
+  std::shared_ptr<bool> done_;
+};
+
+// Reads all bytes from a mock_bulk_sender after giving the sender time to
+// fill up the socket buffer and acknowledges them by sending 4 bytes.
+void dummy_bulk_receiver(stream_socket fd, std::shared_ptr<bool> valid) {
+  multiplexer::block_sigpipe();
+  auto guard = detail::scope_guard{[fd]() noexcept { close(fd); }};
+  auto ctx = unbox(ssl::context::make_client(ssl::tls::any));
+  auto conn = unbox(ctx.new_connection(fd));
+  if (auto ret = conn.connect(); ret <= 0) {
+    std::cerr << "*** connect failed: " << conn.last_error_string(ret) << '\n';
+    return;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  byte_buffer buf;
+  buf.resize(mock_bulk_sender::total_size);
+  size_t offset = 0;
+  while (offset < buf.size()) {
+    auto ret = conn.read(make_span(buf).subspan(offset));
+    if (ret <= 0) {
+      std::cerr << "*** read failed: " << conn.last_error_string(ret) << '\n';
+      return;
+    }
+    offset += static_cast<size_t>(ret);
+  }
+  *valid = true;
+  for (size_t pos = 0; pos < buf.size(); ++pos)
+    if (buf[pos] != mock_bulk_sender::byte_at(pos))
+      *valid = false;
+  byte_buffer ack;
+  ack.resize(4);
+  if (auto ret = conn.write(ack); ret <= 0) {
+    std::cerr << "*** write failed: " << conn.last_error_string(ret) << '\n';
+    return;
+  }
+  conn.close();
+}
+
 // Simulates a remote SSL server.
 void dummy_tls_server(stream_socket fd, const char* cert_file,
                       const char* key_file) {
@@ -174,6 +278,55 @@ void dummy_tls_client(stream_socket fd) {
   conn.close();
 }
 
+// Accepts an SSL connection on `fd`, echoes 4 bytes and returns whether the
+// handshake resumed a previous session.
+bool echo_once(ssl::context& ctx, stream_socket fd) {
+  auto guard = detail::scope_guard{[fd]() noexcept { close(fd); }};
+  auto conn = unbox(ctx.new_connection(fd));
+  if (auto ret = conn.accept(); ret <= 0) {
+    std::cerr << "*** accept failed: " << conn.last_error_string(ret) << '\n';
+    return false;
+  }
+  byte_buffer buf;
+  buf.resize(4);
+  if (auto ret = conn.read(buf); ret <= 0) {
+    std::cerr << "*** read failed: " << conn.last_error_string(ret) << '\n';
+    return false;
+  }
+  if (auto ret = conn.write(buf); ret <= 0) {
+    std::cerr << "*** write failed: " << conn.last_error_string(ret) << '\n';
+    return false;
+  }
+  conn.close();
+  return conn.session_reused();
+}
+
+// Connects to an SSL server on `fd`, sends 4 bytes and waits for the echo.
+// Returns whether the handshake resumed a previous session.
+bool ping_once(ssl::context& ctx, stream_socket fd) {
+  auto guard = detail::scope_guard{[fd]() noexcept { close(fd); }};
+  auto conn = unbox(ctx.new_connection(fd));
+  conn.resume_session("localhost:443");
+  if (auto ret = conn.connect(); ret <= 0) {
+    std::cerr << "*** connect failed: " << conn.last_error_string(ret) << '\n';
+    return false;
+  }
+  byte_buffer buf;
+  buf.resize(4);
+  if (auto ret = conn.write(buf); ret <= 0) {
+    std::cerr << "*** write failed: " << conn.last_error_string(ret) << '\n';
+    return false;
+  }
+  // Reading also processes session tickets that the server sends after the
+  // handshake when using TLS 1.3.
+  if (auto ret = conn.read(buf); ret <= 0) {
+    std::cerr << "*** read failed: " << conn.last_error_string(ret) << '\n';
+    return false;
+  }
+  conn.close();
+  return conn.session_reused();
+}
+
 } // namespace
 
 BEGIN_FIXTURE_SCOPE(fixture)
@@ -263,4 +416,141 @@ SCENARIO("ssl::transport::make_server performs the server handshake") {
   }
 }
 
+SCENARIO("ssl::transport supports kernel TLS offload") {
+  GIVEN("a server context with kTLS enabled") {
+    auto [server_fd, client_fd] = no_sigpipe(unbox(make_stream_socket_pair()));
+    if (auto err = net::nonblocking(server_fd, true))
+      FAIL("net::nonblocking failed: " << err);
+    std::thread client{dummy_tls_client, client_fd};
+    WHEN("acting as the SSL server") {
+      THEN("CAF uses kTLS if available and falls back to OpenSSL otherwise") {
+        auto mpx = net::multiplexer::make(nullptr);
+        mpx->set_thread_id();
+        std::ignore = mpx->init();
+        auto ctx = unbox(ssl::context::make_server(ssl::tls::any));
+        ctx.enable_ktls(true);
+        REQUIRE(ctx.use_certificate_file(cert_1_pem_path, //
+                                         ssl::format::pem));
+        REQUIRE(ctx.use_private_key_file(key_1_pem_path, //
+                                         ssl::format::pem));
+        auto conn = unbox(ctx.new_connection(server_fd));
+        CHECK(!conn.ktls_send());
+        CHECK(!conn.ktls_recv());
+        auto done = std::make_shared<bool>(false);
+        auto buf = std::make_shared<byte_buffer>();
+        auto mock = mock_application::make(done, buf);
+        auto transport = ssl::transport::make_server(std::move(conn),
+                                                     std::move(mock));
+        auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+        mpx->start(mgr);
+        mpx->apply_updates();
+        while (!*done)
+          mpx->poll_once(true);
+        if (CHECK_EQ(buf->size(), 16u)) { // 4x 32-bit integers
+          caf::binary_deserializer src{nullptr, *buf};
+          for (int i = 0; i < 4; ++i) {
+            int32_t value = 0;
+            static_cast<void>(src.apply(value));
+            CHECK_EQ(value, 10);
+          }
+        }
+        while (mpx->poll_once(false)) {
+          // repeat
+        }
+      }
+    }
+    client.join();
+  }
+}
+
+SCENARIO("ssl::transport retries writes of enqueued buffers") {
+  GIVEN("a server with a small send buffer and a slow client") {
+    auto [server_fd, client_fd] = no_sigpipe(unbox(make_stream_socket_pair()));
+    if (auto err = net::nonblocking(server_fd, true))
+      FAIL("net::nonblocking failed: " << err);
+    if (auto err = send_buffer_size(server_fd, 8192))
+      FAIL("send_buffer_size failed: " << err);
+    auto valid = std::make_shared<bool>(false);
+    std::thread client{dummy_bulk_receiver, client_fd, valid};
+    WHEN("the server sends more data than fits into the socket buffer") {
+      THEN("the transport resumes interrupted writes with moved buffers") {
+        auto mpx = net::multiplexer::make(nullptr);
+        mpx->set_thread_id();
+        std::ignore = mpx->init();
+        auto ctx = unbox(ssl::context::make_server(ssl::tls::any));
+        REQUIRE(ctx.use_certificate_file(cert_1_pem_path, //
+                                         ssl::format::pem));
+        REQUIRE(ctx.use_private_key_file(key_1_pem_path, //
+                                         ssl::format::pem));
+        auto conn = unbox(ctx.new_connection(server_fd));
+        auto done = std::make_shared<bool>(false);
+        auto transport = ssl::transport::make_server(
+          std::move(conn), std::make_unique<mock_bulk_sender>(done));
+        auto mgr = net::socket_manager::make(mpx.get(), std::move(transport));
+        mpx->start(mgr);
+        mpx->apply_updates();
+        while (!*done)
+          mpx->poll_once(true);
+        while (mpx->poll_once(false)) {
+          // repeat
+        }
+      }
+    }
+    client.join();
+    CHECK(*valid);
+  }
+}
+
+SCENARIO("ssl::context allows clients to resume previous sessions") {
+  GIVEN("a server with a session cache and a client with session reuse") {
+    auto server_ctx = unbox(ssl::context::make_server(ssl::tls::any));
+    REQUIRE(server_ctx.use_certificate_file(cert_1_pem_path, //
+                                            ssl::format::pem));
+    REQUIRE(server_ctx.use_private_key_file(key_1_pem_path, //
+                                            ssl::format::pem));
+    REQUIRE(server_ctx.enable_session_cache(16, std::chrono::seconds{60}));
+    auto client_ctx = unbox(ssl::context::make_client(ssl::tls::any));
+    client_ctx.enable_session_reuse(16);
+    auto run = [&] {
+      auto [server_fd, client_fd] = no_sigpipe(
+        unbox(make_stream_socket_pair()));
+      auto server_resumed = false;
+      std::thread server{[&, fd = server_fd] {
+        multiplexer::block_sigpipe();
+        server_resumed = echo_once(server_ctx, fd);
+      }};
+      auto client_resumed = ping_once(client_ctx, client_fd);
+      server.join();
+      CHECK_EQ(server_resumed, client_resumed);
+      return client_resumed;
+    };
+    WHEN("the client connects for the first time") {
+      THEN("the client and the server perform a full handshake") {
+        CHECK(!run());
+      }
+    }
+    AND_WHEN("the client connects again") {
+      THEN("the client and the server resume the previous session") {
+        CHECK(run());
+        CHECK(run());
+      }
+    }
+    AND_WHEN("the server stops issuing session tickets") {
+      THEN("the server resumes sessions from its session cache") {
+        server_ctx.enable_session_tickets(false);
+        // The first connection may fail to resume the ticket-based session.
+        static_cast<void>(run());
+        CHECK(run());
+      }
+    }
+    AND_WHEN("the server also disables its session cache") {
+      THEN("the client and the server perform full handshakes again") {
+        server_ctx.disable_session_cache();
+        CHECK(!run());
+        CHECK(!run());
+      }
+    }
+  }
+}
+
 END_FIXTURE_SCOPE()
@@ -85,4 +85,33 @@ CAF_TEST(read and write) {
   CHECK_EQ(received, hello_test);
 }
 
+CAF_TEST(batched read and write) {
+  if (auto err = nonblocking(socket_cast<net::socket>(receive_socket), true))
+    CAF_FAIL("setting socket to nonblocking failed: " << err);
+  std::vector<std::string> inputs{"first", "second", "third"};
+  std::vector<const_byte_span> out_bufs;
+  for (auto& input : inputs)
+    out_bufs.emplace_back(as_bytes(make_span(input)));
+  std::vector<ip_endpoint> eps(out_bufs.size(), ep);
+  auto write_res = write(send_socket, make_span(out_bufs), make_span(eps));
+  CHECK_EQ(write_res, 3);
+  byte_buffer storage(3 * 64);
+  std::vector<byte_span> in_bufs;
+  for (size_t i = 0; i < 3; ++i)
+    in_bufs.emplace_back(storage.data() + i * 64, 64);
+  std::vector<udp_datagram_info> infos(3);
+  std::vector<std::string> received;
+  for (int attempt = 0; attempt < 100 && received.size() < 3; ++attempt) {
+    auto bufs = make_span(in_bufs).subspan(received.size());
+    auto read_res = read(receive_socket, bufs, make_span(infos));
+    for (ptrdiff_t i = 0; i < read_res; ++i) {
+      auto index = static_cast<size_t>(i);
+      auto str = reinterpret_cast<const char*>(bufs[index].data());
+      received.emplace_back(str, infos[index].size);
+      CHECK_EQ(infos[index].source.port(), unbox(local_port(send_socket)));
+    }
+  }
+  CHECK_EQ(received, inputs);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()